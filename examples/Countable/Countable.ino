@@ -0,0 +1,60 @@
+/**
+ * @file Countable.ino Example of counting button bounces, presses, holds and
+ * clicks for diagnostics. Every 10 seconds the counts for the buttons
+ * connected between pins 2 & 3 and ground are output to the Serial port.
+ * Clicking either button toggles the built-in LED.
+ * 
+ * Counting is enabled by choosing the PinCounters class for the pin. Without
+ * it (the default NoCounters class), counting compiles to nothing.
+ * 
+ * @copyright Copyright (c) 2022 John Scott
+ */
+#include <AbleButtons.h>
+
+// Identify which buttons you are using...
+using Button = able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<able::PinCounters>>; ///< Counting double-clicker pull-up button.
+using ButtonList = able::ButtonList<Button>; ///< ButtonList for the same.
+
+#define BUTTON_A_PIN 2 ///< Connect button A between this pin and ground.
+#define BUTTON_B_PIN 3 ///< Connect button B between this pin and ground.
+
+Button btnA(BUTTON_A_PIN); ///< Primary button.
+Button btnB(BUTTON_B_PIN); ///< Secondary button.
+
+/// Array of buttons for ButtonList.
+Button *btns[] = {
+  &btnA,
+  &btnB
+};
+ButtonList btnList(btns); ///< List of button to control together.
+
+bool led = false; ///< On/off state of the LED.
+
+/**
+ * Setup the Countable example. Called once to initialise everything.
+ */
+void setup() {
+  Serial.begin(115200);
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  btnList.begin();
+}
+
+/**
+ * Control the Countable example. Called repeatedly in a loop.
+ */
+void loop() {
+  static unsigned long ms = millis(); ///< Timer to periodically print counts.
+
+  btnList.handle();
+
+  if(btnList.resetClicked()) {
+    led = !led;
+    digitalWrite(LED_BUILTIN, led);
+  }
+
+  if(millis() - ms >= 10000) {
+    btnList.printCounts(); // Output counts of each button and the totals.
+    ms = millis();
+  }
+}
@@ -0,0 +1,149 @@
+/**
+ * @file Measurable.ino Example of measuring the latency from a button edge to
+ * each callback event on the device, using micros(). Instead of a button,
+ * connect pin 3 to pin 2 with a wire. Pin 3 then presses and releases the
+ * "button" on pin 2 with taps and double-clicks, recording when it changed.
+ * The callback records how long after the change each event was reported.
+ * After every 32 gestures, the median (p50), 99th percentile and maximum
+ * latency of each event are printed to the Serial port in microseconds.
+ *
+ * Latency depends on the debounce algorithm of the pin, the time between
+ * calls of handle() and, for single-clicks, the click time. Change the Button
+ * alias below to compare them (e.g. AblePullupEagerCallbackDoubleClickerButton)
+ * or add a delay() to loop() to see the effect of a slow loop. The host test
+ * extras/host/tests/Latency.cpp measures the same with bouncing contacts.
+ *
+ * @copyright Copyright (c) 2022 John Scott
+ */
+#include <AbleButtons.h>
+
+// Identify which buttons you are using...
+using Button = AblePullupCallbackDoubleClickerButton; ///< Button to measure.
+using E = able::CallbackEvents; ///< Callback event names.
+
+#define BUTTON_PIN 2 ///< The pin of the measured button.
+#define DRIVE_PIN 3 ///< Connect this pin to BUTTON_PIN with a wire.
+#define SAMPLES 32 ///< Latencies recorded for each event.
+
+/**
+ * Latencies of an event, in microseconds.
+ */
+struct Latencies {
+  const char *name; ///< Name of the event.
+  unsigned long samples[SAMPLES]; ///< Recorded latencies.
+  uint8_t count; ///< Number of recorded latencies.
+};
+
+/// Latencies of the measured events.
+Latencies latencies[] = {
+  {"PRESSED", {0}, 0},
+  {"RELEASED", {0}, 0},
+  {"SINGLE_CLICKED", {0}, 0},
+  {"DOUBLE_CLICKED", {0}, 0}
+};
+
+unsigned long pressMicros = 0; ///< When DRIVE_PIN last pressed the button.
+unsigned long releaseMicros = 0; ///< When DRIVE_PIN last released the button.
+
+/**
+ * Callback function for button events, recording the latency of each event
+ * from the change causing it.
+ *
+ * @param event The event that has occured.
+ * @param id The identifier of the button generating the callback (unused).
+ */
+void onEvent(Button::CALLBACK_EVENT event, uint8_t /* id */) {
+  unsigned long now = micros();
+  Latencies *l = 0;
+
+  switch(event) {
+    case E::PRESSED_EVENT: l = &latencies[0]; now -= pressMicros; break;
+    case E::RELEASED_EVENT: l = &latencies[1]; now -= releaseMicros; break;
+    case E::SINGLE_CLICKED_EVENT: l = &latencies[2]; now -= releaseMicros; break;
+    case E::DOUBLE_CLICKED_EVENT: l = &latencies[3]; now -= releaseMicros; break;
+    default: return;
+  }
+  if(l->count < SAMPLES) l->samples[l->count++] = now;
+}
+
+Button btn(BUTTON_PIN, onEvent); ///< The measured button.
+
+/**
+ * Handle the button for a number of milliseconds, as a busy loop() would.
+ *
+ * @param ms The number of milliseconds.
+ */
+void wait(unsigned long ms) {
+  unsigned long start = millis();
+  while(millis() - start < ms) btn.handle();
+}
+
+/**
+ * Drive the button pressed or released, recording when.
+ *
+ * @param pressed True to press the button, false to release it.
+ */
+void drive(bool pressed) {
+  digitalWrite(DRIVE_PIN, pressed ? LOW : HIGH);
+  (pressed ? pressMicros : releaseMicros) = micros();
+}
+
+/**
+ * Print the median, 99th percentile and maximum of each event's latencies,
+ * then clear them.
+ */
+void report() {
+  for(Latencies &l : latencies) {
+    // Insertion sort is small and fast enough for a few samples.
+    for(uint8_t i = 1; i < l.count; ++i) {
+      unsigned long v = l.samples[i];
+      uint8_t j = i;
+      for(; j > 0 && l.samples[j - 1] > v; --j) l.samples[j] = l.samples[j - 1];
+      l.samples[j] = v;
+    }
+    Serial.print(l.name);
+    Serial.print(F(": count="));
+    Serial.print(l.count);
+    if(l.count) {
+      Serial.print(F(" p50="));
+      Serial.print(l.samples[(l.count - 1) * 50 / 100]);
+      Serial.print(F("us p99="));
+      Serial.print(l.samples[(l.count - 1) * 99 / 100]);
+      Serial.print(F("us max="));
+      Serial.print(l.samples[l.count - 1]);
+      Serial.print(F("us"));
+    }
+    Serial.println();
+    l.count = 0;
+  }
+}
+
+/**
+ * Setup the Measurable example. Called once to initialise everything.
+ */
+void setup() {
+  Serial.begin(115200);
+  pinMode(DRIVE_PIN, OUTPUT);
+  digitalWrite(DRIVE_PIN, HIGH);
+  btn.begin();
+  wait(100);
+}
+
+/**
+ * Control the Measurable example. Called repeatedly in a loop.
+ */
+void loop() {
+  for(uint8_t g = 0; g < 32; ++g) {
+    if(g % 2) { // Double-click.
+      drive(true); wait(100 + random(50));
+      drive(false); wait(100 + random(50));
+      drive(true); wait(100 + random(50));
+      drive(false);
+    } else { // Tap.
+      drive(true); wait(100 + random(100));
+      drive(false);
+    }
+    wait(800 + random(500));
+  }
+  report();
+}
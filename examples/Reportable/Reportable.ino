@@ -0,0 +1,70 @@
+/**
+ * @file Reportable.ino Example of streaming button events to a PC as binary
+ * telemetry. Each event of the buttons connected between pins 2 & 3 and
+ * ground is sent to the Serial port as an 8-byte frame, without formatting
+ * text or waiting for the port. Double-clicking either button toggles the
+ * built-in LED.
+ * 
+ * Telemetry is enabled by choosing the TelemetryCallback class for the
+ * callback button. Events are dropped (and counted) rather than delay loop()
+ * if the Serial port cannot keep up. The Serial port carries only the
+ * telemetry, so capture it to a file (e.g. with
+ * `stty -F /dev/ttyUSB0 115200 raw; cat /dev/ttyUSB0 > buttons.ablm`) and
+ * decode it with the Decode tool in extras/host:
+ * 
+ *     Decode -s buttons.ablm
+ * 
+ * @copyright Copyright (c) 2022 John Scott
+ */
+#include <AbleButtons.h>
+
+// Identify which buttons you are using...
+using Button = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<>>, able::TelemetryCallback<>>>; ///< Double-clicker pull-up button sending telemetry.
+using ButtonList = able::ButtonList<Button>; ///< ButtonList for the same.
+
+#define BUTTON_A_PIN 2 ///< Connect button A between this pin and ground.
+#define BUTTON_B_PIN 3 ///< Connect button B between this pin and ground.
+
+bool led = false; ///< On/off state of the LED.
+
+/**
+ * Callback function for button events. The event has already been sent as
+ * telemetry, so only the LED is controlled here.
+ * 
+ * @param event The event that has occured.
+ * @param id The identifier of the button generating the callback (unused).
+ */
+void onEvent(Button::CALLBACK_EVENT event, uint8_t /* id */) {
+  if(event == Button::DOUBLE_CLICKED_EVENT) {
+    led = !led;
+    digitalWrite(LED_BUILTIN, led);
+  }
+}
+
+Button btnA(BUTTON_A_PIN, onEvent); ///< Primary button.
+Button btnB(BUTTON_B_PIN, onEvent); ///< Secondary button.
+
+/// Array of buttons for ButtonList.
+Button *btns[] = {
+  &btnA,
+  &btnB
+};
+ButtonList btnList(btns); ///< List of button to control together.
+
+/**
+ * Setup the Reportable example. Called once to initialise everything.
+ */
+void setup() {
+  Serial.begin(115200);
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  able::Telemetry::begin(Serial); // Send telemetry from the begin events.
+  btnList.begin();
+}
+
+/**
+ * Control the Reportable example. Called repeatedly in a loop.
+ */
+void loop() {
+  btnList.handle();
+}
@@ -0,0 +1,66 @@
+/**
+ * @file Rotatable.ino Example of reading a rotary encoder with a push switch.
+ * The encoder's A and B pins are connected to pins 2 & 3, and its switch to
+ * pin 4 (all with the common pin to ground). Turning the encoder changes a
+ * level from 0 to 255, faster when turned quickly, and clicking the switch
+ * resets it. The level sets the brightness of an LED on pin 9.
+ * 
+ * The A and B pins are read in an interrupt service routine (ISR), so no
+ * steps are missed however slowly loop() runs. Pins 2 & 3 support interrupts
+ * on an Arduino Uno. To poll the encoder instead, call encoder.begin() in
+ * setup().
+ * 
+ * @copyright Copyright (c) 2022 John Scott
+ */
+#include <AbleButtons.h>
+
+// Identify which encoder you are using...
+using Encoder = AblePullupEncoder; ///< Encoder with a clicker switch, using pull-up resistors.
+
+#define ENCODER_A_PIN 2 ///< Connect the A (CLK) output of the encoder to this pin.
+#define ENCODER_B_PIN 3 ///< Connect the B (DT) output of the encoder to this pin.
+#define ENCODER_SW_PIN 4 ///< Connect the switch (SW) of the encoder to this pin.
+#define LED_PIN 9 ///< Connect an LED (with a resistor) between this PWM pin and ground.
+
+Encoder encoder(ENCODER_A_PIN, ENCODER_B_PIN, ENCODER_SW_PIN); ///< The encoder.
+int level = 0; ///< The level set by the encoder.
+
+/**
+ * Interrupt service routine reading the encoder when the A or B pin changes.
+ */
+void onEncoder() {
+  encoder.update();
+}
+
+/**
+ * Setup the Rotatable example. Called once to initialise everything.
+ */
+void setup() {
+  Serial.begin(115200);
+  pinMode(LED_PIN, OUTPUT);
+
+  Encoder::setAcceleration(20, 10); // Up to 10 steps per detent above 20 detents/s.
+  encoder.beginInterrupts(onEncoder);
+}
+
+/**
+ * Control the Rotatable example. Called repeatedly in a loop.
+ */
+void loop() {
+  encoder.handle(); // Handle the switch.
+
+  int steps = encoder.readSteps();
+  bool changed = steps != 0;
+  level = constrain(level + steps, 0, 255);
+  if(encoder.resetClicked()) {
+    level = 0;
+    changed = true;
+  }
+  if(changed) {
+    analogWrite(LED_PIN, level);
+    Serial.print(F("level="));
+    Serial.print(level);
+    Serial.print(F(" velocity="));
+    Serial.println(encoder.velocity());
+  }
+}
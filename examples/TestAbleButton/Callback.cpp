@@ -11,6 +11,17 @@
 #include "Utils.h"
 
 #if TESTABLE_CALLBACK
+# if TESTABLE_TIMED
+  /**
+   * Callback function for button events.
+   * 
+   * @param event The event that has occured.
+   * @param id The identifier of the button generating the callback.
+   * @param timing The timing of the event.
+   */
+  void onEvent(Button::CALLBACK_EVENT event, uint8_t id, const able::EventTiming &timing) {
+    checkEventTiming(event, timing);
+# else
   /**
    * Callback function for button events.
    * 
@@ -18,6 +29,7 @@
    * @param id The identifier of the button generating the callback.
    */
   void onEvent(Button::CALLBACK_EVENT event, uint8_t id) {  
+# endif
     assert(id > 0);
     Button *btn = btnList.button(id); assert(btn == btns[id - 1]);
     ButtonState &state(btnState[id - 1]);
@@ -9,6 +9,8 @@
 //
 // Forward declarations of callback functions.
 //
-#if TESTABLE_CALLBACK
+#if TESTABLE_CALLBACK && TESTABLE_TIMED
+void onEvent(Button::CALLBACK_EVENT, uint8_t, const able::EventTiming &);
+#elif TESTABLE_CALLBACK
 void onEvent(Button::CALLBACK_EVENT, uint8_t);
 #endif
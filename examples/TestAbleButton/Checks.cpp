@@ -193,6 +193,37 @@ void checkButtonJustDoubleClicked(Button *btn) {
 # endif
 }
 
+#if TESTABLE_CALLBACK && TESTABLE_TIMED
+/**
+ * Check the timing passed to a timed callback function.
+ * 
+ * @param event The event the timing is for.
+ * @param timing The timing of the event.
+ */
+void checkEventTiming(Button::CALLBACK_EVENT event, const able::EventTiming &timing) {
+  // Given an event, the timing...
+  assert(timing.millis <= millis()); // ...cannot be in the future.
+
+  if(event == Button::PRESSED_EVENT || event == Button::RELEASED_EVENT) {
+    assert(timing.duration >= Button::debounceTime()); // ...lasts at least the debounce time.
+  } else if(event == Button::HELD_EVENT) {
+    assert(timing.duration >= Button::heldTime()); // ...lasts at least the held time.
+  } else if(event == Button::IDLE_EVENT) {
+    assert(timing.duration >= Button::idleTime()); // ...lasts at least the idle time.
+  }
+
+# if TESTABLE_CLASS >= TESTABLE_DOUBLECLICKER
+    if(event == Button::DOUBLE_CLICKED_EVENT) {
+      assert(timing.interval < Button::clickTime()); // ...clicks within the click time.
+    }
+# endif
+
+  if(event != Button::SINGLE_CLICKED_EVENT && event != Button::DOUBLE_CLICKED_EVENT) {
+    assert(timing.interval == 0); // ...only has an interval for clicks.
+  }
+}
+#endif
+
 /**
  * Check integrity of Button invariants (always hold true).
  * 
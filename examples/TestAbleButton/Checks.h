@@ -53,6 +53,9 @@ void checkButtonJustClicked(Button *btn);
 void checkButtonJustSingleClicked(Button *btn);
 void checkButtonJustDoubleClicked(Button *btn);
 void checkButtonIntegrity(Button *btn, ButtonState &state);
+#if TESTABLE_CALLBACK && TESTABLE_TIMED
+void checkEventTiming(Button::CALLBACK_EVENT event, const able::EventTiming &timing);
+#endif
 
 //
 // Display any changes to button status...
@@ -22,6 +22,8 @@
 #define TESTABLE_CIRCUIT 1
 /// 0 = No Callback; 1 = Callback.
 #define TESTABLE_CALLBACK 1
+/// 0 = Untimed callback; 1 = Timed callback (when TESTABLE_CALLBACK is 1).
+#define TESTABLE_TIMED 0
 /// 0 = DirectButton; 1 = Button; 2 = ClickerButton; 3 = DoubleClickerButton
 #define TESTABLE_CLASS 3
 
@@ -49,7 +51,21 @@
 // Configure which Button and ButtonList...
 //
 #if TESTABLE_CIRCUIT == TESTABLE_PULLUP
-# if TESTABLE_CALLBACK
+# if TESTABLE_CALLBACK && TESTABLE_TIMED
+#   if TESTABLE_CLASS == TESTABLE_BUTTON
+#     define TESTABLE_USING_BUTTON AblePullupTimedCallbackButton
+#     define TESTABLE_USING_BUTTONLIST AblePullupTimedCallbackButtonList
+#   elif TESTABLE_CLASS == TESTABLE_CLICKER
+#     define TESTABLE_USING_BUTTON AblePullupTimedCallbackClickerButton
+#     define TESTABLE_USING_BUTTONLIST AblePullupTimedCallbackClickerButtonList
+#   elif TESTABLE_CLASS == TESTABLE_DOUBLECLICKER
+#     define TESTABLE_USING_BUTTON AblePullupTimedCallbackDoubleClickerButton
+#     define TESTABLE_USING_BUTTONLIST AblePullupTimedCallbackDoubleClickerButtonList
+#   else
+#     define TESTABLE_USING_BUTTON Unsupported
+#     define TESTABLE_USING_BUTTONLIST Unsupported
+#   endif /* TESTABLE_CLASS */
+# elif TESTABLE_CALLBACK
 #   if TESTABLE_CLASS == TESTABLE_BUTTON
 #     define TESTABLE_USING_BUTTON AblePullupCallbackButton
 #     define TESTABLE_USING_BUTTONLIST AblePullupCallbackButtonList
@@ -84,7 +100,21 @@
 #   endif /* TESTABLE_CLASS */
 # endif /* TESTABLE_CALLBACK */
 #elif TESTABLE_CIRCUIT == TESTABLE_PULLDOWN
-# if TESTABLE_CALLBACK
+# if TESTABLE_CALLBACK && TESTABLE_TIMED
+#   if TESTABLE_CLASS == TESTABLE_BUTTON
+#     define TESTABLE_USING_BUTTON AblePulldownTimedCallbackButton
+#     define TESTABLE_USING_BUTTONLIST AblePulldownTimedCallbackButtonList
+#   elif TESTABLE_CLASS == TESTABLE_CLICKER
+#     define TESTABLE_USING_BUTTON AblePulldownTimedCallbackClickerButton
+#     define TESTABLE_USING_BUTTONLIST AblePulldownTimedCallbackClickerButtonList
+#   elif TESTABLE_CLASS == TESTABLE_DOUBLECLICKER
+#     define TESTABLE_USING_BUTTON AblePulldownTimedCallbackDoubleClickerButton
+#     define TESTABLE_USING_BUTTONLIST AblePulldownTimedCallbackDoubleClickerButtonList
+#   else
+#     define TESTABLE_USING_BUTTON Unsupported
+#     define TESTABLE_USING_BUTTONLIST Unsupported
+#   endif /* TESTABLE_CLASS */
+# elif TESTABLE_CALLBACK
 #   if TESTABLE_CLASS == TESTABLE_BUTTON
 #     define TESTABLE_USING_BUTTON AblePulldownCallbackButton
 #     define TESTABLE_USING_BUTTONLIST AblePulldownCallbackButtonList
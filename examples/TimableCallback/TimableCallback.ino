@@ -0,0 +1,63 @@
+/**
+ * @file TimableCallback.ino Example of using event timings passed to callback
+ * functions. Each time the button connected between pin 2 and ground is
+ * released, how long it was pressed is output to the Serial port. Clicks also
+ * output the interval since the previous click. Long presses (over half a
+ * second) light the built-in LED.
+ * 
+ * Timings come from the debounced button edges, so they are not affected by
+ * how long the loop() takes to run.
+ * 
+ * @copyright Copyright (c) 2022 John Scott
+ */
+#include <AbleButtons.h>
+
+// Identify which buttons you are using...
+using Button = AblePullupTimedCallbackDoubleClickerButton; ///< Using timed callback pull-up button.
+using ButtonList = AblePullupTimedCallbackDoubleClickerButtonList; ///< Using timed callback pull-up button list.
+
+// Forward declaration of callback function.
+void timedCallback(Button::CALLBACK_EVENT, uint8_t, const able::EventTiming &);
+
+#define BUTTON_PIN 2 ///< Connect button between this pin and ground.
+Button btn(BUTTON_PIN, timedCallback); ///< The button to check.
+
+/**
+ * Setup the TimableCallback example. Called once to initialise everything.
+ */
+void setup() {
+  Serial.begin(115200);
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  btn.begin();
+}
+
+/**
+ * Control the TimableCallback example. Called repeatedly in a loop.
+ */
+void loop() {
+  btn.handle();
+}
+
+/**
+ * Callback function for button events.
+ * 
+ * @param event The event that has occured.
+ * @param id The identifier of the button generating the callback (ignored in this example).
+ * @param timing The timing of the event.
+ */
+void timedCallback(Button::CALLBACK_EVENT event, uint8_t id, const able::EventTiming &timing) {
+  (void)id; // id is unused.
+
+  if(event == Button::RELEASED_EVENT) {
+    Serial.print(F("Pressed for "));
+    Serial.print(timing.duration);
+    Serial.print(F("ms at "));
+    Serial.println(timing.millis);
+    digitalWrite(LED_BUILTIN, timing.duration > 500);
+  } else if(event == Button::SINGLE_CLICKED_EVENT || event == Button::DOUBLE_CLICKED_EVENT) {
+    Serial.print(event == Button::DOUBLE_CLICKED_EVENT ? F("Double-click ") : F("Click "));
+    Serial.print(timing.interval);
+    Serial.println(F("ms after the previous click"));
+  }
+}
@@ -0,0 +1,58 @@
+/**
+ * @file Traceable.ino Example of recording a trace of buttons for replaying on
+ * a PC. Each raw change of the buttons connected between pins 2 & 3 and
+ * ground is streamed to the Serial port as a binary trace. Double-clicking
+ * either button toggles the built-in LED.
+ * 
+ * Recording is enabled by choosing the TraceRecorder class for the pin. The
+ * Serial port carries only the trace, so capture it to a file (e.g. with
+ * `stty -F /dev/ttyUSB0 115200 raw; cat /dev/ttyUSB0 > buttons.ablt`) and
+ * replay it with the Replay tool in extras/host:
+ * 
+ *     Replay AblePullupDoubleClickerButton buttons.ablt
+ * 
+ * @copyright Copyright (c) 2022 John Scott
+ */
+#include <AbleButtons.h>
+
+// Identify which buttons you are using...
+using Button = able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<able::TraceRecorder<>>>; ///< Recording double-clicker pull-up button.
+using ButtonList = able::ButtonList<Button>; ///< ButtonList for the same.
+
+#define BUTTON_A_PIN 2 ///< Connect button A between this pin and ground.
+#define BUTTON_B_PIN 3 ///< Connect button B between this pin and ground.
+
+Button btnA(BUTTON_A_PIN); ///< Primary button.
+Button btnB(BUTTON_B_PIN); ///< Secondary button.
+
+/// Array of buttons for ButtonList.
+Button *btns[] = {
+  &btnA,
+  &btnB
+};
+ButtonList btnList(btns); ///< List of button to control together.
+
+bool led = false; ///< On/off state of the LED.
+
+/**
+ * Setup the Traceable example. Called once to initialise everything.
+ */
+void setup() {
+  Serial.begin(115200);
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  btnList.begin();
+  able::Trace::begin(Serial); // Start the trace with its header.
+}
+
+/**
+ * Control the Traceable example. Called repeatedly in a loop.
+ */
+void loop() {
+  btnList.handle();
+
+  if(btnList.resetDoubleClicked()) {
+    led = !led;
+    digitalWrite(LED_BUILTIN, led);
+  }
+}
@@ -0,0 +1,63 @@
+/**
+ * @file Tunable.ino Example of tuning the debounce time of each button from
+ * the contact bounce measured. The buttons connected between pins 2 & 3 and
+ * ground start with the default 50ms debounce time. After 20 presses and
+ * releases (40 bounce bursts), each button's debounce time is set just above
+ * the 99th percentile of the bursts measured, reducing the delay before a
+ * press is seen. The histograms and debounce times are output to the Serial
+ * port every 10 seconds. Clicking either button toggles the built-in LED.
+ * 
+ * @copyright Copyright (c) 2022 John Scott
+ */
+#include <AbleButtons.h>
+
+// Identify which buttons you are using...
+using Button = able::Button<able::PullupResistorCircuit, able::ClickerPin<able::BounceHistogram<>>>; ///< Bounce measuring clicker pull-up button.
+using ButtonList = able::ButtonList<Button>; ///< ButtonList for the same.
+
+#define BUTTON_A_PIN 2 ///< Connect button A between this pin and ground.
+#define BUTTON_B_PIN 3 ///< Connect button B between this pin and ground.
+
+Button btnA(BUTTON_A_PIN); ///< Primary button.
+Button btnB(BUTTON_B_PIN); ///< Secondary button.
+
+/// Array of buttons for ButtonList.
+Button *btns[] = {
+  &btnA,
+  &btnB
+};
+ButtonList btnList(btns); ///< List of button to control together.
+
+bool led = false; ///< On/off state of the LED.
+
+/**
+ * Setup the Tunable example. Called once to initialise everything.
+ */
+void setup() {
+  Serial.begin(115200);
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  btnA.setAutoTune(99, 40); // Tune after 40 bursts (20 presses and releases).
+  btnB.setAutoTune(99, 40);
+
+  btnList.begin();
+}
+
+/**
+ * Control the Tunable example. Called repeatedly in a loop.
+ */
+void loop() {
+  static unsigned long ms = millis(); ///< Timer to periodically print histograms.
+
+  btnList.handle();
+
+  if(btnList.resetClicked()) {
+    led = !led;
+    digitalWrite(LED_BUILTIN, led);
+  }
+
+  if(millis() - ms >= 10000) {
+    btnList.printHistograms(); // Output histogram and debounce time of each button.
+    ms = millis();
+  }
+}
@@ -0,0 +1,149 @@
+# Measure the flash and RAM footprint of every button alias in AbleButtons.h.
+# A minimal sketch is built for each alias with a list of 1, 8 and 32 buttons,
+# plus an empty sketch as the baseline. The table reports the footprint of one
+# button over the empty sketch, the cost of its features over the basic button
+# of the same circuit, and the cost of each extra button. The script fails if
+# a footprint exceeds its budget.
+#
+# Usage: footprint.sh [-b budgets] [-u] [-j jobs] [alias-pattern]
+#
+#   -b budgets  Budget file (default budgets-<target>.txt, if it exists).
+#   -u          Update the budget file from this run, with some headroom.
+#   -j jobs     Sketches built at once (default the number of CPUs).
+#
+# Sketches are built with arduino-cli for the board $FQBN (e.g.
+# arduino:avr:nano) and sized with $SIZE (default avr-size). Without $FQBN,
+# they are built for the host with $CXX (default g++) against the host
+# stand-in for the Arduino core, which tracks changes but not AVR sizes.
+cd "$(dirname "$0")"
+self="$(pwd)/$(basename "$0")"
+
+# Build and size one sketch directory (run in parallel by the script below).
+if [ "$1" = "--compile" ]; then
+  dir="${2%/}"
+  name="$(basename "$dir")"
+  if [ -n "$FQBN" ]; then
+    arduino-cli compile -b "$FQBN" --library ../.. --output-dir "$dir" "$dir" > "$dir/log.txt" 2>&1 &&
+    ${SIZE:-avr-size} "$dir/$name.ino.elf" | awk 'NR == 2 { print $1, $2, $3 }' > "$dir/size.txt"
+  else
+    echo 'void setup(); void loop(); int main() { setup(); loop(); return 0; }' > "$dir/main.cpp"
+    ${CXX:-g++} -std=gnu++11 -Os -ffunction-sections -fdata-sections -Wl,--gc-sections -I../host -I../../src \
+      -x c++ "$dir/$name.ino" -x none "$dir/main.cpp" ../host/Arduino.cpp ../../src/*.cpp -o "$dir/$name.elf" > "$dir/log.txt" 2>&1 &&
+    ${SIZE:-size} "$dir/$name.elf" | awk 'NR == 2 { print $1, $2, $3 }' > "$dir/size.txt"
+  fi
+  [ -s "$dir/size.txt" ] || { echo "FAIL: $name" >&2; cat "$dir/log.txt" >&2; }
+  exit 0
+fi
+
+target=host
+[ -n "$FQBN" ] && target="$(echo "$FQBN" | tr ':' '-')"
+budgets="budgets-$target.txt"
+update=0
+jobs="$(nproc 2> /dev/null || echo 4)"
+while getopts "b:uj:" opt; do
+  case $opt in
+    b) budgets="$OPTARG" ;;
+    u) update=1 ;;
+    j) jobs="$OPTARG" ;;
+    *) exit 2 ;;
+  esac
+done
+shift $((OPTIND - 1))
+pattern="${1:-.}"
+aliases="$(grep -o '^using Able[A-Za-z]*Button ' ../../src/AbleButtons.h | awk '{ print $2 }' | grep -E "$pattern" | sort -u)"
+[ -n "$aliases" ] || { echo "No aliases match $pattern"; exit 2; }
+
+# Write a sketch with a list of n buttons of an alias (no buttons if n is 0).
+sketch() {
+  local alias="$1" n="$2" dir="build/$1-$2"
+  mkdir -p "$dir"
+  {
+    echo '#include <AbleButtons.h>'
+    if [ "$n" -gt 0 ]; then
+      echo "using Btn = $alias;"
+      echo 'template <typename E, typename... A> void onEvent(E event, A...) { digitalWrite(LED_BUILTIN, event == 1); }'
+      case $alias in
+        AbleTable*) # Buttons configured by a PROGMEM table.
+          echo "const able::ButtonTableEntry table[] PROGMEM = {$(for ((i = 0; i < n; ++i)); do printf '{%d, 1, %d, 0}, ' $((i + 2)) $((i + 1)); done)};"
+          case $alias in
+            *Callback*) echo "${alias}List<$n> btnList(table, onEvent);" ;;
+            *) echo "${alias}List<$n> btnList(table);" ;;
+          esac
+          ;;
+        *)
+          echo "using BtnList = ${alias}List;"
+          for ((i = 0; i < n; ++i)); do
+            case $alias in
+              *Callback*) echo "Btn btn$i($((i + 2)), onEvent);" ;;
+              *) echo "Btn btn$i($((i + 2)));" ;;
+            esac
+          done
+          echo "Btn *btns[] = {$(for ((i = 0; i < n; ++i)); do printf '&btn%d, ' $i; done)};"
+          echo 'BtnList btnList(btns);'
+          ;;
+      esac
+      echo 'void setup() { btnList.begin(); }'
+      echo 'void loop() { btnList.handle(); }'
+    else
+      echo 'void setup() {}'
+      echo 'void loop() {}'
+    fi
+  } > "$dir/$1-$2.ino"
+  rm -f "$dir/size.txt"
+}
+
+rm -rf build
+sketch Empty 0
+for alias in $aliases AblePulldownButton AblePullupButton; do
+  for n in 1 8 32; do sketch "$alias" $n; done
+done
+printf '%s\n' build/*/ | xargs -P "$jobs" -n 1 "$self" --compile
+
+# Tabulate the sizes and check them against the budgets.
+for alias in $aliases; do
+  basic=AblePullupButton
+  case $alias in AblePulldown*) basic=AblePulldownButton ;; esac
+  echo "$alias $(cat build/Empty-0/size.txt build/$basic-1/size.txt build/$alias-1/size.txt build/$alias-8/size.txt build/$alias-32/size.txt 2> /dev/null | tr '\n' ' ')"
+done | awk -v budgets="$budgets" -v update="$update" '
+  BEGIN {
+    while((getline line < budgets) > 0) {
+      if(line ~ /^[ \t]*(#|$)/) continue;
+      split(line, f);
+      pat = f[1]; gsub(/\*/, ".*", pat);
+      pats[++npats] = "^" pat "$"; bt[npats] = f[2]; br[npats] = f[3]; bb[npats] = f[4];
+    }
+    fmt = "| %-49s | %6s | %5s | %5s | %12s | %11s | %11s | %10s |\n";
+    printf fmt, "Alias", "Text", "Data", "BSS", "Feature text", "Feature RAM", "Text/button", "RAM/button";
+    sep = sprintf("%48s", ""); gsub(/ /, "-", sep);
+    printf "| :%s | -----: | ----: | ----: | -----------: | ----------: | ----------: | ---------: |\n", sep;
+  }
+  NF < 16 { printf "| %-49s | build failed\n", $1; failed = 1; next }
+  {
+    text = $8 - $2; data = $9 - $3; bss = $10 - $4; ram = data + bss;
+    featText = $8 - $5; featRam = ($9 + $10) - ($6 + $7);
+    btnText = ($14 - $11) / 24; btnRam = (($15 + $16) - ($12 + $13)) / 24;
+    printf fmt, $1, text, data, bss, featText, featRam, sprintf("%.1f", btnText), sprintf("%.1f", btnRam);
+    rows[++nrows] = $1 " " text " " ram " " btnRam;
+    for(i = 1; i <= npats; ++i) {
+      if($1 !~ pats[i]) continue;
+      if(bt[i] != "-" && text > bt[i]) over = over sprintf("OVER BUDGET: %s text %d > %d\n", $1, text, bt[i]);
+      if(br[i] != "-" && ram > br[i]) over = over sprintf("OVER BUDGET: %s RAM %d > %d\n", $1, ram, br[i]);
+      if(bb[i] != "-" && btnRam > bb[i]) over = over sprintf("OVER BUDGET: %s RAM/button %.1f > %s\n", $1, btnRam, bb[i]);
+      break;
+    }
+  }
+  END {
+    if(update && !failed) {
+      print "# Footprint budgets: alias-pattern text RAM RAM/button (- for none)." > budgets;
+      print "# Text and RAM are of one button over an empty sketch. Written by footprint.sh -u." > budgets;
+      for(i = 1; i <= nrows; ++i) {
+        split(rows[i], f);
+        printf "%-49s %6d %5d %5.1f\n", f[1], f[2] + int(f[2] / 10) + 16, f[3] + 4, int(f[4] * 10 + 0.99) / 10 > budgets;
+      }
+      printf "\nBudgets written to %s\n", budgets;
+      over = "";
+    }
+    if(npats == 0 && !update) printf "\nNo budgets (%s)\n", budgets;
+    printf "%s", over;
+    exit (failed || over != "") ? 1 : 0;
+  }'
@@ -0,0 +1,14 @@
+/**
+ * @file Arduino.cpp Virtual clock, pins and serial port of the host stand-in
+ * for the Arduino core.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include "Arduino.h"
+
+unsigned long host::clockMillis = 0;
+unsigned long host::clockMicros = 0;
+uint8_t host::pins[256];
+uint32_t host::ports[9];
+void (*host::isrs[256])();
+HardwareSerial Serial;
@@ -0,0 +1,138 @@
+/**
+ * @file Arduino.h Host stand-in for the Arduino core, used to build and run
+ * the AbleButtons host tests on a PC. Provides a virtual clock and virtual
+ * pins so recorded or generated button signals can be replayed through the
+ * button classes faster than real time. Only the parts of the Arduino core
+ * used by AbleButtons are provided.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte; ///< Arduino byte type.
+
+#define HIGH 0x1 ///< Pin reading for a high voltage.
+#define LOW 0x0 ///< Pin reading for a low voltage.
+
+#define INPUT 0x0 ///< Pin mode for an input.
+#define OUTPUT 0x1 ///< Pin mode for an output.
+#define INPUT_PULLUP 0x2 ///< Pin mode for an input with internal pull-up.
+
+#define LED_BUILTIN 13 ///< Pin of the built-in LED.
+
+#define CHANGE 1 ///< Interrupt mode calling the function when a pin changes.
+#define NOT_A_PORT 0 ///< Port of an invalid pin.
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s)) ///< Strings are not held in flash on the host.
+#define PROGMEM ///< Tables are not held in flash on the host.
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr)) ///< Read a byte of a table.
+#define pgm_read_word(addr) (*(const uint16_t *)(addr)) ///< Read a 16-bit word of a table.
+
+namespace host {
+  extern unsigned long clockMillis; ///< The virtual millisecond clock.
+  extern unsigned long clockMicros; ///< The virtual microsecond clock.
+  extern uint8_t pins[256]; ///< The virtual pin levels.
+  extern uint32_t ports[9]; ///< The virtual input ports, 32 pins each (port 0 is not a port).
+  extern void (*isrs[256])(); ///< Interrupt functions called when each pin changes.
+
+  /**
+   * Set the virtual clock in microseconds, which also sets the millisecond
+   * clock.
+   *
+   * @param us The new time in microseconds.
+   */
+  inline void setMicros(unsigned long us) {
+    clockMicros = us;
+    clockMillis = us / 1000;
+  }
+
+  /**
+   * Set the virtual clock in milliseconds, which also sets the microsecond
+   * clock.
+   *
+   * @param ms The new time in milliseconds.
+   */
+  inline void setMillis(unsigned long ms) {
+    clockMillis = ms;
+    clockMicros = ms * 1000;
+  }
+
+  /**
+   * Set the level of a virtual pin (and its bit in the port), calling its
+   * interrupt function (if attached) when the level changes.
+   *
+   * @param pin The pin to set.
+   * @param level The level (HIGH or LOW) of the pin.
+   */
+  inline void setPin(uint8_t pin, uint8_t level) {
+    bool changed = pins[pin] != level;
+    pins[pin] = level;
+    ports[1 + pin / 32] = (ports[1 + pin / 32] & ~(1UL << pin % 32)) | (level ? 1UL << pin % 32 : 0);
+    if(changed && isrs[pin]) isrs[pin]();
+  }
+}
+
+inline unsigned long millis() { return host::clockMillis; } ///< Return the virtual millisecond clock.
+inline unsigned long micros() { return host::clockMicros; } ///< Return the virtual microsecond clock.
+inline int digitalRead(uint8_t pin) { return host::pins[pin]; } ///< Read a virtual pin.
+#define digitalPinToPort(pin) ((uint8_t)(1 + (pin) / 32)) ///< Return the virtual port of a pin.
+#define digitalPinToBitMask(pin) ((uint32_t)(1UL << (pin) % 32)) ///< Return the bit of a pin in its port.
+#define portInputRegister(port) ((volatile uint32_t *)(host::ports + (port))) ///< Return the input register of a virtual port.
+inline void digitalWrite(uint8_t pin, uint8_t level) { host::pins[pin] = level; } ///< Write a virtual pin.
+inline void pinMode(uint8_t /* pin */, uint8_t /* mode */) {} ///< Pin modes are ignored.
+inline void analogWrite(uint8_t pin, int value) { host::pins[pin] = value ? HIGH : LOW; } ///< Write a virtual pin (on if the value is not 0).
+inline void delay(unsigned long ms) { host::setMillis(host::clockMillis + ms); } ///< Advance the virtual clock.
+inline uint8_t digitalPinToInterrupt(uint8_t pin) { return pin; } ///< Every virtual pin has its own interrupt.
+inline void attachInterrupt(uint8_t irq, void (*fn)(), int /* mode */) { host::isrs[irq] = fn; } ///< Call a function when a pin changes.
+inline void detachInterrupt(uint8_t irq) { host::isrs[irq] = 0; } ///< Stop calling a function when a pin changes.
+inline void noInterrupts() {} ///< Interrupts only occur in setPin() on the host.
+inline void interrupts() {} ///< Interrupts only occur in setPin() on the host.
+#define constrain(x, low, high) ((x) < (low) ? (low) : (x) > (high) ? (high) : (x)) ///< Limit a value to a range.
+inline long random(long max) { return max > 0 ? rand() % max : 0; } ///< Return a pseudo-random number from 0 to max-1.
+inline long random(long min, long max) { return min < max ? min + random(max - min) : min; } ///< Return a pseudo-random number from min to max-1.
+
+/**
+ * Print class formatting values and writing them with write(), as with the
+ * Arduino core. Sub-classes override write(uint8_t) to send the bytes.
+ */
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0; ///< Write a byte.
+    virtual size_t write(const uint8_t *buf, size_t n) { size_t w = 0; while(n--) w += write(*buf++); return w; } ///< Write bytes.
+    virtual int availableForWrite() { return 0; } ///< Bytes that can be written without blocking.
+    virtual void flush() {} ///< Wait for written bytes to be sent.
+    size_t write(const char *s) { return write(reinterpret_cast<const uint8_t *>(s), strlen(s)); } ///< Write a string.
+    size_t print(const __FlashStringHelper *s) { return write(reinterpret_cast<const char *>(s)); } ///< Print a string.
+    size_t print(const char *s) { return write(s); } ///< Print a string.
+    size_t print(char c) { return write(static_cast<uint8_t>(c)); } ///< Print a character.
+    size_t print(unsigned char n) { return print(static_cast<unsigned long>(n)); } ///< Print a number.
+    size_t print(int n) { return print(static_cast<long>(n)); } ///< Print a number.
+    size_t print(unsigned int n) { return print(static_cast<unsigned long>(n)); } ///< Print a number.
+    size_t print(long n) { char buf[24]; snprintf(buf, sizeof(buf), "%ld", n); return write(buf); } ///< Print a number.
+    size_t print(unsigned long n) { char buf[24]; snprintf(buf, sizeof(buf), "%lu", n); return write(buf); } ///< Print a number.
+    template <typename T> size_t println(T v) { size_t n = print(v); return n + println(); } ///< Print a value and new line.
+    size_t println() { return write("\n"); } ///< Print a new line.
+};
+
+/**
+ * Serial class writing to the standard output of the host.
+ */
+class HardwareSerial: public Print {
+  public:
+    void begin(unsigned long /* baud */) {} ///< The baud rate is ignored.
+    operator bool() { return true; } ///< Always ready.
+    using Print::write;
+    size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; } ///< Write a byte to standard output.
+    size_t write(const uint8_t *buf, size_t n) override { return fwrite(buf, 1, n, stdout); } ///< Write bytes to standard output.
+    int availableForWrite() override { return 64; } ///< Standard output never blocks for long.
+    void flush() override { fflush(stdout); } ///< Flush standard output.
+};
+
+extern HardwareSerial Serial; ///< The serial port (standard output).
@@ -0,0 +1,54 @@
+/**
+ * @file Fixtures.h Definitions of the classes shared by the host tests: a
+ * pseudo-random sequence (Random), so every run of a test is the same, and a
+ * clock counting how often it is read (CountingClock).
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#include <AbleButtons.h>
+
+namespace host {
+  /**
+   * Pseudo-random sequence, so every run of a test is the same.
+   */
+  class Random {
+    public:
+      /**
+       * Create the sequence.
+       *
+       * @param seed The seed of the sequence.
+       */
+      explicit Random(unsigned long seed)
+      :seed_(seed) {}
+
+      /**
+       * Return the next pseudo-random number.
+       *
+       * @param n The upper bound (exclusive).
+       *
+       * @return A number from 0 to n-1.
+       */
+      unsigned long next(unsigned long n) {
+        seed_ = seed_ * 1103515245UL + 12345UL;
+        return ((seed_ >> 8) & 0xFFFFFF) % n;
+      }
+
+    protected:
+      unsigned long seed_; ///< The state of the sequence.
+  };
+
+  /**
+   * Clock counting how often it is read, to check how often buttons read the
+   * clock.
+   *
+   * @param Clock The clock counted. Defaults to MillisClock.
+   */
+  template <typename Clock = able::MillisClock>
+  class CountingClock: public Clock {
+    public:
+      static unsigned long reads; ///< Readings of the clock.
+      static inline typename Clock::Time now() { ++reads; return Clock::now(); } ///< Return the time now.
+  };
+  template <typename Clock> unsigned long CountingClock<Clock>::reads = 0;
+}
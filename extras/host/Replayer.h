@@ -0,0 +1,160 @@
+/**
+ * @file Replayer.h Definition of the Replayer class, replaying a pin trace
+ * (see Trace.h) through callback buttons on the host using the virtual clock.
+ * Each pin in the trace gets its own button, and each event of each button is
+ * passed to an event function.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#include <AbleButtons.h>
+
+namespace host {
+  /**
+   * Return the name of a callback event (e.g. "PRESSED").
+   *
+   * @param event The event.
+   *
+   * @return The name of the event.
+   */
+  inline const char *eventName(able::CallbackEvents::CALLBACK_EVENT event) {
+    static const char *names[] = {"BEGIN", "PRESSED", "RELEASED", "HELD", "IDLE", "SINGLE_CLICKED", "DOUBLE_CLICKED"};
+    return event <= able::CallbackEvents::DOUBLE_CLICKED_EVENT ? names[event] : "UNKNOWN";
+  }
+
+  /**
+   * Event function type: `void fn(unsigned long millis, uint8_t pin, CALLBACK_EVENT event)`.
+   */
+  typedef void (*EventFn)(unsigned long, uint8_t, able::CallbackEvents::CALLBACK_EVENT);
+
+  /**
+   * Replayer of pin traces through callback buttons. Between records of the
+   * trace, buttons are handled every poll period, as by loop() on the device.
+   * Replays are deterministic, so the same trace always gives the same events.
+   *
+   * @param Button The callback button type to replay the trace through (e.g.
+   *               AblePullupCallbackDoubleClickerButton).
+   */
+  template <typename Button>
+  class Replayer {
+    public:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create a replayer.
+       *
+       * @param eventFn The function receiving each event.
+       * @param pollMicros Microseconds between handling buttons (default 1ms).
+       * @param tailMillis Milliseconds to continue after the last record
+       *                   (default 2s) to let held and click timers expire.
+       */
+      Replayer(EventFn eventFn, unsigned long pollMicros = 1000, unsigned long tailMillis = 2000)
+      :pollMicros_(pollMicros ? pollMicros : 1), tailMillis_(tailMillis) {
+        eventFn_ = eventFn;
+      }
+
+    public:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Replay a trace. Buttons start in the opposite state to the first
+       * record of their pin.
+       *
+       * @param data The trace, starting with the header.
+       * @param size The size of the trace in bytes.
+       *
+       * @return The number of records replayed, or -1 if not a trace.
+       */
+      long replay(const uint8_t *data, size_t size) {
+        uint8_t pin, level;
+        unsigned long t = 0;
+        Button *buttons[able::Trace::PIN + 1] = {0};
+        uint8_t count = 0;
+        long records = 0;
+
+        // Find the pins and their initial levels.
+        able::TraceReader scan(data, size);
+        if(!scan.isValid()) return -1;
+        setMicros(scan.micros());
+        while(scan.next(pin, level, t)) {
+          if(!buttons[pin]) {
+            setPin(pin, !level);
+            buttons[pin] = new Button(pin, onEvent, pin); // Use the pin as the id.
+            buttons_[count++] = buttons[pin];
+          }
+        }
+        for(uint8_t i = 0; i < count; ++i) buttons_[i]->begin();
+
+        // Replay the records, handling buttons every poll period between them.
+        // Records with the same timestamp were read by the same loop(), so
+        // are all applied before handling the buttons.
+        able::TraceReader reader(data, size);
+        unsigned long last = reader.micros();
+        unsigned long nextPoll = last + pollMicros_;
+        bool more = reader.next(pin, level, t);
+        while(more) {
+          for(; (long)(t - nextPoll) > 0; nextPoll += pollMicros_) {
+            setMicros(nextPoll);
+            handle(count);
+          }
+          last = t;
+          setMicros(t);
+          do {
+            setPin(pin, level);
+            ++records;
+            more = reader.next(pin, level, t);
+          } while(more && t == last);
+          handle(count);
+          if(nextPoll == last) nextPoll += pollMicros_; // Already handled.
+        }
+
+        unsigned long end = last + tailMillis_ * 1000;
+        for(; (long)(end - nextPoll) > 0; nextPoll += pollMicros_) {
+          setMicros(nextPoll);
+          handle(count);
+        }
+
+        for(uint8_t i = 0; i < count; ++i) delete buttons_[i];
+        return records;
+      }
+
+    protected:
+      //
+      // Helpers...
+      //
+
+      /**
+       * Handle all buttons.
+       *
+       * @param count The number of buttons.
+       */
+      inline void handle(uint8_t count) {
+        for(uint8_t i = 0; i < count; ++i) buttons_[i]->handle();
+      }
+
+      /**
+       * Callback of all buttons, passing the event to the event function.
+       *
+       * @param event The event that occurred.
+       * @param pin The identifier of the button (its pin).
+       */
+      static void onEvent(able::CallbackEvents::CALLBACK_EVENT event, uint8_t pin) {
+        eventFn_(millis(), pin, event);
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      unsigned long pollMicros_; ///< Microseconds between handling buttons.
+      unsigned long tailMillis_; ///< Milliseconds to continue after the trace.
+      Button *buttons_[able::Trace::PIN + 1]; ///< The buttons being replayed.
+      static EventFn eventFn_; ///< The function receiving each event.
+  };
+
+  template <typename Button> EventFn Replayer<Button>::eventFn_ = 0;
+}
@@ -0,0 +1,18 @@
+# Build the host tools and tests, then run the tests. Each .cpp file in tools
+# and tests is a program built against the library with the host stand-in for
+# the Arduino core. Tests exit non-zero when they fail. A source file may add
+# compiler flags with a `// Flags: ...` line (e.g. `// Flags: -std=gnu++20`).
+cd "$(dirname "$0")"
+mkdir -p build
+fail=0
+for src in tools/*.cpp tests/*.cpp; do
+  name="$(basename "$src" .cpp)"
+  flags="$(sed -n 's|^// Flags: ||p' "$src")"
+  ${CXX:-g++} -std=gnu++11 $flags -O2 -Wall -Wextra -I. -I../../src -o "build/$name" "$src" Arduino.cpp ../../src/*.cpp || fail=1
+done
+for src in tests/*.cpp; do
+  name="$(basename "$src" .cpp)"
+  echo "== $name"
+  [ -x "build/$name" ] && "./build/$name" || fail=1
+done
+exit $fail
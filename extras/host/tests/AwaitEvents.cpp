@@ -0,0 +1,240 @@
+/**
+ * @file AwaitEvents.cpp Test of awaitable buttons. Coroutines co_await each
+ * event of two awaitable callback double-clicker buttons, and events of their
+ * button list, while generated taps, holds and double-clicks are handled. The
+ * test fails unless:
+ *
+ * - each coroutine resumes for the same events, at the same times, as the
+ *   callback function of its button;
+ * - an awaitable (non-callback) double-clicker button pressed with the first
+ *   button resumes coroutines for the same events as the callback function;
+ * - list coroutines resume once for each event of any button, or each time
+ *   all the buttons become pressed;
+ * - a finished or destroyed coroutine is no longer resumed;
+ * - waiting allocates no heap memory.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+// Flags: -std=gnu++20
+#include <stdlib.h>
+#include <algorithm>
+#include <new>
+#include <vector>
+#include <AbleButtons.h>
+#include "Fixtures.h"
+
+using E = able::CallbackEvents;
+using Button = able::AwaitableButton<AblePullupCallbackDoubleClickerButton>;
+using ButtonList = able::AwaitableButtonList<Button>;
+using PlainButton = able::AwaitableButton<AblePullupDoubleClickerButton>;
+
+const uint8_t BUTTONS = 2; ///< Buttons in the list.
+const unsigned long RUN_MILLIS = 600000; ///< How long to run (ms).
+
+//
+// Heap allocations...
+//
+unsigned long allocations = 0; ///< Number of heap allocations.
+
+void *operator new(size_t size) {
+  ++allocations;
+  void *p = malloc(size ? size : 1);
+  if(!p) throw std::bad_alloc();
+  return p;
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+/**
+ * An event of a button.
+ */
+struct Event {
+  unsigned long millis; ///< When the event occurred.
+  uint8_t id; ///< The button.
+  uint8_t event; ///< The event.
+  bool operator<(const Event &e) const { return millis != e.millis ? millis < e.millis : id != e.id ? id < e.id : event < e.event; } ///< Order events.
+  bool operator!=(const Event &e) const { return millis != e.millis || id != e.id || event != e.event; } ///< Compare events.
+};
+
+std::vector<Event> callbackEvents; ///< Events of the callback functions.
+std::vector<Event> awaitedEvents; ///< Events of the coroutines.
+std::vector<Event> plainEvents; ///< Events of the coroutines of the non-callback button.
+host::Random rnd(4321); ///< Pseudo-random sequence, so every run is the same.
+
+void onEvent(E::CALLBACK_EVENT event, uint8_t id) {
+  if(event != E::BEGIN_EVENT) callbackEvents.push_back(Event{millis(), id, (uint8_t) event});
+}
+
+//
+// Coroutines...
+//
+
+/**
+ * Wait for an event of a button forever, recording each one.
+ *
+ * @param btn The button.
+ * @param wait The event method of the button (e.g. &Button::clicked).
+ * @param event The callback event code of the event.
+ * @param events The events to record it in.
+ */
+template <typename B>
+able::ButtonTask awaitEvent(const B &btn, typename B::Event (B::*wait)() const, E::CALLBACK_EVENT event, std::vector<Event> &events) {
+  for(;;) {
+    co_await (btn.*wait)();
+    events.push_back(Event{millis(), (uint8_t) btn.id(), (uint8_t) event});
+  }
+}
+
+/**
+ * Count the times a list event occurs, forever.
+ *
+ * @param list The button list.
+ * @param wait The event method of the list (e.g. &ButtonList::anyHeld).
+ * @param count Incremented each time the event occurs.
+ */
+able::ButtonTask countEvent(const ButtonList &list, ButtonList::Event (ButtonList::*wait)() const, unsigned long &count) {
+  for(;;) {
+    co_await (list.*wait)();
+    ++count;
+  }
+}
+
+/**
+ * Wait for some clicks of a button, then finish.
+ *
+ * @param btn The button.
+ * @param clicks The number of clicks to wait for.
+ * @param count Incremented for each click.
+ */
+able::ButtonTask countClicks(const Button &btn, unsigned clicks, unsigned long &count) {
+  while(clicks--) {
+    co_await btn.clicked();
+    ++count;
+  }
+}
+
+int main() {
+  bool ok = true;
+  Button btn1(2, onEvent, 1), btn2(3, onEvent, 2);
+  PlainButton plain(4, 0, 1); // Pressed with btn1.
+  Button *buttons[] = {&btn1, &btn2};
+  ButtonList list(buttons);
+  unsigned long nextChange[BUTTONS];
+  unsigned long anyPressed = 0, anyHeld = 0, anyClicked = 0, allPressed = 0, expectAllPressed = 0;
+  unsigned long finiteClicks = 0, destroyedClicks = 0;
+  bool wasAllPressed = false;
+
+  callbackEvents.reserve(100000);
+  awaitedEvents.reserve(100000);
+  plainEvents.reserve(100000);
+  Button::setIdleTime(5000);
+  host::setMillis(1000);
+  for(uint8_t b = 0; b < BUTTONS; ++b) {
+    host::setPin(2 + b, HIGH);
+    nextChange[b] = 1000 + rnd.next(500);
+  }
+  list.begin();
+  host::setPin(4, HIGH);
+  plain.begin();
+
+  std::vector<able::ButtonTask> tasks;
+  tasks.reserve(32);
+  for(Button *btn : buttons) {
+    tasks.push_back(awaitEvent(*btn, &Button::pressed, E::PRESSED_EVENT, awaitedEvents));
+    tasks.push_back(awaitEvent(*btn, &Button::released, E::RELEASED_EVENT, awaitedEvents));
+    tasks.push_back(awaitEvent(*btn, &Button::held, E::HELD_EVENT, awaitedEvents));
+    tasks.push_back(awaitEvent(*btn, &Button::idle, E::IDLE_EVENT, awaitedEvents));
+    tasks.push_back(awaitEvent(*btn, &Button::singleClicked, E::SINGLE_CLICKED_EVENT, awaitedEvents));
+    tasks.push_back(awaitEvent(*btn, &Button::doubleClicked, E::DOUBLE_CLICKED_EVENT, awaitedEvents));
+  }
+  tasks.push_back(awaitEvent(plain, &PlainButton::pressed, E::PRESSED_EVENT, plainEvents));
+  tasks.push_back(awaitEvent(plain, &PlainButton::released, E::RELEASED_EVENT, plainEvents));
+  tasks.push_back(awaitEvent(plain, &PlainButton::held, E::HELD_EVENT, plainEvents));
+  tasks.push_back(awaitEvent(plain, &PlainButton::idle, E::IDLE_EVENT, plainEvents));
+  tasks.push_back(awaitEvent(plain, &PlainButton::singleClicked, E::SINGLE_CLICKED_EVENT, plainEvents));
+  tasks.push_back(awaitEvent(plain, &PlainButton::doubleClicked, E::DOUBLE_CLICKED_EVENT, plainEvents));
+  tasks.push_back(countEvent(list, &ButtonList::anyPressed, anyPressed));
+  tasks.push_back(countEvent(list, &ButtonList::anyHeld, anyHeld));
+  tasks.push_back(countEvent(list, &ButtonList::anyClicked, anyClicked));
+  tasks.push_back(countEvent(list, &ButtonList::allPressed, allPressed));
+  able::ButtonTask finite = countClicks(btn1, 5, finiteClicks);
+  {
+    able::ButtonTask destroyed = countClicks(btn2, 5, destroyedClicks); // Destroyed while waiting.
+  }
+
+  unsigned long startAllocations = allocations;
+  for(unsigned long t = 1; t <= RUN_MILLIS; ++t) {
+    host::setMillis(1000 + t);
+    for(uint8_t b = 0; b < BUTTONS; ++b) {
+      if(millis() >= nextChange[b]) {
+        uint8_t level = !digitalRead(2 + b);
+        host::setPin(2 + b, level);
+        if(b == 0) host::setPin(4, level);
+        nextChange[b] = millis() + (level == LOW ? 60 + rnd.next(rnd.next(4) ? 150 : 1500) : 60 + rnd.next(rnd.next(3) ? 150 : 8000));
+      }
+    }
+    list.handle();
+    plain.handle();
+
+    // Expected all-pressed events, polled as a loop() would.
+    if(list.allPressed() && !wasAllPressed) ++expectAllPressed;
+    wasAllPressed = list.allPressed();
+  }
+  unsigned long runAllocations = allocations - startAllocations;
+
+  std::sort(callbackEvents.begin(), callbackEvents.end());
+  std::sort(awaitedEvents.begin(), awaitedEvents.end());
+  printf("button events: callback=%zu awaited=%zu\n", callbackEvents.size(), awaitedEvents.size());
+  if(callbackEvents.size() != awaitedEvents.size()) {
+    printf("FAIL: awaited events differ from callback events\n");
+    ok = false;
+  }
+  for(size_t i = 0; i < callbackEvents.size() && i < awaitedEvents.size(); ++i) {
+    if(callbackEvents[i] != awaitedEvents[i]) {
+      printf("FAIL: event %zu callback %lu %u %u, awaited %lu %u %u\n", i,
+        callbackEvents[i].millis, callbackEvents[i].id, callbackEvents[i].event,
+        awaitedEvents[i].millis, awaitedEvents[i].id, awaitedEvents[i].event);
+      ok = false;
+      break;
+    }
+  }
+
+  std::vector<Event> btn1Events;
+  for(const Event &e : callbackEvents) {
+    if(e.id == 1) btn1Events.push_back(e);
+  }
+  std::sort(plainEvents.begin(), plainEvents.end());
+  printf("non-callback button events: callback=%zu awaited=%zu\n", btn1Events.size(), plainEvents.size());
+  if(btn1Events.size() != plainEvents.size() || !std::equal(btn1Events.begin(), btn1Events.end(), plainEvents.begin(), [](const Event &a, const Event &b) { return !(a != b); })) {
+    printf("FAIL: awaited events of the non-callback button differ from callback events\n");
+    ok = false;
+  }
+
+  unsigned long expectAnyPressed = 0, expectAnyHeld = 0, expectAnyClicked = 0;
+  for(const Event &e : callbackEvents) {
+    expectAnyPressed += e.event == E::PRESSED_EVENT;
+    expectAnyHeld += e.event == E::HELD_EVENT;
+    expectAnyClicked += e.event == E::SINGLE_CLICKED_EVENT || e.event == E::DOUBLE_CLICKED_EVENT;
+  }
+  printf("list events: anyPressed=%lu/%lu anyHeld=%lu/%lu anyClicked=%lu/%lu allPressed=%lu/%lu\n",
+    anyPressed, expectAnyPressed, anyHeld, expectAnyHeld, anyClicked, expectAnyClicked, allPressed, expectAllPressed);
+  if(anyPressed != expectAnyPressed || anyHeld != expectAnyHeld || anyClicked != expectAnyClicked || allPressed != expectAllPressed || !allPressed) {
+    printf("FAIL: list events differ from button events\n");
+    ok = false;
+  }
+
+  printf("finished task: clicks=%lu done=%d, destroyed task: clicks=%lu\n", finiteClicks, finite.done(), destroyedClicks);
+  if(finiteClicks != 5 || !finite.done() || destroyedClicks) {
+    printf("FAIL: finished or destroyed task resumed\n");
+    ok = false;
+  }
+
+  printf("heap allocations while waiting: %lu\n", runAllocations);
+  if(runAllocations) {
+    printf("FAIL: waiting allocated heap memory\n");
+    ok = false;
+  }
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file BounceHistogram.cpp Test of the bounce histogram. Generated presses
+ * and releases bouncing for a known time, and single-reading noise spikes,
+ * are read by buttons counting a BounceHistogram, for each of the timer and
+ * integrator debouncers. The test fails unless:
+ *
+ * - each burst is counted in the bin of the time from its first to its last
+ *   raw change, whether the debouncer times the raw changes (the
+ *   TimerDebouncer) or only changes of the debounced state (the
+ *   IntegratorDebouncer), so noise settling back is a burst of 1ms;
+ * - autoTune() tunes the debounce time just above the longest burst;
+ * - the histogram prints the bin width in the units of the clock.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <string>
+#include <AbleButtons.h>
+#include "Fixtures.h"
+
+const unsigned long GESTURES = 2000; ///< Presses (each with a release and noise spike).
+const uint8_t GROUPS = 6; ///< Most groups of bounce readings in a burst (see bounce()).
+
+/**
+ * Print stream recording the output in a string.
+ */
+class StringPrint: public Print {
+  public:
+    using Print::write;
+    size_t write(uint8_t c) override { text += (char) c; return 1; } ///< Append a character.
+    std::string text; ///< The output.
+};
+
+/**
+ * Return the level of a bouncing pin. The burst is groups of 3 readings,
+ * two of the new level then one of the old level, then the new level: the
+ * reading keeps moving towards the new level, so an integrator does not
+ * settle during the burst.
+ *
+ * @param since The milliseconds since the burst started.
+ * @param groups The groups of readings in the burst (0 for a clean change).
+ * @param level The new level.
+ *
+ * @return The level of the pin.
+ */
+uint8_t bounce(unsigned long since, uint8_t groups, uint8_t level) {
+  return since < 3UL * groups && since % 3 == 2 ? !level : level;
+}
+
+/**
+ * Press and release a button with generated bursts of bounce, and spike its
+ * pin with noise while released, then check its histogram.
+ *
+ * @param Debouncer The debouncer class of the button.
+ * @param name The name of the run.
+ *
+ * @return True if the histogram holds the bursts generated, else false.
+ */
+template <typename Debouncer>
+bool run(const char *name) {
+  typedef able::Button<able::PullupResistorCircuit, able::ClickerPin<able::BounceHistogram<>, Debouncer>> Button;
+  host::Random rnd(6502);
+  uint16_t expected[16] = {};
+  unsigned long longest = 0;
+  bool ok = true;
+
+  host::setPin(2, HIGH);
+  host::setMillis(1000);
+  Button button(2);
+  button.begin();
+
+  for(unsigned long g = 0, ms = 1000; g < GESTURES; ++g) {
+    uint8_t pressGroups = rnd.next(GROUPS + 1), releaseGroups = rnd.next(GROUPS + 1);
+    unsigned long press = ms + 100, release = press + 200, spike = release + 200;
+
+    for(; ms < spike + 100; ++ms) {
+      uint8_t level = HIGH;
+      if(ms >= release) level = bounce(ms - release, releaseGroups, HIGH);
+      else if(ms >= press) level = bounce(ms - press, pressGroups, LOW);
+      if(ms == spike) level = LOW; // Noise, settling back at once.
+      host::setPin(2, level);
+      host::setMillis(ms);
+      button.handle();
+    }
+    ++expected[3 * pressGroups / 2];
+    ++expected[3 * releaseGroups / 2];
+    ++expected[0];
+    if(3UL * pressGroups > longest) longest = 3 * pressGroups;
+    if(3UL * releaseGroups > longest) longest = 3 * releaseGroups;
+  }
+
+  printf("%s: %u bursts, bins:", name, button.samples());
+  for(uint8_t i = 0; i < button.bins(); ++i) printf(" %u", button.bin(i));
+  printf("\n");
+  for(uint8_t i = 0; i < button.bins(); ++i) {
+    if(button.bin(i) != expected[i]) {
+      printf("FAIL: %s: bin %u counted %u bursts, expected %u\n", name, i, button.bin(i), expected[i]);
+      ok = false;
+    }
+  }
+  unsigned long tuned = (longest / 2 + 1) * 2;
+  if(!button.autoTune(100) || button.tunedDebounceTime() != tuned) {
+    printf("FAIL: %s: tuned debounce time %u, expected %lu\n", name, button.tunedDebounceTime(), tuned);
+    ok = false;
+  }
+  return ok;
+}
+
+int main() {
+  bool ok = true;
+
+  ok = run<able::TimerDebouncer>("timer") && ok;
+  ok = run<able::IntegratorDebouncer<>>("integrator") && ok;
+
+  // The bin width is printed in the units of the clock.
+  able::Button<able::PullupResistorCircuit, able::ClickerPin<able::BounceHistogram<>>> pin(3);
+  StringPrint millisOut, microsOut;
+  pin.printHistogram(millisOut);
+  pin.printHistogram<able::MicrosClock>(microsOut);
+  if(millisOut.text.compare(0, 10, "2ms bins: ") != 0 || microsOut.text.compare(0, 10, "2us bins: ") != 0) {
+    printf("FAIL: histogram printed as \"%s\" and \"%s\"\n", millisOut.text.c_str(), microsOut.text.c_str());
+    ok = false;
+  }
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
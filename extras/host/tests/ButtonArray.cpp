@@ -0,0 +1,118 @@
+/**
+ * @file ButtonArray.cpp Test of the button array. Generated taps, holds and
+ * double-clicks are pressed on a list of double-clicker buttons and on a
+ * button array on the same pins. The test fails unless, after every handle():
+ *
+ * - each button of the array reads the same pressed, held, idle, clicked,
+ *   single-clicked and double-clicked states as the button of the list;
+ * - the any and all queries of the array match those of the list;
+ * - resetting clicks of the array returns the same as for the list.
+ *
+ * The idle time is set only through the array, so the buttons of the list
+ * match it only if arrays share their times with buttons of the same clock.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <AbleButtons.h>
+#include "Fixtures.h"
+
+using Button = AblePullupDoubleClickerButton;
+using ButtonList = AblePullupDoubleClickerButtonList;
+
+const uint8_t BUTTONS = 16; ///< Buttons in the list and the array.
+const unsigned long RUN_MILLIS = 200000; ///< How long to run (ms).
+
+host::Random rnd(1977); ///< Pseudo-random sequence, so every run is the same.
+
+/**
+ * Return the states of a button as a bit mask.
+ *
+ * @param pressed, held, idle, clicked, single, dbl The states.
+ *
+ * @return The states, one bit each.
+ */
+uint8_t states(bool pressed, bool held, bool idle, bool clicked, bool single, bool dbl) {
+  return pressed | held << 1 | idle << 2 | clicked << 3 | single << 4 | dbl << 5;
+}
+
+int main() {
+  bool ok = true;
+  uint8_t pins[BUTTONS];
+  Button *buttons[BUTTONS];
+  bool pressed[BUTTONS] = {};
+  unsigned long nextChange[BUTTONS], lastChange[BUTTONS] = {};
+  unsigned long checks = 0, mismatches = 0, seen = 0;
+
+  host::setMillis(1000);
+  AblePullupButtonArray<BUTTONS>::setIdleTime(3000); // Also sets the idle time of the buttons.
+  for(uint8_t b = 0; b < BUTTONS; ++b) {
+    pins[b] = 2 + b;
+    host::setPin(pins[b], HIGH);
+    buttons[b] = new Button(pins[b]);
+    nextChange[b] = 1000 + rnd.next(500);
+  }
+  ButtonList list(buttons, BUTTONS);
+  AblePullupButtonArray<BUTTONS> array(pins);
+  list.begin();
+  array.begin();
+
+  for(unsigned long t = 1; t <= RUN_MILLIS; ++t) {
+    host::setMillis(1000 + t);
+    for(uint8_t b = 0; b < BUTTONS; ++b) {
+      if(millis() >= nextChange[b]) {
+        pressed[b] = !pressed[b];
+        lastChange[b] = millis();
+        nextChange[b] = millis() + (pressed[b] ? 60 + rnd.next(rnd.next(4) ? 150 : 1500) : 60 + rnd.next(rnd.next(3) ? 150 : 4000));
+      }
+      uint8_t level = pressed[b] ? LOW : HIGH;
+      if(millis() - lastChange[b] < 10 && rnd.next(3) == 0) level = !level; // Bounce after each change.
+      host::setPin(pins[b], level);
+    }
+    list.handle();
+    array.handle();
+
+    for(uint8_t b = 0; b < BUTTONS; ++b) {
+      uint8_t expected = states(buttons[b]->isPressed(), buttons[b]->isHeld(), buttons[b]->isIdle(), buttons[b]->isClicked(), buttons[b]->isSingleClicked(), buttons[b]->isDoubleClicked());
+      uint8_t actual = states(array.isPressed(b), array.isHeld(b), array.isIdle(b), array.isClicked(b), array.isSingleClicked(b), array.isDoubleClicked(b));
+      seen |= expected;
+      ++checks;
+      if(expected != actual && mismatches++ < 5) {
+        printf("FAIL: button %u at %lu: list states %02x, array states %02x\n", b, millis(), expected, actual);
+      }
+    }
+    uint16_t expected = list.anyPressed() | list.allPressed() << 1 | list.anyHeld() << 2 | list.allHeld() << 3 | list.anyIdle() << 4 | list.allIdle() << 5
+      | list.anyClicked() << 6 | list.allClicked() << 7 | list.anySingleClicked() << 8 | list.allSingleClicked() << 9 | list.anyDoubleClicked() << 10 | list.allDoubleClicked() << 11;
+    uint16_t actual = array.anyPressed() | array.allPressed() << 1 | array.anyHeld() << 2 | array.allHeld() << 3 | array.anyIdle() << 4 | array.allIdle() << 5
+      | array.anyClicked() << 6 | array.allClicked() << 7 | array.anySingleClicked() << 8 | array.allSingleClicked() << 9 | array.anyDoubleClicked() << 10 | array.allDoubleClicked() << 11;
+    ++checks;
+    if(expected != actual && mismatches++ < 5) {
+      printf("FAIL: list queries at %lu: list %03x, array %03x\n", millis(), expected, actual);
+    }
+
+    // Reset clicks now and then, as a program reading them would.
+    if(t % 997 == 0) {
+      uint8_t b = rnd.next(BUTTONS);
+      ++checks;
+      if(buttons[b]->resetSingleClicked() != array.resetSingleClicked(b) ||
+         buttons[b]->resetDoubleClicked() != array.resetDoubleClicked(b) ||
+         buttons[b]->resetClicked() != array.resetClicked(b)) {
+        if(mismatches++ < 5) printf("FAIL: button %u resets differ at %lu\n", b, millis());
+      }
+    }
+    if(t % 5003 == 0) {
+      ++checks;
+      if(list.resetClicked() != array.resetClicked() && mismatches++ < 5) {
+        printf("FAIL: list resets differ at %lu\n", millis());
+      }
+    }
+  }
+
+  printf("checks=%lu mismatches=%lu states seen=%02lx\n", checks, mismatches, seen);
+  if(mismatches || seen != 0x3F) {
+    printf("FAIL: button array differs from the button list\n");
+    ok = false;
+  }
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
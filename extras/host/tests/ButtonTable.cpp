@@ -0,0 +1,188 @@
+/**
+ * @file ButtonTable.cpp Test of buttons configured by a PROGMEM table.
+ * Generated taps, holds and double-clicks are pressed on pull-up and pulldown
+ * buttons, and on table buttons configured the same way, with a shorter
+ * debounce time for the pulldown buttons. The test fails unless:
+ *
+ * - each table button gives the same events, at the same times, as the
+ *   pull-up or pulldown button with the same presses;
+ * - table buttons are found by the ids of their entries, and read the same
+ *   states as the plain buttons;
+ * - snapshots, the any and all queries and the click resets of the table
+ *   match the states of the plain buttons;
+ * - table buttons use less RAM than the buttons of a list.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <algorithm>
+#include <vector>
+#include <AbleButtons.h>
+#include "Fixtures.h"
+
+using E = able::CallbackEvents;
+using S = able::ButtonStates;
+using Pullup = AblePullupCallbackDoubleClickerButton;
+using Pulldown = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DoubleClickerPin<able::PinCounters>>>>;
+
+const uint8_t BUTTONS = 6; ///< Buttons of each kind (even buttons pull-up, odd pulldown).
+const uint8_t PULLDOWN_DEBOUNCE = 20; ///< Debounce time of the pulldown buttons (ms).
+const unsigned long RUN_MILLIS = 300000; ///< How long to run (ms).
+
+/**
+ * The table of buttons on pins 12-17, with ids 101-106.
+ */
+const able::ButtonTableEntry table[BUTTONS] PROGMEM = {
+  {12, able::ButtonTableEntry::PULLUP, 101, 0},
+  {13, able::ButtonTableEntry::PULLDOWN, 102, PULLDOWN_DEBOUNCE},
+  {14, able::ButtonTableEntry::PULLUP, 103, 0},
+  {15, able::ButtonTableEntry::PULLDOWN, 104, PULLDOWN_DEBOUNCE},
+  {16, able::ButtonTableEntry::PULLUP, 105, 0},
+  {17, able::ButtonTableEntry::PULLDOWN, 106, PULLDOWN_DEBOUNCE},
+};
+
+/**
+ * An event of a button.
+ */
+struct Event {
+  unsigned long millis; ///< When the event occurred.
+  uint8_t id; ///< The button (1-BUTTONS, the same for matching buttons).
+  uint8_t event; ///< The event.
+  bool operator<(const Event &e) const { return millis != e.millis ? millis < e.millis : id != e.id ? id < e.id : event < e.event; } ///< Order events.
+  bool operator!=(const Event &e) const { return millis != e.millis || id != e.id || event != e.event; } ///< Compare events.
+};
+
+std::vector<Event> plainEvents; ///< Events of the pull-up and pulldown buttons.
+std::vector<Event> tableEvents; ///< Events of the table buttons.
+host::Random rnd(6502); ///< Pseudo-random sequence, so every run is the same.
+
+void onPlain(E::CALLBACK_EVENT event, uint8_t id) {
+  plainEvents.push_back(Event{millis(), id, (uint8_t) event});
+}
+
+void onTable(E::CALLBACK_EVENT event, uint8_t id) {
+  tableEvents.push_back(Event{millis(), (uint8_t)(id - 100), (uint8_t) event});
+}
+
+AbleTableCallbackDoubleClickerButtonList<BUTTONS> btnTable(table, onTable); ///< The table buttons.
+
+int main() {
+  bool ok = true;
+  Pullup *pullups[BUTTONS / 2];
+  Pulldown *pulldowns[BUTTONS / 2];
+  bool pressed[BUTTONS] = {};
+  unsigned long nextChange[BUTTONS];
+  unsigned long checks = 0, mismatches = 0, resets = 0;
+
+  // Plain buttons on pins 2-7.
+  host::setMillis(1000);
+  Pulldown::setDebounceTime(PULLDOWN_DEBOUNCE);
+  for(uint8_t b = 0; b < BUTTONS; ++b) {
+    bool pullup = b % 2 == 0;
+    host::setPin(2 + b, pullup ? HIGH : LOW);
+    host::setPin(12 + b, pullup ? HIGH : LOW);
+    if(pullup) pullups[b / 2] = new Pullup(2 + b, onPlain, 1 + b);
+    else pulldowns[b / 2] = new Pulldown(2 + b, onPlain, 1 + b);
+    nextChange[b] = 1000 + rnd.next(500);
+  }
+  for(uint8_t b = 0; b < BUTTONS / 2; ++b) {
+    pullups[b]->begin();
+    pulldowns[b]->begin();
+  }
+  btnTable.begin();
+
+  for(unsigned long t = 1; t <= RUN_MILLIS; ++t) {
+    host::setMillis(1000 + t);
+    for(uint8_t b = 0; b < BUTTONS; ++b) {
+      if(millis() >= nextChange[b]) {
+        pressed[b] = !pressed[b];
+        nextChange[b] = millis() + (pressed[b] ? 60 + rnd.next(rnd.next(4) ? 150 : 1500) : 60 + rnd.next(rnd.next(3) ? 150 : 2000));
+      }
+      uint8_t level = pressed[b] == (b % 2 == 0) ? LOW : HIGH; // Pull-up buttons read LOW when pressed.
+      if(rnd.next(20) == 0) level = !level; // Bounce.
+      host::setPin(2 + b, level);
+      host::setPin(12 + b, level);
+    }
+    for(uint8_t b = 0; b < BUTTONS / 2; ++b) {
+      pullups[b]->handle();
+      pulldowns[b]->handle();
+    }
+    btnTable.handle();
+
+    // Read the table as a program would, resetting clicks now and then.
+    if(t % 7 == 0) {
+      uint8_t states[BUTTONS], any = 0, all = S::ALL_STATES;
+      uint32_t clicked = 0;
+      for(uint8_t b = 0; b < BUTTONS; ++b) {
+        states[b] = b % 2 == 0 ? pullups[b / 2]->states() : pulldowns[b / 2]->states();
+        any |= states[b];
+        all &= states[b];
+        if(states[b] & S::CLICKED) clicked |= 1UL << b;
+      }
+      S snapshot = btnTable.snapshot();
+      bool same = snapshot.any == any && snapshot.all == all && snapshot.clicked == clicked
+        && btnTable.allPressed() == !!(all & S::PRESSED) && btnTable.anyPressed() == !!(any & S::PRESSED)
+        && btnTable.allHeld() == !!(all & S::HELD) && btnTable.anyHeld() == !!(any & S::HELD)
+        && btnTable.allIdle() == !!(all & S::IDLE) && btnTable.anyIdle() == !!(any & S::IDLE)
+        && btnTable.allClicked() == !!(all & S::CLICKED) && btnTable.anyClicked() == !!(any & S::CLICKED)
+        && btnTable.allSingleClicked() == !!(all & S::SINGLE_CLICKED) && btnTable.anySingleClicked() == !!(any & S::SINGLE_CLICKED)
+        && btnTable.allDoubleClicked() == !!(all & S::DOUBLE_CLICKED) && btnTable.anyDoubleClicked() == !!(any & S::DOUBLE_CLICKED);
+      if(t % 997 == 0) {
+        ++resets;
+        for(uint8_t b = 0; b < BUTTONS; ++b) {
+          if(b % 2 == 0) pullups[b / 2]->resetClicked();
+          else pulldowns[b / 2]->resetClicked();
+        }
+        same = same && btnTable.resetClicked() == !!clicked && !btnTable.anyClicked();
+      }
+      ++checks;
+      if(!same && mismatches++ < 5) {
+        printf("FAIL: table states differ from plain button states at %lu\n", millis());
+      }
+    }
+  }
+
+  std::sort(plainEvents.begin(), plainEvents.end());
+  std::sort(tableEvents.begin(), tableEvents.end());
+  printf("events: plain=%zu table=%zu\n", plainEvents.size(), tableEvents.size());
+  if(plainEvents.size() != tableEvents.size() || plainEvents.size() < 1000) {
+    printf("FAIL: table events differ from plain events\n");
+    ok = false;
+  }
+  for(size_t i = 0; i < plainEvents.size() && i < tableEvents.size(); ++i) {
+    if(plainEvents[i] != tableEvents[i]) {
+      printf("FAIL: event %zu plain %lu %u %u, table %lu %u %u\n", i,
+        plainEvents[i].millis, plainEvents[i].id, plainEvents[i].event,
+        tableEvents[i].millis, tableEvents[i].id, tableEvents[i].event);
+      ok = false;
+      break;
+    }
+  }
+
+  bool found = btnTable.button(103) == &btnTable[2] && btnTable.button(106) == &btnTable[5] && !btnTable.button(7);
+  for(uint8_t b = 0; b < BUTTONS; ++b) {
+    bool plainPressed = b % 2 == 0 ? pullups[b / 2]->isPressed() : pulldowns[b / 2]->isPressed();
+    found = found && btnTable[b].id() == 101 + b && btnTable[b].isPressed() == plainPressed;
+  }
+  printf("found by id=%d\n", found);
+  if(!found) {
+    printf("FAIL: table buttons not found by id\n");
+    ok = false;
+  }
+
+  printf("state checks=%lu mismatches=%lu resets=%lu\n", checks, mismatches, resets);
+  if(mismatches) {
+    printf("FAIL: table queries differ from plain buttons\n");
+    ok = false;
+  }
+
+  size_t listRam = sizeof(AblePullupCallbackDoubleClickerButton) + sizeof(AblePullupCallbackDoubleClickerButton *);
+  size_t tableRam = sizeof(AbleTableCallbackDoubleClickerButton);
+  printf("RAM per button: list=%zu table=%zu\n", listRam, tableRam);
+  if(tableRam >= listRam) {
+    printf("FAIL: table buttons use no less RAM than buttons of a list\n");
+    ok = false;
+  }
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,453 @@
+/**
+ * @file ClickFuzz.cpp Property-based fuzz test of the debounce and click state
+ * machines. Each case is a random sequence of bouncing taps, quick clicks,
+ * holds and double-clicks with known ground truth. The case is replayed into
+ * a DebouncedPin, ClickerPin and DoubleClickerPin button and a
+ * CallbackClickerButton, polled at a random rate. Each case is run with one
+ * of several circuits, debouncers and clocks in turn (by its seed), so a run
+ * of cases covers them all. Cases start just before a 16-bit clock wraps
+ * around.
+ *
+ * Polls where nothing can change are skipped: the buttons only change at the
+ * first poll after an edge, or a debounce, click, held or idle time after a
+ * poll at which they (or their readings) changed, so only those polls are
+ * run. The polls at which the buttons changed are queued in order, so the
+ * next of each of those times is the oldest not yet passed. Every hundredth
+ * case is also run at every poll, to check skipping changes nothing.
+ *
+ * The test checks that:
+ *
+ * - presses, clicks, holds, single-clicks and double-clicks match the truth;
+ * - no click is reported without a press, nor a double-click from one press;
+ * - callback events come in a valid order (pressed and released alternate,
+ *   held only while pressed, idle only while released, clicks only after a
+ *   release).
+ *
+ * Usage: `ClickFuzz [cases] [seed]`. A failing case prints its seed, so it
+ * can be repeated with `ClickFuzz 1 <seed>`.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+#include <AbleButtons.h>
+
+//
+// Timing of generated gestures...
+//
+
+const uint16_t HELD_TIME = 1000; ///< Held time of the buttons (default).
+const uint32_t IDLE_TIME = 300; ///< Idle time of the buttons (shortened to test idle events).
+const uint8_t MAX_BOUNCE = 10; ///< Longest contact bounce (less than the 50ms debounce time).
+const uint8_t MAX_POLL = 5; ///< Longest time between polls.
+const uint16_t WAKE_TIMES[] = {50, 250, IDLE_TIME, HELD_TIME}; ///< Debounce, half click, idle and held times, after which buttons may change.
+const uint8_t WAKES = sizeof(WAKE_TIMES) / sizeof(WAKE_TIMES[0]); ///< The number of wake times.
+const unsigned long START_MILLIS = 3 * 65536UL - 1000; ///< Start of each case, so 16-bit clocks wrap around during it.
+
+// Steady periods between edges avoid the time between the changes of a click
+// (half the default 500ms click time) by enough that the truth is certain.
+// Buttons time changes from the last bounce they see, which may be up to a
+// bounce early on one edge, a bounce late on the next, and a poll either way.
+// Short periods also let each edge settle.
+const uint16_t CLICK_GAP = 250; ///< Longest time between changes of a click.
+const uint16_t SHORT_MIN = 50 + MAX_BOUNCE + MAX_POLL + 5; ///< Shortest steady period.
+const uint16_t SHORT_MAX = CLICK_GAP - 2 * MAX_BOUNCE - MAX_POLL - 1; ///< Longest steady period within the click time.
+const uint16_t LONG_MIN = CLICK_GAP + 2 * MAX_POLL + 1; ///< Shortest steady period outside the click time.
+const uint16_t LONG_MAX = 400; ///< Longest interval (other than holds and idles).
+
+/**
+ * Ground truth of a case.
+ */
+struct Truth {
+  unsigned long presses; ///< Presses (and so releases and clicks).
+  unsigned long holds; ///< Presses longer than the held time.
+  unsigned long singles; ///< Exclusive single-clicks.
+  unsigned long doubles; ///< Double-clicks.
+};
+
+/**
+ * A change of the signal.
+ */
+struct Edge {
+  unsigned long millis; ///< When the signal changes.
+  uint8_t pressed; ///< True if pressed after the change.
+};
+
+/**
+ * Random number generator for cases. Each case has its own seed so it can be
+ * repeated on its own.
+ */
+class Random {
+  public:
+    Random(unsigned long seed): seed_(seed) {} ///< Create with a seed.
+
+    /**
+     * Return the next pseudo-random number in a range.
+     *
+     * @param lo The lower bound.
+     * @param hi The upper bound (inclusive).
+     *
+     * @return A number from lo to hi.
+     */
+    unsigned long next(unsigned long lo, unsigned long hi) {
+      seed_ = seed_ * 6364136223846793005ULL + 1442695040888963407ULL;
+      return lo + (unsigned long)((seed_ >> 33) % (hi - lo + 1));
+    }
+
+  private:
+    unsigned long long seed_; ///< The generator state.
+};
+
+/**
+ * A generated case: the signal edges (with bounce) and the ground truth.
+ */
+class Case {
+  public:
+    /**
+     * Generate a case.
+     *
+     * @param seed The seed of the case.
+     */
+    Case(unsigned long seed)
+    :rnd_(seed), count_(0), ms_(100), truth_{0, 0, 0, 0} {
+      poll_ = (uint8_t) rnd_.next(1, MAX_POLL);
+      for(unsigned long g = rnd_.next(1, 4); g; --g) {
+        switch(rnd_.next(0, 3)) {
+          case 0: // Quick click: single-clicked if followed by a long gap.
+            edge(true, rnd_.next(SHORT_MIN, SHORT_MAX));
+            edge(false, gap());
+            ++truth_.singles;
+            break;
+
+          case 1: // Slow tap: clicked but not single-clicked.
+            edge(true, rnd_.next(LONG_MIN, LONG_MAX));
+            edge(false, gap());
+            break;
+
+          case 2: // Hold.
+            edge(true, rnd_.next(HELD_TIME + LONG_MIN, HELD_TIME + LONG_MAX));
+            edge(false, gap());
+            ++truth_.holds;
+            break;
+
+          default: // Double-click.
+            edge(true, rnd_.next(SHORT_MIN, SHORT_MAX));
+            edge(false, rnd_.next(SHORT_MIN, SHORT_MAX));
+            edge(true, rnd_.next(SHORT_MIN, SHORT_MAX));
+            edge(false, gap());
+            ++truth_.doubles;
+            break;
+        }
+      }
+    }
+
+    const Edge *edges() const { return edges_; } ///< Return the edges.
+    uint8_t count() const { return count_; } ///< Return the number of edges.
+    unsigned long end() const { return ms_; } ///< Return when the case ends.
+    uint8_t poll() const { return poll_; } ///< Return the poll period.
+    const Truth &truth() const { return truth_; } ///< Return the ground truth.
+
+  private:
+    /**
+     * Return a gap after a release: long, or sometimes long enough to idle.
+     *
+     * @return The gap in milliseconds.
+     */
+    unsigned long gap() {
+      return rnd_.next(0, 3) ? rnd_.next(LONG_MIN, LONG_MAX) : rnd_.next(IDLE_TIME + LONG_MIN, IDLE_TIME + LONG_MAX);
+    }
+
+    /**
+     * Add a bouncing change of the signal, then a steady period. The steady
+     * period is timed from the end of the bounce (the debounced edge).
+     *
+     * @param pressed True for a press, false for a release.
+     * @param steady The milliseconds until the next change starts.
+     */
+    void edge(bool pressed, unsigned long steady) {
+      unsigned long bounce = rnd_.next(0, MAX_BOUNCE);
+      unsigned long end = ms_ + bounce;
+
+      if(pressed) ++truth_.presses;
+      for(bool p = pressed; ms_ < end && count_ < MAX_EDGES - 1; p = !p) {
+        edges_[count_++] = Edge{ms_, p};
+        ms_ += rnd_.next(1, 3);
+      }
+      if(!count_ || edges_[count_ - 1].pressed != pressed) {
+        edges_[count_++] = Edge{ms_ > end ? ms_ : end, pressed};
+      }
+      ms_ = edges_[count_ - 1].millis + steady;
+    }
+
+  private:
+    static const uint8_t MAX_EDGES = 80; ///< Most edges in a case.
+
+    Random rnd_; ///< The random number generator.
+    Edge edges_[MAX_EDGES]; ///< The edges.
+    uint8_t count_; ///< The number of edges.
+    unsigned long ms_; ///< When the next edge starts.
+    uint8_t poll_; ///< Milliseconds between polls.
+    Truth truth_; ///< The ground truth.
+};
+
+//
+// Checks...
+//
+
+/**
+ * Checker of the callback events of a button, in order.
+ */
+struct EventChecker {
+  bool pressed; ///< True if the last press/release event was a press.
+  bool held; ///< True if held since the last press.
+  bool idle; ///< True if idle since the last release.
+  bool clickable; ///< True if released since the last click event.
+  unsigned long counts[7]; ///< Count of each event.
+  const char *error; ///< The first error, or 0.
+
+  /**
+   * Check the next event.
+   *
+   * @param event The event.
+   */
+  void check(able::CallbackEvents::CALLBACK_EVENT event) {
+    using E = able::CallbackEvents;
+
+    ++counts[event];
+    switch(event) {
+      case E::BEGIN_EVENT:
+        break;
+
+      case E::PRESSED_EVENT:
+        if(pressed) fail("pressed twice");
+        pressed = true; held = false; clickable = false;
+        break;
+
+      case E::RELEASED_EVENT:
+        if(!pressed) fail("released without a press");
+        pressed = false; idle = false; clickable = true;
+        break;
+
+      case E::HELD_EVENT:
+        if(!pressed) fail("held while released");
+        if(held) fail("held twice");
+        held = true;
+        break;
+
+      case E::IDLE_EVENT:
+        if(pressed) fail("idle while pressed");
+        if(idle) fail("idle twice");
+        idle = true;
+        break;
+
+      default:
+        if(!clickable) fail("clicked without a press and release");
+        clickable = false;
+        break;
+    }
+  }
+
+  /**
+   * Return the number of events checked.
+   *
+   * @return The total of the event counts.
+   */
+  unsigned long total() const {
+    unsigned long rc = 0;
+    for(uint8_t i = 0; i < 7; ++i) rc += counts[i];
+    return rc;
+  }
+
+  /**
+   * Record an error (if the first).
+   *
+   * @param msg The error.
+   */
+  void fail(const char *msg) {
+    if(!error) error = msg;
+  }
+};
+
+EventChecker checker; ///< Checks events of the callback button in the case being run.
+
+void onEvent(able::CallbackEvents::CALLBACK_EVENT event, uint8_t /* id */) {
+  checker.check(event);
+}
+
+/**
+ * Runs cases through the buttons of a circuit, debouncer and clock.
+ *
+ * @param Circuit The circuit of the buttons.
+ * @param Debouncer The debouncer of the buttons.
+ * @param Clock The clock of the buttons (default MillisClock).
+ */
+template <typename Circuit, typename Debouncer, typename Clock = able::MillisClock>
+struct Fuzzer {
+  using DebouncedButton = able::Button<Circuit, able::DebouncedPin<able::NoCounters, Debouncer, Clock>>;
+  using ClickerButton = able::Button<Circuit, able::ClickerPin<able::NoCounters, Debouncer, Clock>>;
+  using DoubleClickerButton = able::Button<Circuit, able::DoubleClickerPin<able::NoCounters, Debouncer, Clock>>;
+  using CallbackButton = able::CallbackClickerButton<able::CallbackButton<DoubleClickerButton>>;
+
+  /**
+   * Run a case.
+   *
+   * @param seed The seed of the case.
+   * @param name The name of the circuit, debouncer and clock, for errors.
+   * @param everyPoll True to run every poll, else skip polls where nothing
+   *                  can change.
+   *
+   * @return True if the case passed.
+   */
+  static bool run(unsigned long seed, const char *name, bool everyPoll = false) {
+    Case c(seed);
+    const uint8_t released = Circuit::BUTTON_RELEASED;
+    const uint8_t pressed = Circuit::BUTTON_PRESSED;
+
+    DoubleClickerButton::setIdleTime(IDLE_TIME * (Clock::HELD_TIME / HELD_TIME)); // Scale to clock ticks.
+    for(uint8_t p = 2; p <= 5; ++p) host::setPin(p, released);
+    host::setMillis(START_MILLIS + 1);
+    checker = EventChecker();
+
+    DebouncedButton debounced(2);
+    ClickerButton clicker(3);
+    DoubleClickerButton doubleClicker(4);
+    CallbackButton callback(5, onEvent, 1);
+    debounced.begin();
+    clicker.begin();
+    doubleClicker.begin();
+    callback.begin();
+
+    unsigned long presses = 0, clicks = 0, singles = 0, doubles = 0, pressesSinceDouble = 0;
+    bool wasPressed = false, pressedSinceClick = false, doubleWasPressed = false, bounced = false;
+    const char *error = 0;
+    uint8_t next = 0;
+    unsigned long changes = 0;
+    changed.clear();
+    for(uint8_t i = 0; i < WAKES; ++i) woken[i] = 0;
+
+    for(unsigned long ms = 1; ms < c.end() && !error; ms = nextPoll(c, next, ms, everyPoll)) {
+      bool edge = next < c.count() && c.edges()[next].millis <= ms;
+      host::setMillis(START_MILLIS + ms);
+      for(; next < c.count() && c.edges()[next].millis <= ms; ++next) {
+        uint8_t level = c.edges()[next].pressed ? pressed : released;
+        for(uint8_t p = 2; p <= 5; ++p) host::setPin(p, level);
+      }
+
+      debounced.handle();
+      clicker.handle();
+      doubleClicker.handle();
+      callback.handle();
+
+      if(debounced.isPressed() && !wasPressed) ++presses;
+      wasPressed = debounced.isPressed();
+
+      if(clicker.isPressed()) pressedSinceClick = true;
+      if(clicker.resetClicked()) {
+        if(!pressedSinceClick) error = "ClickerPin clicked without a press";
+        pressedSinceClick = false;
+        ++clicks;
+      }
+
+      if(doubleClicker.isPressed() && !doubleWasPressed) ++pressesSinceDouble;
+      doubleWasPressed = doubleClicker.isPressed();
+      if(doubleClicker.resetSingleClicked()) ++singles;
+      if(doubleClicker.resetDoubleClicked()) {
+        if(pressesSinceDouble < 2) error = "DoubleClickerPin double-clicked from one press";
+        pressesSinceDouble = 0;
+        ++doubles;
+      }
+
+      // Buttons may change again a debounce, click, held or idle time after
+      // they (or their readings) change. The debouncers fuzzed time a change
+      // of the readings alone from the last raw change, so a bounce replaces
+      // a queued bounce not yet woken for.
+      unsigned long total = (presses + clicks + singles + doubles + checker.total()) * 16
+        + debounced.isPressed() * 8 + clicker.isPressed() * 4 + doubleClicker.isPressed() * 2 + callback.isPressed();
+      if(total != changes) {
+        changed.push_back(ms);
+        changes = total;
+        bounced = false;
+      } else if(edge) {
+        if(bounced && ms - changed.back() < WAKE_TIMES[0]) changed.back() = ms;
+        else changed.push_back(ms);
+        bounced = true;
+      }
+    }
+
+    using E = able::CallbackEvents;
+    const Truth &t = c.truth();
+    if(!error && presses != t.presses) error = "DebouncedPin presses differ from truth";
+    if(!error && clicks != t.presses) error = "ClickerPin clicks differ from truth";
+    if(!error && singles != t.singles) error = "DoubleClickerPin single-clicks differ from truth";
+    if(!error && doubles != t.doubles) error = "DoubleClickerPin double-clicks differ from truth";
+    if(!error) error = checker.error;
+    if(!error && checker.counts[E::PRESSED_EVENT] != t.presses) error = "CallbackClickerButton presses differ from truth";
+    if(!error && checker.counts[E::HELD_EVENT] != t.holds) error = "CallbackClickerButton holds differ from truth";
+    if(!error && checker.counts[E::SINGLE_CLICKED_EVENT] != t.singles) error = "CallbackClickerButton single-clicks differ from truth";
+    if(!error && checker.counts[E::DOUBLE_CLICKED_EVENT] != t.doubles) error = "CallbackClickerButton double-clicks differ from truth";
+
+    if(error) {
+      printf("FAIL: %s seed=%lu: %s (truth presses=%lu holds=%lu singles=%lu doubles=%lu, poll=%ums)\n",
+        name, seed, error, t.presses, t.holds, t.singles, t.doubles, c.poll());
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Return the next poll of a case: the next poll unless skipping polls,
+   * else the first poll at or after the next edge or wake time. The next
+   * wake time after each of the WAKE_TIMES is that after the oldest change
+   * not yet woken for it, as the changes are in order.
+   *
+   * @param c The case.
+   * @param next The next edge of the case.
+   * @param ms The poll just run.
+   * @param everyPoll True to run every poll.
+   *
+   * @return The milliseconds of the next poll.
+   */
+  static unsigned long nextPoll(const Case &c, uint8_t next, unsigned long ms, bool everyPoll) {
+    unsigned long due = next < c.count() ? c.edges()[next].millis : c.end();
+
+    if(everyPoll) return ms + c.poll();
+    for(uint8_t i = 0; i < WAKES; ++i) {
+      while(woken[i] < changed.size() && changed[woken[i]] + WAKE_TIMES[i] <= ms) ++woken[i];
+      if(woken[i] < changed.size() && changed[woken[i]] + WAKE_TIMES[i] < due) due = changed[woken[i]] + WAKE_TIMES[i];
+    }
+    return due <= ms ? ms + c.poll() : ms + (due - ms + c.poll() - 1) / c.poll() * c.poll();
+  }
+
+  static std::vector<unsigned long> changed; ///< Polls at which the buttons of the case being run changed, in order.
+  static size_t woken[]; ///< The first change not yet woken for each of the WAKE_TIMES.
+};
+template <typename Circuit, typename Debouncer, typename Clock> std::vector<unsigned long> Fuzzer<Circuit, Debouncer, Clock>::changed;
+template <typename Circuit, typename Debouncer, typename Clock> size_t Fuzzer<Circuit, Debouncer, Clock>::woken[WAKES];
+
+int main(int argc, char *argv[]) {
+  unsigned long cases = argc > 1 ? strtoul(argv[1], 0, 10) : 200000;
+  unsigned long seed = argc > 2 ? strtoul(argv[2], 0, 10) : 1;
+  unsigned long failures = 0;
+
+  clock_t start = clock();
+  for(unsigned long i = 0; i < cases && failures < 10; ++i, ++seed) {
+    for(bool everyPoll = false; ; everyPoll = true) {
+      bool ok;
+      switch(seed % 5) {
+        case 0: ok = Fuzzer<able::PullupResistorCircuit, able::TimerDebouncer>::run(seed, "pull-up timer", everyPoll); break;
+        case 1: ok = Fuzzer<able::PulldownResistorCircuit, able::TimerDebouncer>::run(seed, "pulldown timer", everyPoll); break;
+        case 2: ok = Fuzzer<able::PullupResistorCircuit, able::EagerDebouncer<>>::run(seed, "pull-up eager", everyPoll); break;
+        case 3: ok = Fuzzer<able::PullupResistorCircuit, able::TimerDebouncer, able::Millis16Clock>::run(seed, "pull-up timer 16-bit clock", everyPoll); break;
+        default: ok = Fuzzer<able::PulldownResistorCircuit, able::EagerDebouncer<>, able::MicrosClock>::run(seed, "pulldown eager micros clock", everyPoll); break;
+      }
+      if(!ok) ++failures;
+      if(everyPoll || i % 100 != i / 100 % 5) break; // Every hundredth case also runs every poll, each button type in turn.
+    }
+  }
+  double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  printf("%lu cases (4 buttons each) in %.2fs (%.0f cases/s)\n", cases, secs, secs > 0 ? cases / secs : 0.0);
+  printf("%s\n", failures ? "FAIL" : "PASS");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,210 @@
+/**
+ * @file DeferredDispatch.cpp Test of deferred callbacks. Generated taps,
+ * holds and double-clicks on four pins are handled by immediate and deferred
+ * callback buttons. The test fails unless:
+ *
+ * - dispatching every loop() gives the same events, in the same order and
+ *   with the same event times (the edge of pressed, released and click
+ *   events), as the immediate buttons;
+ * - the same holds with the buttons handled from a simulated timer ISR,
+ *   which interrupts dispatch() as it calls the callback functions;
+ * - dispatch(maxEvents) dispatches no more than maxEvents;
+ * - events dropped from a full queue are counted, so dispatched plus dropped
+ *   events equal those of the immediate buttons;
+ * - the timed callback gives a first press (before any release) no released
+ *   duration, and keeps timestamps of the clock of the button.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <vector>
+#include <AbleButtons.h>
+#include "Fixtures.h"
+
+using E = able::CallbackEvents;
+using Queue = able::DeferredCallback<8>; ///< Queue of the deferred buttons.
+using ImmediateButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<>>, able::TimedCallback<>>>;
+using DeferredButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<>>, Queue>>;
+using Immediate16Button = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::TimerDebouncer, able::Millis16Clock>>, able::TimedCallback<able::Millis16Clock>>>;
+
+const uint8_t BUTTONS = 4; ///< Buttons of each type.
+
+/**
+ * An event of a button.
+ */
+struct Event {
+  unsigned long millis; ///< When the event occurred.
+  uint8_t id; ///< The button.
+  uint8_t event; ///< The event.
+  bool operator!=(const Event &e) const { return millis != e.millis || id != e.id || event != e.event; } ///< Compare events.
+};
+
+std::vector<Event> immediateEvents; ///< Events of the immediate buttons.
+std::vector<Event> deferredEvents; ///< Events of the deferred buttons.
+host::Random rnd(777); ///< Pseudo-random sequence, so every run is the same.
+ImmediateButton *immediate[BUTTONS]; ///< The immediate buttons.
+DeferredButton *deferred[BUTTONS]; ///< The deferred buttons.
+unsigned long nextChange[BUTTONS]; ///< When each pin next changes.
+unsigned long tick; ///< Milliseconds run.
+unsigned long ticks; ///< Milliseconds to run.
+bool isrInDispatch; ///< True to run the timer ISR from the callback function of the deferred buttons.
+bool released[BUTTONS + 1]; ///< True once each immediate button has been released.
+unsigned long firstPresses; ///< Presses of the immediate buttons before their first release.
+unsigned long timedFirstPresses; ///< First presses given a released duration.
+
+void onImmediate(E::CALLBACK_EVENT event, uint8_t id, const able::EventTiming &timing) {
+  bool edge = event != E::BEGIN_EVENT && event != E::HELD_EVENT && event != E::IDLE_EVENT;
+  if(event == E::RELEASED_EVENT) released[id] = true;
+  if(event == E::PRESSED_EVENT && !released[id]) {
+    ++firstPresses;
+    if(timing.duration || timing.interval) ++timedFirstPresses;
+  }
+  immediateEvents.push_back(Event{edge ? timing.millis : millis(), id, (uint8_t) event});
+}
+
+bool isr();
+
+void onDeferred(E::CALLBACK_EVENT event, uint8_t id) {
+  deferredEvents.push_back(Event{Queue::eventTime(), (uint8_t)(id - BUTTONS), (uint8_t) event});
+  if(isrInDispatch && rnd.next(2)) isr(); // Interrupt dispatch().
+}
+
+/**
+ * Run the next millisecond of generated signals, handling the buttons, as a
+ * timer ISR would.
+ *
+ * @return True if run, false once all the milliseconds are run.
+ */
+bool isr() {
+  if(tick == ticks) return false;
+  host::setMillis(1000 + ++tick);
+  for(uint8_t b = 0; b < BUTTONS; ++b) {
+    if(millis() >= nextChange[b]) {
+      uint8_t level = !digitalRead(2 + b);
+      host::setPin(2 + b, level);
+      host::setPin(2 + BUTTONS + b, level);
+      nextChange[b] = millis() + (level == LOW ? 60 + rnd.next(rnd.next(4) ? 150 : 1500) : 60 + rnd.next(rnd.next(3) ? 150 : 2000));
+    }
+    immediate[b]->handle();
+    deferred[b]->handle();
+  }
+  return true;
+}
+
+/**
+ * Run the buttons on generated signals for a time.
+ *
+ * @param ms How long to run (ms).
+ * @param dispatchEvery Call dispatch() every this many milliseconds.
+ * @param maxEvents The maximum events to dispatch each time.
+ * @param fromIsr True to also run the timer ISR as dispatch() calls the
+ *                callback functions.
+ *
+ * @return True if dispatch() never dispatched more than maxEvents.
+ */
+bool run(unsigned long ms, unsigned long dispatchEvery, uint8_t maxEvents, bool fromIsr = false) {
+  bool ok = true;
+
+  tick = 0;
+  ticks = ms;
+  isrInDispatch = fromIsr;
+  immediateEvents.clear();
+  deferredEvents.clear();
+  for(uint8_t b = 0; b <= BUTTONS; ++b) released[b] = false;
+  host::setMillis(1000);
+  for(uint8_t b = 0; b < BUTTONS; ++b) {
+    host::setPin(2 + b, HIGH);
+    host::setPin(2 + BUTTONS + b, HIGH);
+    immediate[b] = new ImmediateButton(2 + b, onImmediate, 1 + b);
+    deferred[b] = new DeferredButton(2 + BUTTONS + b, onDeferred, 1 + BUTTONS + b);
+    immediate[b]->begin();
+    deferred[b]->begin();
+    nextChange[b] = 1000 + rnd.next(500);
+  }
+
+  while(isr()) {
+    if(tick % dispatchEvery == 0 && Queue::dispatch(maxEvents) > maxEvents) ok = false;
+  }
+  isrInDispatch = false;
+  while(Queue::dispatch(maxEvents)) {}
+
+  for(uint8_t b = 0; b < BUTTONS; ++b) {
+    delete immediate[b];
+    delete deferred[b];
+  }
+  return ok;
+}
+
+/**
+ * Compare the events of the immediate and deferred buttons.
+ *
+ * @return True if the same, else false.
+ */
+bool sameEvents() {
+  for(size_t i = 0; i < immediateEvents.size() && i < deferredEvents.size(); ++i) {
+    if(immediateEvents[i] != deferredEvents[i]) {
+      printf("FAIL: event %zu immediate %lu %u %u, deferred %lu %u %u\n", i,
+        immediateEvents[i].millis, immediateEvents[i].id, immediateEvents[i].event,
+        deferredEvents[i].millis, deferredEvents[i].id, deferredEvents[i].event);
+      return false;
+    }
+  }
+  return immediateEvents.size() == deferredEvents.size();
+}
+
+int main() {
+  bool ok = true;
+
+  // Dispatch every loop(), so the queue never overflows.
+  if(!run(60000, 1, 255)) {
+    printf("FAIL: dispatched more than maxEvents\n");
+    ok = false;
+  }
+  printf("every loop: immediate=%zu deferred=%zu overflows=%u\n", immediateEvents.size(), deferredEvents.size(), Queue::overflows());
+  if(Queue::overflows() || !sameEvents()) {
+    printf("FAIL: deferred events differ from immediate events\n");
+    ok = false;
+  }
+
+  // Handle the buttons from the ISR, interrupting dispatch().
+  if(!run(60000, 1, 255, true)) {
+    printf("FAIL: dispatched more than maxEvents\n");
+    ok = false;
+  }
+  printf("from ISR: immediate=%zu deferred=%zu overflows=%u\n", immediateEvents.size(), deferredEvents.size(), Queue::overflows());
+  if(Queue::overflows() || !sameEvents()) {
+    printf("FAIL: deferred events differ from immediate events when handled from an ISR\n");
+    ok = false;
+  }
+
+  // Dispatch two events every 500ms, so the queue overflows.
+  Queue::resetOverflows();
+  if(!run(60000, 500, 2)) {
+    printf("FAIL: dispatched more than maxEvents\n");
+    ok = false;
+  }
+  printf("slow dispatch: immediate=%zu deferred=%zu overflows=%u\n", immediateEvents.size(), deferredEvents.size(), Queue::overflows());
+  if(!Queue::overflows() || deferredEvents.size() + Queue::overflows() != immediateEvents.size()) {
+    printf("FAIL: dropped events not counted\n");
+    ok = false;
+  }
+  if(Queue::pending()) {
+    printf("FAIL: events left in the queue\n");
+    ok = false;
+  }
+
+  // The first press of each run has no released duration, and a 16-bit clock
+  // keeps smaller timestamps.
+  printf("timed callback: first presses=%lu timed=%lu button bytes=%zu 16-bit clock=%zu\n",
+    firstPresses, timedFirstPresses, sizeof(ImmediateButton), sizeof(Immediate16Button));
+  if(firstPresses != 3 * BUTTONS || timedFirstPresses) {
+    printf("FAIL: first presses given a released duration\n");
+    ok = false;
+  }
+  if(sizeof(Immediate16Button) >= sizeof(ImmediateButton)) {
+    printf("FAIL: timed callback timestamps not of the clock of the button\n");
+    ok = false;
+  }
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
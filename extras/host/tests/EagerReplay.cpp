@@ -0,0 +1,173 @@
+/**
+ * @file EagerReplay.cpp Replay test comparing the latency of the default
+ * TimerDebouncer with the leading-edge EagerDebouncer. A generated signal of
+ * bouncing taps, holds and double-clicks is replayed into buttons using each
+ * debouncer, sampled every millisecond as from a busy loop(). The test fails
+ * if the eager buttons do not report exactly the same events as the timer
+ * button, or do not report presses (and releases if eager) on the sample
+ * after the first edge.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <AbleButtons.h>
+#include "Fixtures.h"
+
+using TimerButton = AblePullupCallbackDoubleClickerButton;
+using EagerPressButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::EagerDebouncer<true, false>>>>>;
+using EagerButton = AblePullupEagerCallbackDoubleClickerButton;
+
+//
+// Replayed signal...
+//
+
+const uint8_t BUTTONS = 3; ///< Buttons replaying the signal (one per debouncer).
+const uint8_t PINS[BUTTONS] = {2, 3, 4}; ///< Pins of the buttons.
+const char *NAMES[BUTTONS] = {"timer", "eager-press", "eager"}; ///< Names of the debouncers.
+const unsigned long GESTURES = 2000; ///< Number of gestures to replay.
+
+host::Random rnd(12345); ///< Pseudo-random sequence, so every run is the same.
+unsigned long edgeMillis = 0; ///< When the signal last changed (excluding bounce).
+
+//
+// Event statistics...
+//
+
+/**
+ * Statistics of the events of each button.
+ */
+struct Stats {
+  unsigned long events[7]; ///< Count of each CALLBACK_EVENT.
+  unsigned long pressTotal; ///< Total press latency (ms).
+  unsigned long pressMax; ///< Maximum press latency (ms).
+  unsigned long releaseTotal; ///< Total release latency (ms).
+  unsigned long releaseMax; ///< Maximum release latency (ms).
+} stats[BUTTONS + 1]; ///< Statistics by button id (1-3).
+
+/**
+ * Callback recording each event and the latency of presses and releases.
+ *
+ * @param event The event that occurred.
+ * @param id The identifier of the button.
+ */
+void onEvent(able::CallbackEvents::CALLBACK_EVENT event, uint8_t id) {
+  Stats &s = stats[id];
+  unsigned long latency = millis() - edgeMillis;
+
+  ++s.events[event];
+  if(event == able::CallbackEvents::PRESSED_EVENT) {
+    s.pressTotal += latency;
+    if(latency > s.pressMax) s.pressMax = latency;
+  } else if(event == able::CallbackEvents::RELEASED_EVENT) {
+    s.releaseTotal += latency;
+    if(latency > s.releaseMax) s.releaseMax = latency;
+  }
+}
+
+TimerButton timerBtn(PINS[0], onEvent);
+EagerPressButton eagerPressBtn(PINS[1], onEvent);
+EagerButton eagerBtn(PINS[2], onEvent);
+
+/**
+ * Advance the clock by a millisecond and handle all buttons.
+ */
+void tick() {
+  host::setMillis(millis() + 1);
+  timerBtn.handle();
+  eagerPressBtn.handle();
+  eagerBtn.handle();
+}
+
+/**
+ * Change the signal to a level, bouncing for up to 5ms before it settles.
+ * Bounce only occurs after the first edge, as with a real switch.
+ *
+ * @param level The level to change to.
+ */
+void change(uint8_t level) {
+  unsigned long bounces = rnd.next(7);
+
+  edgeMillis = millis() + 1;
+  for(unsigned long i = 0; i <= bounces; ++i) {
+    uint8_t l = (i % 2) ? !level : level;
+    for(uint8_t p = 0; p < BUTTONS; ++p) host::setPin(PINS[p], l);
+    for(unsigned long t = 1 + rnd.next(i < bounces ? 2 : 1); t; --t) tick();
+  }
+  for(uint8_t p = 0; p < BUTTONS; ++p) host::setPin(PINS[p], level);
+}
+
+/**
+ * Keep the signal steady for a number of milliseconds.
+ *
+ * @param ms The number of milliseconds.
+ */
+void wait(unsigned long ms) {
+  while(ms--) tick();
+}
+
+int main() {
+  for(uint8_t p = 0; p < BUTTONS; ++p) host::setPin(PINS[p], HIGH);
+  host::setMillis(1000);
+  timerBtn.begin();
+  eagerPressBtn.begin();
+  eagerBtn.begin();
+  wait(100);
+
+  // Replay taps, holds and double-clicks with random gaps between them.
+  for(unsigned long g = 0; g < GESTURES; ++g) {
+    switch(rnd.next(3)) {
+      case 0: // Tap.
+        change(LOW); wait(60 + rnd.next(150));
+        change(HIGH);
+        break;
+
+      case 1: // Hold.
+        change(LOW); wait(1000 + rnd.next(1000));
+        change(HIGH);
+        break;
+
+      default: // Double-click.
+        change(LOW); wait(60 + rnd.next(40));
+        change(HIGH); wait(60 + rnd.next(40));
+        change(LOW); wait(60 + rnd.next(40));
+        change(HIGH);
+        break;
+    }
+    wait(rnd.next(100) ? 400 + rnd.next(1600) : 61000);
+  }
+
+  bool ok = true;
+  printf("%-12s %8s %8s %8s %8s %8s %8s %8s %8s %8s\n", "debouncer", "pressed", "released", "held", "idle", "clicked", "double", "press ms", "max", "rel ms");
+  for(uint8_t id = 1; id <= BUTTONS; ++id) {
+    Stats &s = stats[id];
+    unsigned long presses = s.events[able::CallbackEvents::PRESSED_EVENT];
+    unsigned long releases = s.events[able::CallbackEvents::RELEASED_EVENT];
+
+    printf("%-12s %8lu %8lu %8lu %8lu %8lu %8lu %8.1f %8lu %8.1f\n", NAMES[id - 1],
+      presses, releases,
+      s.events[able::CallbackEvents::HELD_EVENT], s.events[able::CallbackEvents::IDLE_EVENT],
+      s.events[able::CallbackEvents::SINGLE_CLICKED_EVENT], s.events[able::CallbackEvents::DOUBLE_CLICKED_EVENT],
+      presses ? (double)s.pressTotal / presses : 0.0, s.pressMax,
+      releases ? (double)s.releaseTotal / releases : 0.0);
+
+    // Eager debouncers must report the same events as the timer.
+    for(uint8_t e = 0; e < 7; ++e) {
+      if(s.events[e] != stats[1].events[e]) {
+        printf("FAIL: %s reported %lu of event %u, timer reported %lu\n", NAMES[id - 1], s.events[e], e, stats[1].events[e]);
+        ok = false;
+      }
+    }
+  }
+
+  // Eager edges must be reported on the first sample after the edge.
+  if(stats[2].pressMax > 1 || stats[3].pressMax > 1 || stats[3].releaseMax > 1) {
+    printf("FAIL: eager edges were delayed\n");
+    ok = false;
+  }
+  if(stats[1].pressTotal <= stats[2].pressTotal || stats[2].releaseTotal <= stats[3].releaseTotal) {
+    printf("FAIL: eager edges were not faster\n");
+    ok = false;
+  }
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
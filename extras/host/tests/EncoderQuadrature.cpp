@@ -0,0 +1,188 @@
+/**
+ * @file EncoderQuadrature.cpp Test of rotary encoders. Generated turns, with
+ * contact bounce on every edge, are read by one encoder polled every
+ * millisecond and one read by an ISR. The test fails unless:
+ *
+ * - both encoders count every detent turned, in both directions, and no
+ *   more (bounce is never counted as a step);
+ * - the velocity matches the speed turned, is negative turning back, and
+ *   falls when the encoder stops;
+ * - steps turned faster than the acceleration velocity are multiplied;
+ * - the push switches click as buttons when handled in a button list, and
+ *   call the callback function of a callback encoder.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <stdlib.h>
+#include <AbleButtons.h>
+#include "Fixtures.h"
+
+using E = able::CallbackEvents;
+using Encoder = AblePullupEncoder;
+using EncoderList = AblePullupEncoderList;
+
+host::Random rnd(2718); ///< Pseudo-random sequence, so every run is the same.
+Encoder *polled = 0; ///< Encoder handled every millisecond while turning.
+Encoder *interrupted = 0; ///< Encoder read by an ISR.
+unsigned long switchEvents[E::DOUBLE_CLICKED_EVENT + 1]; ///< Events of the callback encoder.
+
+void onEvent(E::CALLBACK_EVENT event, uint8_t /* id */) {
+  ++switchEvents[event];
+}
+
+void onInterrupt() {
+  interrupted->update();
+}
+
+/**
+ * Advance the clock, handling the polled encoder at each millisecond.
+ *
+ * @param us The microseconds to advance.
+ */
+void advance(unsigned long us) {
+  for(unsigned long end = micros() + us; micros() < end;) {
+    unsigned long next = (millis() + 1) * 1000;
+    host::setMicros(next < end ? next : end);
+    if(micros() == next && polled) polled->handle();
+  }
+}
+
+/**
+ * Set the A and B pins of both encoders (pins 2-3 and 5-6). A pin is active
+ * (LOW with pull-up resistors) when its bit is set.
+ *
+ * @param ab A in bit 1 and B in bit 0.
+ */
+void setPins(uint8_t ab) {
+  host::setPin(2, ab & 2 ? LOW : HIGH);
+  host::setPin(5, ab & 2 ? LOW : HIGH);
+  host::setPin(3, ab & 1 ? LOW : HIGH);
+  host::setPin(6, ab & 1 ? LOW : HIGH);
+}
+
+/**
+ * Turn the encoders one detent, bouncing the contact at each edge.
+ *
+ * @param direction +1 to turn forward, -1 back.
+ * @param detentMicros The time to turn one detent (us).
+ */
+void turn(int direction, unsigned long detentMicros) {
+  static const uint8_t SEQUENCE[] = {0, 1, 3, 2}; // Forward order of readings.
+  static uint8_t phase = 0;
+  unsigned long quarter = detentMicros / 4;
+
+  for(uint8_t q = 0; q < 4; ++q) {
+    uint8_t from = SEQUENCE[phase];
+    phase = (phase + direction) & 3;
+    uint8_t to = SEQUENCE[phase];
+    unsigned long bounce = quarter / 3, spent = 0;
+    for(uint8_t b = rnd.next(4); b > 0; --b) { // Bounce between the readings.
+      unsigned long t = 1 + rnd.next(bounce / 4 + 1);
+      setPins(to);
+      advance(t);
+      setPins(from);
+      advance(t);
+      spent += 2 * t;
+    }
+    setPins(to);
+    advance(quarter - spent);
+  }
+}
+
+int main() {
+  bool ok = true;
+  Encoder enc1(2, 3, 4), enc2(5, 6, 7);
+  Encoder *encoders[] = {&enc1, &enc2};
+  EncoderList list(encoders);
+
+  host::setMillis(1000);
+  for(uint8_t pin = 2; pin < 8; ++pin) host::setPin(pin, HIGH);
+  polled = &enc1;
+  interrupted = &enc2;
+  enc1.begin();
+  enc2.beginInterrupts(onInterrupt);
+
+  // Random turns at random speeds (the polled encoder needs 2 readings
+  // per quarter-step, so at most 125 detents/s).
+  long expected = 0, steps1 = 0, steps2 = 0;
+  for(int run = 0; run < 2000; ++run) {
+    int direction = rnd.next(2) ? 1 : -1;
+    unsigned long detentMicros = 8000 + rnd.next(100000);
+    for(unsigned long n = 1 + rnd.next(20); n > 0; --n) {
+      turn(direction, detentMicros);
+      expected += direction;
+    }
+    steps1 += enc1.readSteps();
+    steps2 += enc2.readSteps();
+    advance(rnd.next(500000));
+  }
+  printf("turned=%ld polled=%ld/%ld interrupted=%ld/%ld\n", expected, enc1.position(), steps1, enc2.position(), steps2);
+  if(enc1.position() != expected || steps1 != expected || enc2.position() != expected || steps2 != expected) {
+    printf("FAIL: steps miscounted\n");
+    ok = false;
+  }
+
+  // Velocity turning at 50 detents/s, back at 20 detents/s, then stopped.
+  for(int n = 0; n < 10; ++n) turn(1, 20000);
+  long forward = enc2.velocity();
+  turn(-1, 50000);
+  long reversed = enc2.velocity();
+  for(int n = 0; n < 10; ++n) turn(-1, 50000);
+  long back = enc2.velocity();
+  advance(1000000);
+  long stopped = enc2.velocity();
+  printf("velocity: forward=%ld reversed=%ld back=%ld stopped=%ld\n", forward, reversed, back, stopped);
+  if(forward < 45 || forward > 55 || reversed != 0 || back > -18 || back < -22 || stopped < -1 || stopped > 0) {
+    printf("FAIL: velocity wrong\n");
+    ok = false;
+  }
+
+  // Acceleration: 1 more step per 20 detents/s, up to 3 steps.
+  Encoder::setAcceleration(20, 3);
+  enc2.readSteps();
+  for(int n = 0; n < 10; ++n) turn(1, 200000); // 5 detents/s.
+  int16_t slow = enc2.readSteps();
+  for(int n = 0; n < 10; ++n) turn(1, 40000); // 25 detents/s.
+  int16_t medium = enc2.readSteps();
+  for(int n = 0; n < 10; ++n) turn(1, 10000); // 100 detents/s.
+  int16_t fast = enc2.readSteps();
+  Encoder::setAcceleration(0);
+  printf("accelerated steps: slow=%d medium=%d fast=%d\n", slow, medium, fast);
+  if(slow != 10 || medium < 19 || medium > 20 || fast < 29 || fast > 30) { // The first step of each speed is timed from the last of the previous one.
+    printf("FAIL: acceleration wrong\n");
+    ok = false;
+  }
+
+  // Push switches handled in the list.
+  polled = 0;
+  host::setPin(7, LOW);
+  for(int t = 0; t < 100; ++t) { advance(1000); list.handle(); }
+  bool pressed = list.anyPressed() && enc2.isPressed() && !enc1.isPressed();
+  host::setPin(7, HIGH);
+  for(int t = 0; t < 100; ++t) { advance(1000); list.handle(); }
+  bool clicked = enc2.resetClicked() && !enc1.resetClicked();
+  printf("switch: pressed=%d clicked=%d\n", pressed, clicked);
+  if(!pressed || !clicked) {
+    printf("FAIL: switch not handled as a button\n");
+    ok = false;
+  }
+
+  // Callback encoder switch.
+  AblePullupCallbackEncoder enc3(8, 9, 10, onEvent, 3);
+  host::setPin(8, HIGH);
+  host::setPin(9, HIGH);
+  host::setPin(10, HIGH);
+  enc3.begin();
+  host::setPin(10, LOW);
+  for(int t = 0; t < 100; ++t) { advance(1000); enc3.handle(); }
+  host::setPin(10, HIGH);
+  for(int t = 0; t < 100; ++t) { advance(1000); enc3.handle(); }
+  printf("callback switch: pressed=%lu released=%lu\n", switchEvents[E::PRESSED_EVENT], switchEvents[E::RELEASED_EVENT]);
+  if(switchEvents[E::PRESSED_EVENT] != 1 || switchEvents[E::RELEASED_EVENT] != 1) {
+    printf("FAIL: callback switch events wrong\n");
+    ok = false;
+  }
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
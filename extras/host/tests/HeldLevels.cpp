@@ -0,0 +1,142 @@
+/**
+ * @file HeldLevels.cpp Test of held-levels buttons. Generated taps and holds
+ * of up to 12s are pressed on a callback button and on held-levels buttons
+ * with held times of 1s, 3s and 10s, in a list and with double-clicks. The
+ * test fails unless:
+ *
+ * - each held-levels button gives the same events, at the same times, as the
+ *   callback button, plus a held event when held for 3s and for 10s;
+ * - the callback function reads held levels 1, 2 and 3 in turn;
+ * - a released held-levels button reads the clock no more often than the
+ *   callback button.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <vector>
+#include <AbleButtons.h>
+#include "Fixtures.h"
+
+using E = able::CallbackEvents;
+
+using CountingClock = host::CountingClock<>; ///< Clock counting how often it is read.
+
+using Plain = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DebouncedPin<able::NoCounters, able::TimerDebouncer, CountingClock>>>;
+using Levels = able::HeldLevelsButton<Plain, 3>;
+using Clicker = able::HeldLevelsButton<AblePullupCallbackDoubleClickerButton, 3>;
+
+const unsigned long RUN_MILLIS = 600000; ///< How long to run (ms).
+
+/**
+ * An event of a button.
+ */
+struct Event {
+  unsigned long millis; ///< When the event occurred.
+  uint8_t event; ///< The event.
+  uint8_t level; ///< The held level of a held event, else 0.
+  bool operator!=(const Event &e) const { return millis != e.millis || event != e.event || level != e.level; } ///< Compare events.
+};
+
+std::vector<Event> events[3]; ///< Events of the callback, held-levels and clicker held-levels buttons.
+Levels *levels; ///< The held-levels button.
+Clicker *clicker; ///< The clicker held-levels button.
+host::Random rnd(2010); ///< Pseudo-random sequence, so every run is the same.
+
+void onPlain(E::CALLBACK_EVENT event, able::ButtonId) {
+  events[0].push_back(Event{millis(), (uint8_t) event, 0});
+}
+
+void onLevels(E::CALLBACK_EVENT event, able::ButtonId) {
+  events[1].push_back(Event{millis(), (uint8_t) event, levels->heldLevel()});
+}
+
+void onClicker(E::CALLBACK_EVENT event, able::ButtonId) {
+  if(event != E::SINGLE_CLICKED_EVENT && event != E::DOUBLE_CLICKED_EVENT) {
+    events[2].push_back(Event{millis(), (uint8_t) event, clicker->heldLevel()});
+  }
+}
+
+int main() {
+  bool ok = true;
+  bool pressed = false;
+  unsigned long nextChange = 2000;
+  std::vector<Event> expected;
+
+  host::setMillis(1000);
+  Plain::setIdleTime(5000);
+  Clicker::setIdleTime(5000);
+  Levels::setHeldTime(1, 1000);
+  Levels::setHeldTime(2, 3000);
+  Levels::setHeldTime(3, 10000);
+  Clicker::setHeldTime(2, 3000);
+  Clicker::setHeldTime(3, 10000);
+  for(uint8_t pin = 2; pin < 5; ++pin) host::setPin(pin, HIGH);
+  Plain plain(2, onPlain);
+  levels = new Levels(3, onLevels);
+  clicker = new Clicker(4, onClicker);
+  Levels *btns[] = {levels};
+  able::ButtonList<Levels> btnList(btns);
+  plain.begin();
+  btnList.begin();
+  clicker->begin();
+
+  unsigned long plainReads = 0, levelsReads = 0;
+  for(unsigned long t = 1; t <= RUN_MILLIS; ++t) {
+    host::setMillis(1000 + t);
+    if(millis() >= nextChange) {
+      pressed = !pressed;
+      nextChange = millis() + (pressed ? 60 + rnd.next(rnd.next(3) ? 2000 : 12000) : 60 + rnd.next(rnd.next(3) ? 300 : 8000));
+    }
+    for(uint8_t pin = 2; pin < 5; ++pin) host::setPin(pin, pressed ? LOW : HIGH);
+
+    bool released = !levels->isPressed();
+    CountingClock::reads = 0;
+    plain.handle();
+    if(released) plainReads += CountingClock::reads;
+    CountingClock::reads = 0;
+    btnList.handle();
+    if(released) levelsReads += CountingClock::reads;
+    clicker->handle();
+  }
+
+  // The plain events with held levels, plus the held events of levels 2 and 3.
+  for(size_t i = 0; i < events[0].size(); ++i) {
+    Event e = events[0][i];
+    if(e.event != E::HELD_EVENT) {
+      expected.push_back(e);
+      continue;
+    }
+    unsigned long released = i + 1 < events[0].size() ? events[0][i + 1].millis : 1000 + RUN_MILLIS + 1;
+    unsigned long held = e.millis - 1000; // When the button was pressed (debounced).
+    e.level = 1;
+    expected.push_back(e);
+    if(held + 3000 < released) expected.push_back(Event{held + 3000, E::HELD_EVENT, 2});
+    if(held + 10000 < released) expected.push_back(Event{held + 10000, E::HELD_EVENT, 3});
+  }
+
+  size_t level3 = 0;
+  for(size_t i = 0; i < expected.size(); ++i) level3 += expected[i].level == 3;
+  for(uint8_t b = 1; b < 3; ++b) {
+    bool same = expected.size() == events[b].size();
+    for(size_t i = 0; same && i < expected.size(); ++i) {
+      if(expected[i] != events[b][i]) {
+        printf("FAIL: event %zu expected %lu %u %u, got %lu %u %u\n", i, expected[i].millis, expected[i].event, expected[i].level,
+          events[b][i].millis, events[b][i].event, events[b][i].level);
+        same = false;
+      }
+    }
+    printf("button %u: events=%zu expected=%zu (level 3=%zu)\n", b, events[b].size(), expected.size(), level3);
+    if(!same || level3 < 5) {
+      printf("FAIL: held-levels button %u events wrong\n", b);
+      ok = false;
+    }
+  }
+
+  printf("clock reads while released: plain=%lu levels=%lu\n", plainReads, levelsReads);
+  if(levelsReads > plainReads) {
+    printf("FAIL: released held-levels button reads the clock more than a callback button\n");
+    ok = false;
+  }
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
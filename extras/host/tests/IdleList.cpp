@@ -0,0 +1,120 @@
+/**
+ * @file IdleList.cpp Test of the idle button list. Generated taps and holds,
+ * with quiet spells, are pressed on an idle list of callback buttons sending
+ * only held events, and on a list of buttons with the same idle time. The
+ * test fails unless:
+ *
+ * - the idle list is idle while all the buttons of the other list are, give
+ *   or take the debounce time (the list times debounced changes, the
+ *   buttons time from the first edge);
+ * - the idle list calls its callback function once each time it becomes
+ *   idle, with its id;
+ * - the idle list reads the clock less than a list of buttons checking their
+ *   own idle times.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <AbleButtons.h>
+#include "Fixtures.h"
+
+using E = able::CallbackEvents;
+
+using CountingClock = host::CountingClock<>; ///< Clock counting how often it is read.
+
+using Pin = able::DebouncedPin<able::NoCounters, able::TimerDebouncer, CountingClock>;
+using HeldButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, Pin>, able::UntimedCallback, E::HELD_EVENTS>;
+using TimedButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, Pin>>;
+
+const uint8_t BUTTONS = 8; ///< Buttons in each list.
+const unsigned long IDLE_TIME = 5000; ///< Idle time of the lists (ms).
+const unsigned long RUN_MILLIS = 600000; ///< How long to run (ms).
+const able::ButtonId LIST_ID = 77; ///< Id of the idle list.
+
+host::Random rnd(1066); ///< Pseudo-random sequence, so every run is the same.
+unsigned long idleEvents = 0; ///< IDLE_EVENTs of the idle list.
+unsigned long wrongEvents = 0; ///< Other events or ids of the idle list.
+
+void onIdle(E::CALLBACK_EVENT event, able::ButtonId id) {
+  if(event == E::IDLE_EVENT && id == LIST_ID) ++idleEvents;
+  else ++wrongEvents;
+}
+
+int main() {
+  bool ok = true;
+  HeldButton *held[BUTTONS];
+  TimedButton *timed[BUTTONS];
+  bool pressed[BUTTONS] = {};
+  unsigned long nextChange[BUTTONS];
+  unsigned long checks = 0, mismatches = 0, idleStarts = 0, allIdleSince = 0, busySince = 0, maxLag = 0;
+  unsigned long idleReads = 0, timedReads = 0;
+  bool wasIdle = false;
+
+  host::setMillis(1000);
+  Pin::setIdleTime(IDLE_TIME);
+  for(uint8_t b = 0; b < BUTTONS; ++b) {
+    host::setPin(2 + b, HIGH);
+    host::setPin(12 + b, HIGH);
+    held[b] = new HeldButton(2 + b);
+    timed[b] = new TimedButton(12 + b);
+    nextChange[b] = 1000 + rnd.next(500);
+  }
+  able::IdleButtonList<HeldButton> idleList(held, BUTTONS, onIdle, LIST_ID);
+  able::ButtonList<TimedButton> timedList(timed, BUTTONS);
+  idleList.setIdleTime(IDLE_TIME);
+  idleList.begin();
+  timedList.begin();
+
+  for(unsigned long t = 1; t <= RUN_MILLIS; ++t) {
+    host::setMillis(1000 + t);
+    bool quiet = t % 30000 >= 20000; // Released buttons stay released, so the lists become idle.
+    for(uint8_t b = 0; b < BUTTONS; ++b) {
+      if(millis() >= nextChange[b] && !(quiet && !pressed[b])) {
+        pressed[b] = !pressed[b];
+        nextChange[b] = millis() + (pressed[b] ? 60 + rnd.next(rnd.next(4) ? 150 : 1500) : 60 + rnd.next(rnd.next(3) ? 500 : 8000));
+      }
+      host::setPin(2 + b, pressed[b] ? LOW : HIGH);
+      host::setPin(12 + b, pressed[b] ? LOW : HIGH);
+    }
+
+    CountingClock::reads = 0;
+    idleList.handle();
+    bool idle = idleList.isIdle();
+    idleReads += CountingClock::reads;
+    CountingClock::reads = 0;
+    timedList.handle();
+    bool allIdle = timedList.allIdle();
+    timedReads += CountingClock::reads;
+
+    if(allIdle && !allIdleSince) allIdleSince = millis();
+    if(!allIdle) allIdleSince = 0;
+    if(!allIdle && !busySince) busySince = millis();
+    if(allIdle) busySince = 0;
+    if(idle && !wasIdle) {
+      ++idleStarts;
+      if(allIdleSince && millis() - allIdleSince > maxLag) maxLag = millis() - allIdleSince;
+    }
+    wasIdle = idle;
+    ++checks;
+    if(((idle && busySince && millis() - busySince > Pin::debounceTime()) || (!idle && allIdleSince && millis() - allIdleSince > Pin::debounceTime())) && mismatches++ < 5) {
+      printf("FAIL: at %lu idle list idle=%d, buttons idle=%d since %lu\n", millis(), idle, allIdle, allIdleSince);
+    }
+  }
+
+  printf("checks=%lu mismatches=%lu idle starts=%lu events=%lu wrong=%lu max lag=%lums\n", checks, mismatches, idleStarts, idleEvents, wrongEvents, maxLag);
+  if(mismatches || idleStarts < 10) {
+    printf("FAIL: idle list idle when the buttons are not\n");
+    ok = false;
+  }
+  if(idleEvents != idleStarts || wrongEvents) {
+    printf("FAIL: idle list events wrong\n");
+    ok = false;
+  }
+  printf("clock reads: idle list=%lu list=%lu\n", idleReads, timedReads);
+  if(idleReads >= timedReads) {
+    printf("FAIL: idle list reads the clock as often as the list\n");
+    ok = false;
+  }
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,221 @@
+/**
+ * @file IsrList.cpp Test of the ISR button list. Generated taps, holds and
+ * double-clicks are pressed on an ISR list and on a plain list of
+ * double-clicker buttons, each handled by a simulated timer ISR every
+ * millisecond. The ISR interrupts reads of the lists part way through, at a
+ * random clock reading of the read. The test fails unless:
+ *
+ * - snapshots, button states and queries of the ISR list always match those
+ *   read before or after the ISR, so are never torn by it;
+ * - the snapshot the ISR list publishes matches a snapshot of the plain list
+ *   read at the same time, including after resets;
+ * - the same reads of the plain list are sometimes torn (so the test can
+ *   tell);
+ * - resetting clicks of the ISR list clears them.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <AbleButtons.h>
+#include "Fixtures.h"
+
+/**
+ * Clock running a pending ISR at a chosen reading, as if it interrupted the
+ * code reading the clock.
+ */
+class IsrClock: public able::MillisClock {
+  public:
+    static void (*isr)(); ///< The pending ISR (0 if none).
+    static unsigned long countdown; ///< Readings of the clock before the ISR runs.
+
+    /**
+     * Return the time now, first running the pending ISR if due.
+     *
+     * @return The milliseconds since the Arduino started.
+     */
+    static inline Time now() {
+      if(isr && --countdown == 0) {
+        void (*fn)() = isr;
+        isr = 0;
+        fn();
+      }
+      return millis();
+    }
+};
+void (*IsrClock::isr)() = 0;
+unsigned long IsrClock::countdown = 0;
+
+using Button = able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::TimerDebouncer, IsrClock>>;
+using S = able::ButtonStates;
+
+const uint8_t BUTTONS = 16; ///< Buttons in each list.
+const unsigned long RUN_MILLIS = 200000; ///< How long to run (ms).
+
+able::IsrButtonList<Button> *isrList; ///< The ISR list.
+able::ButtonList<Button> *plainList; ///< The plain list.
+host::Random rnd(1492); ///< Pseudo-random sequence, so every run is the same.
+
+void isrHandle() { isrList->handle(); } ///< The timer ISR of the ISR list.
+void plainHandle() { plainList->handle(); } ///< The timer ISR of the plain list.
+
+/**
+ * Make an ISR pending, to interrupt a read at a random clock reading (or
+ * run after the read, if it reads the clock less).
+ *
+ * @param isr The ISR.
+ */
+void interruptAt(void (*isr)()) {
+  IsrClock::isr = isr;
+  IsrClock::countdown = 1 + rnd.next(BUTTONS);
+}
+
+/**
+ * Run the pending ISR, if the read did not.
+ */
+void finishIsr() {
+  if(IsrClock::isr) {
+    void (*fn)() = IsrClock::isr;
+    IsrClock::isr = 0;
+    fn();
+  }
+}
+
+/**
+ * Return one of the any and all queries of a list. Each query is read
+ * consistently; use a snapshot to read several at once.
+ *
+ * @param list The list to query.
+ * @param query The query (0-5).
+ *
+ * @return The result of the query.
+ */
+template <typename List>
+bool query(const List &list, uint8_t query) {
+  switch(query) {
+    case 0: return list.allIdle();
+    case 1: return list.anyHeld();
+    case 2: return list.anySingleClicked();
+    case 3: return list.allPressed();
+    case 4: return list.anyIdle();
+    default: return list.anyDoubleClicked();
+  }
+}
+
+/**
+ * Compare the states of two snapshots.
+ *
+ * @param a, b The snapshots.
+ *
+ * @return True if the same, else false.
+ */
+bool operator==(const S &a, const S &b) {
+  return a.pressed == b.pressed && a.held == b.held && a.idle == b.idle && a.clicked == b.clicked
+    && a.singleClicked == b.singleClicked && a.doubleClicked == b.doubleClicked && a.any == b.any && a.all == b.all;
+}
+
+/**
+ * Read a list as its ISR interrupts, and check the read gives what the list
+ * reads either before or after the ISR, rather than a mix of the two.
+ *
+ * @param isr The ISR of the list.
+ * @param read The read of the list.
+ *
+ * @return True if the read is not torn, else false.
+ */
+template <typename T, typename Read>
+bool untorn(void (*isr)(), Read read) {
+  T before = read();
+  interruptAt(isr);
+  T during = read();
+  finishIsr();
+  T after = read();
+  return during == before || during == after;
+}
+
+int main() {
+  bool ok = true;
+  Button *isrButtons[BUTTONS], *plainButtons[BUTTONS];
+  bool pressed[BUTTONS] = {};
+  unsigned long nextChange[BUTTONS], lastChange[BUTTONS] = {};
+  unsigned long reads = 0, torn = 0, plainTorn = 0, resets = 0;
+
+  host::setMillis(1000);
+  Button::setIdleTime(2000);
+  for(uint8_t b = 0; b < BUTTONS; ++b) {
+    host::setPin(2 + b, HIGH);
+    host::setPin(32 + b, HIGH);
+    isrButtons[b] = new Button(2 + b);
+    plainButtons[b] = new Button(32 + b);
+    nextChange[b] = 1000 + rnd.next(500);
+  }
+  isrList = new able::IsrButtonList<Button>(isrButtons, BUTTONS);
+  plainList = new able::ButtonList<Button>(plainButtons, BUTTONS);
+  isrList->begin();
+  plainList->begin();
+
+  for(unsigned long t = 1; t <= RUN_MILLIS; ++t) {
+    host::setMillis(1000 + t);
+    for(uint8_t b = 0; b < BUTTONS; ++b) {
+      if(millis() >= nextChange[b]) {
+        pressed[b] = !pressed[b];
+        lastChange[b] = millis();
+        nextChange[b] = millis() + (pressed[b] ? 60 + rnd.next(rnd.next(4) ? 150 : 1500) : 60 + rnd.next(rnd.next(3) ? 150 : 3000));
+      }
+      uint8_t level = pressed[b] ? LOW : HIGH;
+      if(millis() - lastChange[b] < 10 && rnd.next(3) == 0) level = !level; // Bounce after each change.
+      host::setPin(2 + b, level);
+      host::setPin(32 + b, level);
+    }
+
+    // Each list's ISR interrupts a read of the list: a snapshot, the states
+    // of a button or a query, in turn.
+    uint8_t b = rnd.next(BUTTONS), q = rnd.next(6);
+    bool isrSame = true, plainSame = true;
+    switch(t % 3) {
+      case 0:
+        isrSame = untorn<S>(isrHandle, [] { return isrList->snapshot(); });
+        plainSame = untorn<S>(plainHandle, [] { return plainList->snapshot(); });
+        break;
+
+      case 1:
+        isrSame = untorn<uint8_t>(isrHandle, [b] { return isrList->states(b); });
+        plainSame = untorn<uint8_t>(plainHandle, [b, &plainButtons] { return plainButtons[b]->states(); });
+        break;
+
+      default:
+        isrSame = untorn<bool>(isrHandle, [q] { return query(*isrList, q); });
+        plainSame = untorn<bool>(plainHandle, [q] { return query(*plainList, q); });
+        break;
+    }
+    ++reads;
+    if(!isrSame && torn++ < 5) {
+      printf("FAIL: read %lu of the ISR list at %lu torn by the ISR\n", t % 3, millis());
+    }
+    if(!plainSame) ++plainTorn;
+    if(!(isrList->snapshot() == plainList->snapshot()) && torn++ < 5) {
+      printf("FAIL: snapshot of the ISR list at %lu differs from the plain list\n", millis());
+    }
+
+    // Reset clicks now and then, as a program reading them would.
+    if(t % 997 == 0) {
+      bool clicked = isrList->anyClicked();
+      ++resets;
+      if((isrList->resetClicked() != clicked || isrList->anyClicked()) && torn++ < 5) {
+        printf("FAIL: ISR list still clicked after reset at %lu\n", millis());
+      }
+      plainList->resetClicked();
+    }
+  }
+
+  printf("reads=%lu torn: ISR list=%lu plain list=%lu, resets=%lu\n", reads, torn, plainTorn, resets);
+  if(torn) {
+    printf("FAIL: reads of the ISR list torn by the ISR\n");
+    ok = false;
+  }
+  if(!plainTorn) {
+    printf("FAIL: reads of the plain list never torn, so the test cannot tell\n");
+    ok = false;
+  }
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
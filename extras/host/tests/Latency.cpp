@@ -0,0 +1,203 @@
+/**
+ * @file Latency.cpp Benchmark of the latency from a physical edge to each
+ * callback event, for each debounce algorithm and loop() period. A generated
+ * signal of bouncing taps, holds and double-clicks, with edges timed to the
+ * microsecond, is injected into a callback double-clicker button using each
+ * debouncer. The latency of each event is measured from the first edge of
+ * the change causing it (the press for pressed and held events, otherwise the
+ * release), and reported as the median (p50), 99th percentile and maximum.
+ * The test fails if any button misses a press, or reports an event before
+ * its edge.
+ *
+ * Usage: `Latency [poll-us...]`, where each poll-us is a loop() period in
+ * microseconds (default 1000 and 5000).
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+#include <AbleButtons.h>
+#include "Fixtures.h"
+
+using E = able::CallbackEvents;
+
+const uint8_t POLICIES = 5; ///< Debounce algorithms measured (one button each).
+const uint8_t PINS[POLICIES] = {2, 3, 4, 5, 6}; ///< Pins of the buttons.
+const char *NAMES[POLICIES] = {"timer", "eager", "integrator", "pattern", "majority"}; ///< Names of the debouncers.
+const uint8_t EVENTS[] = {E::PRESSED_EVENT, E::RELEASED_EVENT, E::HELD_EVENT, E::SINGLE_CLICKED_EVENT, E::DOUBLE_CLICKED_EVENT}; ///< Events measured.
+const unsigned long GESTURES = 1000; ///< Number of gestures injected.
+
+//
+// Injected signal...
+//
+
+/**
+ * A change of the signal.
+ */
+struct Change {
+  unsigned long micros; ///< When the signal changes.
+  uint8_t pressed; ///< True if pressed after the change.
+  bool edge; ///< True for the first edge of a press or release (not bounce).
+};
+
+std::vector<Change> changes; ///< The signal.
+unsigned long presses = 0; ///< Presses in the signal.
+host::Random rnd(2024); ///< Pseudo-random sequence, so every run is the same.
+
+/**
+ * Add a change of the signal, bouncing for up to about 8ms before it settles.
+ *
+ * @param us When the signal starts to change (updated to when it settles).
+ * @param pressed True if pressed after the change.
+ */
+void change(unsigned long &us, uint8_t pressed) {
+  changes.push_back(Change{us, pressed, true});
+  for(unsigned long b = rnd.next(5); b; --b) {
+    us += 100 + rnd.next(1500);
+    changes.push_back(Change{us, (uint8_t) !pressed, false});
+    us += 50 + rnd.next(500);
+    changes.push_back(Change{us, pressed, false});
+  }
+  if(pressed) ++presses;
+}
+
+/**
+ * Generate taps, holds and double-clicks, with gaps longer than the click
+ * time between them.
+ */
+void generate() {
+  unsigned long us = 100000;
+  for(unsigned long g = 0; g < GESTURES; ++g) {
+    switch(rnd.next(3)) {
+      case 0: // Tap.
+        change(us, true); us += 100000 + rnd.next(100000);
+        change(us, false);
+        break;
+
+      case 1: // Hold.
+        change(us, true); us += 1100000 + rnd.next(500000);
+        change(us, false);
+        break;
+
+      default: // Double-click.
+        change(us, true); us += 100000 + rnd.next(50000);
+        change(us, false); us += 100000 + rnd.next(50000);
+        change(us, true); us += 100000 + rnd.next(50000);
+        change(us, false);
+        break;
+    }
+    us += 800000 + rnd.next(1000000);
+  }
+}
+
+//
+// Measured latency...
+//
+
+std::vector<unsigned long> latency[POLICIES + 1][E::DOUBLE_CLICKED_EVENT + 1]; ///< Latencies (us) by button id (1-5) and event.
+unsigned long pressMicros = 0; ///< When the last press started.
+unsigned long releaseMicros = 0; ///< When the last release started.
+bool early = false; ///< True if an event was reported before its edge.
+
+/**
+ * Callback recording the latency of each event from the edge causing it.
+ *
+ * @param event The event that occurred.
+ * @param id The identifier of the button.
+ */
+void onEvent(E::CALLBACK_EVENT event, uint8_t id) {
+  unsigned long from = (event == E::PRESSED_EVENT || event == E::HELD_EVENT) ? pressMicros : releaseMicros;
+  if(event == E::BEGIN_EVENT || event == E::IDLE_EVENT) return;
+  if(!from) {
+    early = true;
+    return;
+  }
+  latency[id][event].push_back(micros() - from);
+}
+
+/**
+ * Return a percentile of sorted latencies in milliseconds.
+ *
+ * @param v The sorted latencies (us).
+ * @param p The percentile (0-100).
+ *
+ * @return The percentile latency (ms).
+ */
+double percentile(const std::vector<unsigned long> &v, unsigned p) {
+  return v.empty() ? 0.0 : v[(v.size() - 1) * p / 100] / 1000.0;
+}
+
+/**
+ * Inject the signal into a button of each debouncer, polled at a period.
+ *
+ * @param pollMicros Microseconds between calls of handle(), as by loop().
+ */
+void run(unsigned long pollMicros) {
+  AblePullupCallbackDoubleClickerButton timerBtn(PINS[0], onEvent, 1);
+  AblePullupEagerCallbackDoubleClickerButton eagerBtn(PINS[1], onEvent, 2);
+  AblePullupIntegratorCallbackDoubleClickerButton integratorBtn(PINS[2], onEvent, 3);
+  AblePullupPatternCallbackDoubleClickerButton patternBtn(PINS[3], onEvent, 4);
+  AblePullupMajorityCallbackDoubleClickerButton majorityBtn(PINS[4], onEvent, 5);
+
+  for(uint8_t p = 0; p < POLICIES; ++p) host::setPin(PINS[p], HIGH);
+  for(uint8_t id = 1; id <= POLICIES; ++id) {
+    for(uint8_t e = 0; e <= E::DOUBLE_CLICKED_EVENT; ++e) latency[id][e].clear();
+  }
+  pressMicros = releaseMicros = 0;
+  host::setMicros(0);
+  timerBtn.begin();
+  eagerBtn.begin();
+  integratorBtn.begin();
+  patternBtn.begin();
+  majorityBtn.begin();
+
+  size_t next = 0;
+  unsigned long end = changes.back().micros + 2000000;
+  for(unsigned long us = pollMicros; us < end; us += pollMicros) {
+    host::setMicros(us);
+    for(; next < changes.size() && changes[next].micros <= us; ++next) {
+      const Change &c = changes[next];
+      if(c.edge) (c.pressed ? pressMicros : releaseMicros) = c.micros;
+      for(uint8_t p = 0; p < POLICIES; ++p) host::setPin(PINS[p], c.pressed ? LOW : HIGH);
+    }
+    timerBtn.handle();
+    eagerBtn.handle();
+    integratorBtn.handle();
+    patternBtn.handle();
+    majorityBtn.handle();
+  }
+}
+
+int main(int argc, char *argv[]) {
+  std::vector<unsigned long> polls;
+  for(int i = 1; i < argc; ++i) polls.push_back(strtoul(argv[i], 0, 10));
+  if(polls.empty()) polls = {1000, 5000};
+  bool ok = true;
+
+  generate();
+  printf("%-11s %7s %-15s %6s %8s %8s %8s\n", "debouncer", "poll ms", "event", "count", "p50 ms", "p99 ms", "max ms");
+  for(unsigned long poll : polls) {
+    run(poll ? poll : 1);
+    for(uint8_t id = 1; id <= POLICIES; ++id) {
+      for(uint8_t event : EVENTS) {
+        std::vector<unsigned long> &v = latency[id][event];
+        std::sort(v.begin(), v.end());
+        printf("%-11s %7.1f %-15s %6zu %8.1f %8.1f %8.1f\n", NAMES[id - 1], poll / 1000.0, event == E::PRESSED_EVENT ? "PRESSED" :
+          event == E::RELEASED_EVENT ? "RELEASED" : event == E::HELD_EVENT ? "HELD" : event == E::SINGLE_CLICKED_EVENT ? "SINGLE_CLICKED" : "DOUBLE_CLICKED",
+          v.size(), percentile(v, 50), percentile(v, 99), percentile(v, 100));
+      }
+      if(latency[id][E::PRESSED_EVENT].size() != presses) {
+        printf("FAIL: %s reported %zu of %lu presses\n", NAMES[id - 1], latency[id][E::PRESSED_EVENT].size(), presses);
+        ok = false;
+      }
+    }
+  }
+  if(early) {
+    printf("FAIL: an event was reported before its edge\n");
+    ok = false;
+  }
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
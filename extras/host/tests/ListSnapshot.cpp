@@ -0,0 +1,143 @@
+/**
+ * @file ListSnapshot.cpp Test of the snapshot of a button list. Generated
+ * taps, holds and double-clicks are pressed on a list of 40 double-clicker
+ * buttons, and on a list of direct buttons. The test fails unless, after
+ * every handle():
+ *
+ * - the snapshot masks match the states of each of the first 32 buttons;
+ * - the any and all states of the snapshot match the list queries, and the
+ *   queries return the same after the snapshot;
+ * - the snapshot reads the clock no more than once per button, and the
+ *   queries do not read it at all after the snapshot;
+ * - resetting clicks of the list stops its queries reading the snapshot.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <AbleButtons.h>
+#include "Fixtures.h"
+
+using S = able::ButtonStates;
+
+using CountingClock = host::CountingClock<>; ///< Clock counting how often it is read.
+
+using Button = able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::TimerDebouncer, CountingClock>>;
+using ButtonList = able::ButtonList<Button>;
+
+const uint8_t BUTTONS = 40; ///< Buttons in the list.
+const uint8_t MASKED = 32; ///< Buttons in the snapshot masks.
+const uint8_t DIRECT = 4; ///< Direct buttons in the other list.
+const unsigned long RUN_MILLIS = 200000; ///< How long to run (ms).
+
+host::Random rnd(1812); ///< Pseudo-random sequence, so every run is the same.
+
+/**
+ * Return the any and all queries of a list as bits, in the order of the
+ * ButtonStates bits (any in the low byte, all in the high byte).
+ *
+ * @param list The list to query.
+ *
+ * @return The results of the queries.
+ */
+template <typename List>
+uint16_t queries(const List &list) {
+  return (list.anyPressed() | list.anyHeld() << 1 | list.anyIdle() << 2 | list.anyClicked() << 3 | list.anySingleClicked() << 4 | list.anyDoubleClicked() << 5)
+    | (list.allPressed() | list.allHeld() << 1 | list.allIdle() << 2 | list.allClicked() << 3 | list.allSingleClicked() << 4 | list.allDoubleClicked() << 5) << 8;
+}
+
+int main() {
+  bool ok = true;
+  Button *buttons[BUTTONS];
+  AblePullupDirectButton *directs[DIRECT];
+  bool pressed[BUTTONS] = {};
+  unsigned long nextChange[BUTTONS], lastChange[BUTTONS] = {};
+  unsigned long checks = 0, mismatches = 0, snapshotReads = 0, queryReads = 0;
+  uint8_t seen = 0;
+
+  host::setMillis(1000);
+  Button::setIdleTime(3000);
+  for(uint8_t b = 0; b < BUTTONS; ++b) {
+    host::setPin(2 + b, HIGH);
+    buttons[b] = new Button(2 + b);
+    nextChange[b] = 1000 + rnd.next(500);
+  }
+  for(uint8_t b = 0; b < DIRECT; ++b) {
+    directs[b] = new AblePullupDirectButton(2 + b);
+  }
+  ButtonList list(buttons, BUTTONS);
+  able::ButtonList<AblePullupDirectButton> directList(directs, DIRECT);
+  list.begin();
+  directList.begin();
+
+  for(unsigned long t = 1; t <= RUN_MILLIS; ++t) {
+    host::setMillis(1000 + t);
+    bool quiet = t % 40000 >= 30000; // Released buttons stay released, so all become idle together.
+    for(uint8_t b = 0; b < BUTTONS; ++b) {
+      if(millis() >= nextChange[b] && !(quiet && !pressed[b])) {
+        pressed[b] = !pressed[b];
+        lastChange[b] = millis();
+        nextChange[b] = millis() + (pressed[b] ? 60 + rnd.next(rnd.next(4) ? 150 : 1500) : 60 + rnd.next(rnd.next(3) ? 150 : 4000));
+      }
+      uint8_t level = pressed[b] ? LOW : HIGH;
+      if(millis() - lastChange[b] < 10 && rnd.next(3) == 0) level = !level; // Bounce after each change.
+      host::setPin(2 + b, level);
+    }
+    list.handle();
+    directList.handle();
+
+    CountingClock::reads = 0;
+    uint16_t expected = queries(list);
+    queryReads += CountingClock::reads;
+    CountingClock::reads = 0;
+    S states = list.snapshot();
+    snapshotReads += CountingClock::reads;
+    if(CountingClock::reads > BUTTONS && mismatches++ < 5) {
+      printf("FAIL: snapshot at %lu read the clock %lu times\n", millis(), CountingClock::reads);
+    }
+
+    uint32_t bit = 1;
+    for(uint8_t b = 0; b < MASKED; ++b, bit <<= 1) {
+      uint8_t want = buttons[b]->isPressed() | (buttons[b]->isHeld() << 1) | (buttons[b]->isIdle() << 2) | (buttons[b]->isClicked() << 3) | (buttons[b]->isSingleClicked() << 4) | (buttons[b]->isDoubleClicked() << 5);
+      uint8_t got = (!!(states.pressed & bit)) | (!!(states.held & bit) << 1) | (!!(states.idle & bit) << 2) | (!!(states.clicked & bit) << 3) | (!!(states.singleClicked & bit) << 4) | (!!(states.doubleClicked & bit) << 5);
+      ++checks;
+      if(want != got && mismatches++ < 5) {
+        printf("FAIL: button %u at %lu: states %02x, snapshot %02x\n", b, millis(), want, got);
+      }
+    }
+    seen |= states.any | (states.all ? 0x40 : 0);
+    ++checks;
+    CountingClock::reads = 0;
+    uint16_t actual = queries(list);
+    if((expected != (states.any | states.all << 8) || actual != expected || CountingClock::reads) && mismatches++ < 5) {
+      printf("FAIL: queries at %lu: list %04x, snapshot %04x, after snapshot %04x\n", millis(), expected, states.any | states.all << 8, actual);
+    }
+
+    uint16_t directExpected = directList.anyPressed() | directList.allPressed() << 8;
+    S directStates = directList.snapshot();
+    ++checks;
+    if(directExpected != (directStates.any | directStates.all << 8) && mismatches++ < 5) {
+      printf("FAIL: direct queries at %lu: list %04x, snapshot %02x %02x\n", millis(), directExpected, directStates.any, directStates.all);
+    }
+
+    // Reset clicks now and then, as a program reading them would.
+    if(t % 997 == 0) {
+      bool clicked = list.anyClicked();
+      ++checks;
+      if((list.resetClicked() != clicked || list.anyClicked()) && mismatches++ < 5) {
+        printf("FAIL: list still clicked after reset at %lu\n", millis());
+      }
+    }
+  }
+
+  printf("checks=%lu mismatches=%lu states seen=%02x clock reads: queries=%lu snapshot=%lu\n", checks, mismatches, seen, queryReads, snapshotReads);
+  if(mismatches || seen != 0x7F) {
+    printf("FAIL: snapshot differs from the button states\n");
+    ok = false;
+  }
+  if(snapshotReads * 2 > queryReads) {
+    printf("FAIL: snapshot reads the clock as often as the queries\n");
+    ok = false;
+  }
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
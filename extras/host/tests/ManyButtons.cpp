@@ -0,0 +1,176 @@
+/**
+ * @file ManyButtons.cpp Test of 16-bit button ids. A list of 3000 callback
+ * buttons with auto-assigned ids is handled while generated presses are
+ * pressed on some of them. The test fails unless:
+ *
+ * - every button has a unique id, and callbacks receive the ids above 255;
+ * - ButtonList::button() finds every button, in id order or not, and finds
+ *   buttons in id order without searching the list;
+ * - telemetry frames carry the 16-bit ids, including those sent by a
+ *   telemetry callback button;
+ * - once all 65535 ids are assigned, idsExhausted() is true and later
+ *   buttons get id 0 instead of reusing ids.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+// Flags: -DABLE_BUTTON_ID_BITS=16
+#include <time.h>
+#include <algorithm>
+#include <vector>
+#include <AbleButtons.h>
+#include "Fixtures.h"
+
+using E = able::CallbackEvents;
+using Button = AblePullupCallbackButton;
+using ButtonList = AblePullupCallbackButtonList;
+
+const size_t BUTTONS = 3000; ///< Buttons in the list.
+
+std::vector<able::ButtonId> pressedIds; ///< Ids of pressed events.
+host::Random rnd(65535); ///< Pseudo-random sequence, so every run is the same.
+
+void onEvent(E::CALLBACK_EVENT event, able::ButtonId id) {
+  if(event == E::PRESSED_EVENT) pressedIds.push_back(id);
+}
+
+/**
+ * Telemetry stream kept in memory.
+ */
+class Capture: public Print {
+  public:
+    size_t write(uint8_t c) override { sent.push_back(c); return 1; } ///< Keep a byte.
+    int availableForWrite() override { return 64; } ///< Always room.
+    std::vector<uint8_t> sent; ///< The bytes written.
+};
+
+/**
+ * Return the time to look up every button of a list, in nanoseconds per
+ * lookup.
+ *
+ * @param list The list.
+ * @param ids The ids to look up.
+ * @param found Set to the number of ids found with the right id.
+ *
+ * @return The average time of a lookup.
+ */
+double lookups(const ButtonList &list, const std::vector<able::ButtonId> &ids, size_t &found) {
+  clock_t start = clock();
+  found = 0;
+  for(int repeat = 0; repeat < 10; ++repeat) {
+    for(able::ButtonId id : ids) {
+      Button *btn = list.button(id);
+      found += btn && btn->id() == id;
+    }
+  }
+  found /= 10;
+  return 1e9 * (clock() - start) / CLOCKS_PER_SEC / (10.0 * ids.size());
+}
+
+int main() {
+  bool ok = true;
+  std::vector<Button *> buttons;
+  std::vector<able::ButtonId> ids;
+
+  host::setMillis(1000);
+  for(size_t b = 0; b < BUTTONS; ++b) {
+    host::setPin(b % 200, HIGH);
+    buttons.push_back(new Button(b % 200, onEvent));
+    ids.push_back(buttons.back()->id());
+  }
+  ButtonList list(buttons.data(), buttons.size());
+  list.begin();
+
+  std::vector<able::ButtonId> sorted(ids);
+  std::sort(sorted.begin(), sorted.end());
+  bool unique = std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end() && sorted.front() == 1 && sorted.back() == BUTTONS;
+  printf("ids: first=%u last=%u unique=%d\n", sorted.front(), sorted.back(), unique);
+  if(!unique) {
+    printf("FAIL: auto-assigned ids not unique\n");
+    ok = false;
+  }
+
+  // Press pins 0-9, each shared by 15 buttons (some with ids above 255).
+  for(uint8_t pin = 0; pin < 10; ++pin) host::setPin(pin, LOW);
+  for(unsigned long t = 1; t <= 100; ++t) {
+    host::setMillis(1000 + t);
+    list.handle();
+  }
+  bool high = std::find(pressedIds.begin(), pressedIds.end(), buttons[2005]->id()) != pressedIds.end();
+  printf("pressed events=%zu id %u pressed=%d\n", pressedIds.size(), buttons[2005]->id(), high);
+  if(pressedIds.size() != 10 * (BUTTONS / 200) || !high) {
+    printf("FAIL: callbacks did not receive 16-bit ids\n");
+    ok = false;
+  }
+
+  // Look up in id order, then in a shuffled list.
+  size_t found, shuffledFound;
+  double ordered = lookups(list, ids, found);
+  std::vector<Button *> shuffled(buttons);
+  for(size_t i = shuffled.size() - 1; i > 0; --i) std::swap(shuffled[i], shuffled[rnd.next(i + 1)]);
+  ButtonList shuffledList(shuffled.data(), shuffled.size());
+  double searched = lookups(shuffledList, ids, shuffledFound);
+  bool missing = list.button(BUTTONS + 1) == 0 && shuffledList.button(BUTTONS + 1) == 0;
+  printf("lookups: ordered=%zu in %.1fns searched=%zu in %.1fns\n", found, ordered, shuffledFound, searched);
+  if(found != BUTTONS || shuffledFound != BUTTONS || !missing) {
+    printf("FAIL: buttons not found by id\n");
+    ok = false;
+  }
+  if(ordered * 20 > searched) {
+    printf("FAIL: lookup of buttons in id order searched the list\n");
+    ok = false;
+  }
+
+  // Telemetry with 16-bit ids.
+  Capture capture;
+  able::Telemetry::begin(capture);
+  able::Telemetry::send(E::HELD_EVENT, 2345, 123456);
+  able::Telemetry::end();
+  able::TelemetryReader reader(capture.sent.data(), capture.sent.size());
+  uint8_t event = 0;
+  able::ButtonId id = 0;
+  unsigned long value = 0;
+  bool read = reader.next(event, id, value);
+  printf("telemetry: frame=%zu bytes id=%u time=%lu\n", capture.sent.size(), id, value);
+  if(!read || capture.sent.size() != 9 || event != E::HELD_EVENT || id != 2345 || value != 123456) {
+    printf("FAIL: telemetry frame lost the 16-bit id\n");
+    ok = false;
+  }
+
+  // Telemetry from a callback button with a 16-bit id.
+  using TelemetryButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DebouncedPin<>>, able::TelemetryCallback<>>;
+  TelemetryButton telemetryButton(250, onEvent, 2345);
+  host::setPin(250, HIGH);
+  telemetryButton.begin();
+  capture.sent.clear();
+  able::Telemetry::begin(capture);
+  host::setPin(250, LOW);
+  for(unsigned long t = 101; t <= 200 && capture.sent.empty(); ++t) {
+    host::setMillis(1000 + t);
+    telemetryButton.handle();
+  }
+  able::Telemetry::end();
+  able::TelemetryReader buttonReader(capture.sent.data(), capture.sent.size());
+  read = buttonReader.next(event, id, value);
+  printf("telemetry callback: frame=%zu bytes id=%u time=%lu\n", capture.sent.size(), id, value);
+  if(!read || event != E::PRESSED_EVENT || id != 2345 || value != millis()) {
+    printf("FAIL: telemetry callback lost the 16-bit id\n");
+    ok = false;
+  }
+
+  // Use up the ids.
+  bool exhaustedEarly = Button::idsExhausted();
+  std::vector<Button *> more;
+  for(size_t b = BUTTONS; b < 65535; ++b) more.push_back(new Button(2));
+  bool last = more.back()->id() == 65535 && Button::idsExhausted();
+  Button extra(2);
+  printf("ids exhausted: early=%d at 65535=%d extra id=%u\n", exhaustedEarly, last, extra.id());
+  if(exhaustedEarly || !last || extra.id() != 0) {
+    printf("FAIL: id wraparound not detected\n");
+    ok = false;
+  }
+
+  for(Button *btn : buttons) delete btn;
+  for(Button *btn : more) delete btn;
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file MixedPolarity.cpp Test of the mixed resistor circuit. Generated taps,
+ * holds and double-clicks are pressed on pull-up and pulldown buttons, and on
+ * mixed buttons of one list wired the same way. The test fails unless:
+ *
+ * - each mixed button gives the same events, at the same times, as the
+ *   pull-up or pulldown button with the same presses;
+ * - mixed pins are set to the pin mode of their circuit;
+ * - pins beyond the polarity mask are pulldown.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <algorithm>
+#include <vector>
+#include <AbleButtons.h>
+#include "Fixtures.h"
+
+using E = able::CallbackEvents;
+using Mixed = AbleMixedCallbackDoubleClickerButton;
+using MixedList = AbleMixedCallbackDoubleClickerButtonList;
+
+const uint8_t BUTTONS = 6; ///< Buttons of each kind (even buttons pull-up, odd pulldown).
+const unsigned long RUN_MILLIS = 300000; ///< How long to run (ms).
+
+/**
+ * An event of a button.
+ */
+struct Event {
+  unsigned long millis; ///< When the event occurred.
+  uint8_t id; ///< The button (1-BUTTONS, the same for matching buttons).
+  uint8_t event; ///< The event.
+  bool operator<(const Event &e) const { return millis != e.millis ? millis < e.millis : id != e.id ? id < e.id : event < e.event; } ///< Order events.
+  bool operator!=(const Event &e) const { return millis != e.millis || id != e.id || event != e.event; } ///< Compare events.
+};
+
+std::vector<Event> plainEvents; ///< Events of the pull-up and pulldown buttons.
+std::vector<Event> mixedEvents; ///< Events of the mixed buttons.
+host::Random rnd(8086); ///< Pseudo-random sequence, so every run is the same.
+
+void onPlain(E::CALLBACK_EVENT event, uint8_t id) {
+  plainEvents.push_back(Event{millis(), id, (uint8_t) event});
+}
+
+void onMixed(E::CALLBACK_EVENT event, uint8_t id) {
+  mixedEvents.push_back(Event{millis(), (uint8_t)(id - 100), (uint8_t) event});
+}
+
+int main() {
+  bool ok = true;
+  AblePullupCallbackDoubleClickerButton *pullups[BUTTONS / 2];
+  AblePulldownCallbackDoubleClickerButton *pulldowns[BUTTONS / 2];
+  Mixed *mixed[BUTTONS];
+  bool pressed[BUTTONS] = {};
+  unsigned long nextChange[BUTTONS];
+
+  // Plain buttons on pins 2-7, mixed buttons on pins 12-17.
+  host::setMillis(1000);
+  for(uint8_t b = 0; b < BUTTONS; ++b) {
+    bool pullup = b % 2 == 0;
+    uint8_t pin = 2 + b, mixedPin = 12 + b;
+    host::setPin(pin, pullup ? HIGH : LOW);
+    host::setPin(mixedPin, pullup ? HIGH : LOW);
+    if(pullup) pullups[b / 2] = new AblePullupCallbackDoubleClickerButton(pin, onPlain, 1 + b);
+    else pulldowns[b / 2] = new AblePulldownCallbackDoubleClickerButton(pin, onPlain, 1 + b);
+    able::MixedResistorCircuit::setPullup(mixedPin, pullup);
+    mixed[b] = new Mixed(mixedPin, onMixed, 101 + b);
+    nextChange[b] = 1000 + rnd.next(500);
+  }
+  MixedList list(mixed, BUTTONS);
+  for(uint8_t b = 0; b < BUTTONS / 2; ++b) {
+    pullups[b]->begin();
+    pulldowns[b]->begin();
+  }
+  list.begin();
+
+  for(unsigned long t = 1; t <= RUN_MILLIS; ++t) {
+    host::setMillis(1000 + t);
+    for(uint8_t b = 0; b < BUTTONS; ++b) {
+      if(millis() >= nextChange[b]) {
+        pressed[b] = !pressed[b];
+        nextChange[b] = millis() + (pressed[b] ? 60 + rnd.next(rnd.next(4) ? 150 : 1500) : 60 + rnd.next(rnd.next(3) ? 150 : 2000));
+      }
+      uint8_t level = pressed[b] == (b % 2 == 0) ? LOW : HIGH; // Pull-up buttons read LOW when pressed.
+      if(rnd.next(20) == 0) level = !level; // Bounce.
+      host::setPin(2 + b, level);
+      host::setPin(12 + b, level);
+    }
+    for(uint8_t b = 0; b < BUTTONS / 2; ++b) {
+      pullups[b]->handle();
+      pulldowns[b]->handle();
+    }
+    list.handle();
+  }
+
+  std::sort(plainEvents.begin(), plainEvents.end());
+  std::sort(mixedEvents.begin(), mixedEvents.end());
+  printf("events: plain=%zu mixed=%zu\n", plainEvents.size(), mixedEvents.size());
+  if(plainEvents.size() != mixedEvents.size() || plainEvents.size() < 1000) {
+    printf("FAIL: mixed events differ from plain events\n");
+    ok = false;
+  }
+  for(size_t i = 0; i < plainEvents.size() && i < mixedEvents.size(); ++i) {
+    if(plainEvents[i] != mixedEvents[i]) {
+      printf("FAIL: event %zu plain %lu %u %u, mixed %lu %u %u\n", i,
+        plainEvents[i].millis, plainEvents[i].id, plainEvents[i].event,
+        mixedEvents[i].millis, mixedEvents[i].id, mixedEvents[i].event);
+      ok = false;
+      break;
+    }
+  }
+
+  bool modes = true;
+  for(uint8_t b = 0; b < BUTTONS; ++b) {
+    uint8_t mode = able::MixedResistorCircuit::inputMode(12 + b);
+    modes = modes && mode == (b % 2 == 0 ? INPUT_PULLUP : INPUT);
+  }
+  able::MixedResistorCircuit::setPullup(able::MixedResistorCircuit::PINS);
+  bool beyond = !able::MixedResistorCircuit::isPullup(able::MixedResistorCircuit::PINS);
+  printf("pin modes=%d beyond mask=%d\n", modes, beyond);
+  if(!modes || !beyond) {
+    printf("FAIL: pin modes of the mixed circuit wrong\n");
+    ok = false;
+  }
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
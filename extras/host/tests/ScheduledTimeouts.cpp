@@ -0,0 +1,264 @@
+/**
+ * @file ScheduledTimeouts.cpp Test of the scheduled button list. Generated
+ * taps, holds and double-clicks are pressed on 64 callback buttons handled in
+ * a ButtonList, and on 64 handled in a ScheduledButtonList, for each of the
+ * timer and integrator debouncers. The test fails unless:
+ *
+ * - the scheduled buttons give the same events, at the same times, as the
+ *   listed buttons with the same presses;
+ * - while no button changes, a pass of the scheduled list reads the clock at
+ *   most 3 times, however many buttons it has, even with the timer debouncer
+ *   (the pins are not read while the port snapshot is unchanged);
+ * - on the 16-bit Millis16Clock, buttons that changed more than half its wrap
+ *   period apart (but within the idle time) still both become idle, and stay
+ *   idle while the clock wraps, whether listed or scheduled.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <algorithm>
+#include <vector>
+#include <AbleButtons.h>
+#include "Fixtures.h"
+
+using E = able::CallbackEvents;
+
+const uint8_t BUTTONS = 64; ///< Buttons in each list.
+const unsigned long RUN_MILLIS = 200000; ///< How long to run (ms).
+
+using CountingClock = host::CountingClock<>; ///< Clock counting how often it is read.
+
+/**
+ * An event of a button.
+ */
+struct Event {
+  unsigned long millis; ///< When the event occurred.
+  uint8_t id; ///< The button (1-BUTTONS, the same for matching buttons).
+  uint8_t event; ///< The event.
+  bool operator<(const Event &e) const { return millis != e.millis ? millis < e.millis : id != e.id ? id < e.id : event < e.event; } ///< Order events.
+  bool operator!=(const Event &e) const { return millis != e.millis || id != e.id || event != e.event; } ///< Compare events.
+};
+
+std::vector<Event> listedEvents; ///< Events of the buttons in the ButtonList.
+std::vector<Event> scheduledEvents; ///< Events of the buttons in the ScheduledButtonList.
+host::Random rnd(4004); ///< Pseudo-random sequence, so every run is the same.
+
+void onListed(E::CALLBACK_EVENT event, able::ButtonId id) {
+  listedEvents.push_back(Event{millis(), (uint8_t) id, (uint8_t) event});
+}
+
+void onScheduled(E::CALLBACK_EVENT event, able::ButtonId id) {
+  scheduledEvents.push_back(Event{millis(), (uint8_t)(id - 100), (uint8_t) event});
+}
+
+/**
+ * Run a ButtonList and a ScheduledButtonList of buttons with the same
+ * generated presses, then compare their events.
+ *
+ * @param Button The callback button class.
+ * @param name The name of the run.
+ *
+ * @return True if the events match, else false.
+ */
+template <typename Button>
+bool run(const char *name) {
+  typedef able::ScheduledButton<Button> Scheduled;
+  Button *listed[BUTTONS];
+  Scheduled *scheduled[BUTTONS];
+  bool pressed[BUTTONS] = {};
+  unsigned long nextChange[BUTTONS], lastChange[BUTTONS] = {};
+  bool ok = true;
+
+  // Listed buttons on pins 0-63, scheduled buttons on pins 100-163.
+  listedEvents.clear();
+  scheduledEvents.clear();
+  Button::setIdleTime(5000);
+  host::setMillis(1000);
+  for(uint8_t b = 0; b < BUTTONS; ++b) {
+    host::setPin(b, HIGH);
+    host::setPin(100 + b, HIGH);
+    listed[b] = new Button(b, onListed, 1 + b);
+    scheduled[b] = new Scheduled(100 + b, onScheduled, 101 + b);
+    nextChange[b] = 1000 + rnd.next(5000);
+  }
+  able::ButtonList<Button> list(listed, BUTTONS);
+  able::ScheduledButtonList<Scheduled> scheduledList(scheduled, BUTTONS);
+  list.begin();
+  scheduledList.begin();
+
+  for(unsigned long t = 1; t <= RUN_MILLIS; ++t) {
+    host::setMillis(1000 + t);
+    for(uint8_t b = 0; b < BUTTONS; ++b) {
+      if(millis() >= nextChange[b]) {
+        pressed[b] = !pressed[b];
+        lastChange[b] = millis();
+        nextChange[b] = millis() + (pressed[b] ? 60 + rnd.next(rnd.next(4) ? 150 : 1500) : 60 + rnd.next(rnd.next(3) ? 150 : 8000));
+      }
+      uint8_t level = pressed[b] ? LOW : HIGH;
+      if(millis() - lastChange[b] < 10 && rnd.next(4) == 0) level = !level; // Bounce after a change.
+      host::setPin(b, level);
+      host::setPin(100 + b, level);
+    }
+    list.handle();
+    scheduledList.handle();
+  }
+
+  std::sort(listedEvents.begin(), listedEvents.end());
+  std::sort(scheduledEvents.begin(), scheduledEvents.end());
+  size_t counts[E::DOUBLE_CLICKED_EVENT + 1] = {};
+  for(size_t i = 0; i < listedEvents.size(); ++i) ++counts[listedEvents[i].event];
+  printf("%s: events listed=%zu scheduled=%zu (held=%zu idle=%zu single=%zu double=%zu)\n", name, listedEvents.size(), scheduledEvents.size(),
+    counts[E::HELD_EVENT], counts[E::IDLE_EVENT], counts[E::SINGLE_CLICKED_EVENT], counts[E::DOUBLE_CLICKED_EVENT]);
+  if(listedEvents.size() != scheduledEvents.size() || !counts[E::HELD_EVENT] || !counts[E::IDLE_EVENT] || !counts[E::SINGLE_CLICKED_EVENT] || !counts[E::DOUBLE_CLICKED_EVENT]) {
+    printf("FAIL: %s: scheduled events differ from listed events\n", name);
+    ok = false;
+  }
+  for(size_t i = 0; i < listedEvents.size() && i < scheduledEvents.size(); ++i) {
+    if(listedEvents[i] != scheduledEvents[i]) {
+      printf("FAIL: %s: event %zu listed %lu %u %u, scheduled %lu %u %u\n", name, i,
+        listedEvents[i].millis, listedEvents[i].id, listedEvents[i].event,
+        scheduledEvents[i].millis, scheduledEvents[i].id, scheduledEvents[i].event);
+      ok = false;
+      break;
+    }
+  }
+
+  for(uint8_t b = 0; b < BUTTONS; ++b) {
+    delete listed[b];
+    delete scheduled[b];
+  }
+  return ok;
+}
+
+/**
+ * Count the clock readings of quiet passes of a ButtonList and a
+ * ScheduledButtonList, once their buttons have been pressed and released.
+ *
+ * @param Debouncer The debouncer class of the buttons.
+ * @param name The name of the run.
+ *
+ * @return True if the scheduled list read the clock at most 3 times per pass,
+ *         else false.
+ */
+template <typename Debouncer>
+bool quiet(const char *name) {
+  typedef able::CallbackClickerButton<able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<able::NoCounters, Debouncer, CountingClock>>>> Button;
+  typedef able::ScheduledButton<Button> Scheduled;
+  Button *listed[BUTTONS];
+  Scheduled *scheduled[BUTTONS];
+  for(uint8_t b = 0; b < BUTTONS; ++b) {
+    host::setPin(b, HIGH);
+    listed[b] = new Button(b);
+    scheduled[b] = new Scheduled(b);
+  }
+  able::ButtonList<Button> list(listed, BUTTONS);
+  able::ScheduledButtonList<Scheduled> scheduledList(scheduled, BUTTONS);
+  list.begin();
+  scheduledList.begin();
+  for(uint8_t b = 0; b < BUTTONS; ++b) host::setPin(b, LOW);
+  for(int t = 0; t < 200; ++t) { host::setMillis(500000 + t); list.handle(); scheduledList.handle(); }
+  for(uint8_t b = 0; b < BUTTONS; ++b) host::setPin(b, HIGH);
+  for(int t = 0; t < 300; ++t) { host::setMillis(500200 + t); list.handle(); scheduledList.handle(); }
+  CountingClock::reads = 0; // Released, waiting to become idle.
+  for(int t = 0; t < 1000; ++t) { host::setMillis(500500 + t); list.handle(); }
+  unsigned long listedReads = CountingClock::reads;
+  CountingClock::reads = 0;
+  for(int t = 0; t < 1000; ++t) { host::setMillis(501500 + t); scheduledList.handle(); }
+  unsigned long scheduledReads = CountingClock::reads;
+  printf("%s: clock reads per pass: listed=%.1f scheduled=%.1f\n", name, listedReads / 1000.0, scheduledReads / 1000.0);
+  for(uint8_t b = 0; b < BUTTONS; ++b) {
+    delete listed[b];
+    delete scheduled[b];
+  }
+  if(scheduledReads > 3 * 1000) {
+    printf("FAIL: %s: scheduled list checks buttons that are not due\n", name);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Click two buttons 40s apart on the Millis16Clock, further apart than half
+ * its wrap period, then wait for both to become idle, in a ButtonList and a
+ * ScheduledButtonList, and leave them idle while the clock wraps twice more.
+ *
+ * @return True if the scheduled buttons give the same events as the listed
+ *         buttons, including both idle events, and all stay idle, else false.
+ */
+bool wrap() {
+  typedef able::CallbackClickerButton<able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::TimerDebouncer, able::Millis16Clock>>>> Button;
+  typedef able::ScheduledButton<Button> Scheduled;
+  const unsigned long CLICKS[] = {10000, 50000}; ///< When each button is clicked.
+  Button *listed[2];
+  Scheduled *scheduled[2];
+  unsigned long notIdle = 0;
+  bool ok = true;
+
+  listedEvents.clear();
+  scheduledEvents.clear();
+  host::setMillis(0);
+  for(uint8_t b = 0; b < 2; ++b) {
+    host::setPin(2 + b, HIGH);
+    host::setPin(102 + b, HIGH);
+    listed[b] = new Button(2 + b, onListed, 1 + b);
+    scheduled[b] = new Scheduled(102 + b, onScheduled, 101 + b);
+  }
+  able::ButtonList<Button> list(listed, 2);
+  able::ScheduledButtonList<Scheduled> scheduledList(scheduled, 2);
+  list.begin();
+  scheduledList.begin();
+  for(unsigned long t = 1; t <= 200000; ++t) {
+    host::setMillis(t);
+    for(uint8_t b = 0; b < 2; ++b) {
+      uint8_t level = t >= CLICKS[b] && t < CLICKS[b] + 200 ? LOW : HIGH;
+      host::setPin(2 + b, level);
+      host::setPin(102 + b, level);
+    }
+    list.handle();
+    scheduledList.handle();
+    for(uint8_t b = 0; b < 2; ++b) {
+      if(t >= CLICKS[b] + 200 + Button::idleTime()) notIdle += !listed[b]->isIdle() + !scheduled[b]->isIdle();
+    }
+  }
+
+  size_t idles = 0;
+  for(size_t i = 0; i < listedEvents.size(); ++i) idles += listedEvents[i].event == E::IDLE_EVENT && listedEvents[i].millis > CLICKS[1];
+  printf("wrap: events listed=%zu scheduled=%zu (idle after clicks=%zu) not idle once idle=%lu\n", listedEvents.size(), scheduledEvents.size(), idles, notIdle);
+  if(idles != 2 || listedEvents.size() != scheduledEvents.size()) {
+    printf("FAIL: wrap: scheduled events differ from listed events\n");
+    ok = false;
+  }
+  if(notIdle) {
+    printf("FAIL: wrap: idle buttons stopped being idle as the clock wrapped\n");
+    ok = false;
+  }
+  for(size_t i = 0; i < listedEvents.size() && i < scheduledEvents.size(); ++i) {
+    if(listedEvents[i] != scheduledEvents[i]) {
+      printf("FAIL: wrap: event %zu listed %lu %u %u, scheduled %lu %u %u\n", i,
+        listedEvents[i].millis, listedEvents[i].id, listedEvents[i].event,
+        scheduledEvents[i].millis, scheduledEvents[i].id, scheduledEvents[i].event);
+      ok = false;
+      break;
+    }
+  }
+
+  for(uint8_t b = 0; b < 2; ++b) {
+    delete listed[b];
+    delete scheduled[b];
+  }
+  return ok;
+}
+
+int main() {
+  bool ok = true;
+
+  ok = run<AblePullupCallbackDoubleClickerButton>("timer") && ok;
+  ok = run<AblePullupIntegratorCallbackDoubleClickerButton>("integrator") && ok;
+
+  ok = quiet<able::TimerDebouncer>("timer") && ok;
+  ok = quiet<able::IntegratorDebouncer<>>("integrator") && ok;
+
+  ok = wrap() && ok;
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
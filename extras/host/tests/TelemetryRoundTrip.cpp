@@ -0,0 +1,193 @@
+/**
+ * @file TelemetryRoundTrip.cpp Test of the telemetry stream. Generated taps,
+ * holds and double-clicks on four telemetry callback buttons are sent through
+ * a simulated serial transmit buffer, then decoded. The test fails unless:
+ *
+ * - at a fast baud rate, the decoded frames are the events of the callback
+ *   function, with the same ids and times, and nothing is dropped;
+ * - at a slow baud rate, sending never waits for the buffer, the decoded
+ *   events are a subset of the callback events in the same order, and the
+ *   dropped events account for the rest (those after the last frame are
+ *   only counted by Telemetry::dropped());
+ * - the reader finds every frame again after corrupt bytes.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <vector>
+#include <AbleButtons.h>
+#include "Fixtures.h"
+
+using E = able::CallbackEvents;
+using Button = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<>>, able::TelemetryCallback<>>>;
+
+const uint8_t BUTTONS = 4; ///< Buttons sending telemetry.
+
+/**
+ * Simulated serial port with a 64-byte transmit buffer, sending bytes at a
+ * baud rate (10 bits per byte). Sent bytes are kept to be decoded.
+ */
+class TxBuffer: public Print {
+  public:
+    TxBuffer(unsigned long baud): baud_(baud), bits_(0), used_(0), overrun_(false) {} ///< Create an empty buffer.
+    size_t write(uint8_t c) override { if(used_ == 64) overrun_ = true; else ++used_; sent.push_back(c); return 1; } ///< Queue a byte.
+    int availableForWrite() override { return 64 - used_; } ///< Room in the buffer.
+    void tick() { for(bits_ += baud_; bits_ >= 10000; bits_ -= 10000) if(used_) --used_; } ///< Send bytes for a millisecond.
+    bool overrun() const { return overrun_; } ///< True if a write would have blocked.
+    std::vector<uint8_t> sent; ///< The bytes written.
+
+  private:
+    unsigned long baud_; ///< Bits sent per second.
+    unsigned long bits_; ///< Bits (x1000) not yet sent as a byte.
+    unsigned used_; ///< Bytes in the buffer.
+    bool overrun_; ///< True if written when full.
+};
+
+/**
+ * An event of a button.
+ */
+struct Event {
+  unsigned long millis; ///< When the event occurred.
+  uint8_t id; ///< The button.
+  uint8_t event; ///< The event.
+  bool operator!=(const Event &e) const { return millis != e.millis || id != e.id || event != e.event; } ///< Compare events.
+};
+
+std::vector<Event> callbackEvents; ///< Events of the callback function.
+host::Random rnd(31337); ///< Pseudo-random sequence, so every run is the same.
+
+void onEvent(E::CALLBACK_EVENT event, uint8_t id) {
+  callbackEvents.push_back(Event{millis(), id, (uint8_t) event});
+}
+
+/**
+ * Run the buttons on generated signals, sending telemetry to a buffer.
+ *
+ * @param tx The transmit buffer.
+ * @param ms How long to run (ms).
+ */
+void run(TxBuffer &tx, unsigned long ms) {
+  Button *buttons[BUTTONS];
+  unsigned long nextChange[BUTTONS];
+
+  callbackEvents.clear();
+  able::Telemetry::resetDropped();
+  able::Telemetry::begin(tx);
+  host::setMillis(1000);
+  for(uint8_t b = 0; b < BUTTONS; ++b) {
+    host::setPin(2 + b, HIGH);
+    buttons[b] = new Button(2 + b, onEvent, 1 + b);
+    buttons[b]->begin();
+    nextChange[b] = 1000 + rnd.next(500);
+  }
+
+  for(unsigned long t = 1; t <= ms; ++t) {
+    host::setMillis(1000 + t);
+    tx.tick();
+    for(uint8_t b = 0; b < BUTTONS; ++b) {
+      if(millis() >= nextChange[b]) {
+        uint8_t level = !digitalRead(2 + b);
+        host::setPin(2 + b, level);
+        nextChange[b] = millis() + (level == LOW ? 60 + rnd.next(rnd.next(4) ? 150 : 1500) : 60 + rnd.next(rnd.next(3) ? 150 : 2000));
+      }
+      buttons[b]->handle();
+    }
+  }
+
+  able::Telemetry::end();
+  for(uint8_t b = 0; b < BUTTONS; ++b) delete buttons[b];
+}
+
+/**
+ * Decode a stream, checking its events are the callback events in order,
+ * less the events counted by Telemetry::dropped().
+ *
+ * @param name The name of the run.
+ * @param data The stream.
+ * @param size The size of the stream.
+ * @param dropped Set to the dropped events reported by the stream.
+ * @param skipped Set to the bytes skipped by the reader.
+ *
+ * @return True if the events match, else false.
+ */
+bool check(const char *name, const uint8_t *data, size_t size, unsigned long &dropped, size_t &skipped) {
+  able::TelemetryReader reader(data, size);
+  size_t next = 0, decoded = 0;
+  uint8_t event, id;
+  unsigned long value;
+  bool ok = true;
+
+  dropped = 0;
+  while(reader.next(event, id, value)) {
+    if(event == able::Telemetry::DROPPED) {
+      dropped += value;
+      continue;
+    }
+    Event e{value, id, event};
+    ++decoded;
+    while(next < callbackEvents.size() && callbackEvents[next] != e) ++next; // Skip dropped events.
+    if(next == callbackEvents.size()) {
+      printf("FAIL: %s: decoded event %lu %u %u not sent\n", name, value, id, event);
+      ok = false;
+      break;
+    }
+    ++next;
+  }
+  skipped = reader.skipped();
+  printf("%s: events=%zu decoded=%zu dropped=%lu skipped=%zu bytes=%zu\n", name, callbackEvents.size(), decoded, dropped, skipped, size);
+  if(decoded + able::Telemetry::dropped() != callbackEvents.size() || dropped > able::Telemetry::dropped()) {
+    printf("FAIL: %s: decoded and dropped events do not add up\n", name);
+    ok = false;
+  }
+  return ok;
+}
+
+int main() {
+  bool ok = true;
+  unsigned long dropped;
+  size_t skipped;
+
+  TxBuffer fast(115200);
+  run(fast, 120000);
+  ok = check("115200 baud", fast.sent.data(), fast.sent.size(), dropped, skipped) && ok;
+  if(dropped || skipped || able::Telemetry::dropped() || fast.overrun()) {
+    printf("FAIL: events dropped at 115200 baud\n");
+    ok = false;
+  }
+
+  // 600 baud sends 60 bytes per second, too slow for bursts of events.
+  TxBuffer slow(600);
+  run(slow, 120000);
+  ok = check("600 baud", slow.sent.data(), slow.sent.size(), dropped, skipped) && ok;
+  if(!dropped || slow.overrun()) {
+    printf("FAIL: dropped events not counted, or sending waited for the buffer\n");
+    ok = false;
+  }
+
+  // Corrupt the fast stream: insert noise between frames and break frames.
+  std::vector<uint8_t> noisy;
+  size_t broken = 0;
+  for(size_t i = 0; i < fast.sent.size(); i += able::Telemetry::FRAME_SIZE) {
+    if(i % 80 == 0) {
+      noisy.push_back(able::Telemetry::SYNC);
+      noisy.push_back((uint8_t) rnd.next(256));
+    }
+    for(size_t j = i; j < i + able::Telemetry::FRAME_SIZE; ++j) noisy.push_back(fast.sent[j]);
+    if(i % 136 == 0) {
+      noisy[noisy.size() - 1 - rnd.next(7)] ^= 0x10; // Invalid check byte.
+      ++broken;
+    }
+  }
+  able::TelemetryReader reader(noisy.data(), noisy.size());
+  size_t frames = 0;
+  uint8_t event, id;
+  unsigned long value;
+  while(reader.next(event, id, value)) ++frames;
+  printf("corrupted: frames=%zu broken=%zu skipped=%zu\n", frames, broken, reader.skipped());
+  if(frames != fast.sent.size() / able::Telemetry::FRAME_SIZE - broken) {
+    printf("FAIL: frames lost after corrupt bytes\n");
+    ok = false;
+  }
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+/**
+ * @file TimedEvents.cpp Test of choosing the timed events of callback
+ * buttons. Generated taps and holds are pressed on callback buttons sending
+ * all, only held, only idle and no timed events, with the timer and
+ * integrator debouncers. The test fails unless:
+ *
+ * - each button gives the same events, at the same times, as the button
+ *   sending all timed events, less the events it does not send;
+ * - a button sending no timed events, with the integrator debouncer, only
+ *   reads the clock when it changes;
+ * - the same button timed by the UntimedClock gives the same events, with a
+ *   smaller pin.
+ *
+ * It also reports the bytes, clock readings and time per handle() of the
+ * integrator buttons sending all and no timed events, and on the
+ * UntimedClock.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <time.h>
+#include <vector>
+#include <AbleButtons.h>
+#include "Fixtures.h"
+
+using E = able::CallbackEvents;
+
+const unsigned long RUN_MILLIS = 300000; ///< How long to run (ms).
+const unsigned long COST_HANDLES = 2000000; ///< Handles timed by cost().
+
+using CountingClock = host::CountingClock<>; ///< Clock counting how often it is read.
+
+/**
+ * An event of a button.
+ */
+struct Event {
+  unsigned long millis; ///< When the event occurred.
+  uint8_t event; ///< The event.
+  bool operator!=(const Event &e) const { return millis != e.millis || event != e.event; } ///< Compare events.
+};
+
+std::vector<Event> events[4]; ///< Events of the buttons sending all, held, idle and no timed events.
+host::Random rnd(1984); ///< Pseudo-random sequence, so every run is the same.
+
+void onEvent(E::CALLBACK_EVENT event, able::ButtonId id) {
+  events[id].push_back(Event{millis(), (uint8_t) event});
+}
+
+/**
+ * Integrator callback button timed by a clock, sending some timed events.
+ */
+template <typename Clock, uint8_t TIMED>
+using CostButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DebouncedPin<able::NoCounters, able::IntegratorDebouncer<>, Clock>>, able::UntimedCallback, TIMED>;
+
+/**
+ * Handle a button with generated bouncing presses, one handle() a
+ * millisecond, and report what each handle() costs.
+ *
+ * @param Clock The clock class of the button.
+ * @param TIMED The timed events the button sends.
+ * @param name The name of the button.
+ * @param id The id of the button, where its events are recorded.
+ */
+template <typename Clock, uint8_t TIMED>
+void cost(const char *name, uint8_t id) {
+  CostButton<Clock, TIMED> button(8, onEvent, id);
+  host::Random bounce(68000);
+  unsigned long nextChange = 1000, start = CountingClock::reads;
+  bool pressed = false;
+
+  host::setPin(8, HIGH);
+  events[id].clear();
+  button.begin();
+  clock_t started = clock();
+  for(unsigned long t = 1; t <= COST_HANDLES; ++t) {
+    host::setMillis(500000 + t);
+    if(t >= nextChange) {
+      pressed = !pressed;
+      nextChange = t + 50 + bounce.next(500);
+    }
+    host::setPin(8, (pressed ? LOW : HIGH) ^ (t + 4 < nextChange && bounce.next(8) == 0));
+    button.handle();
+  }
+  double ns = 1e9 * (clock() - started) / CLOCKS_PER_SEC / COST_HANDLES;
+  printf("cost: %s: bytes=%zu clock reads per handle=%.3f ns per handle=%.1f\n", name, sizeof(button),
+    (double)(CountingClock::reads - start) / COST_HANDLES, ns);
+}
+
+/**
+ * Run buttons sending all, held, idle and no timed events with the same
+ * generated presses, then compare their events.
+ *
+ * @param Pin The pin class of the buttons.
+ * @param name The name of the run.
+ *
+ * @return True if the events match, else false.
+ */
+template <typename Pin>
+bool run(const char *name) {
+  typedef able::Button<able::PullupResistorCircuit, Pin> Button;
+  able::CallbackButton<Button> all(2, onEvent, 0);
+  able::CallbackButton<Button, able::UntimedCallback, E::HELD_EVENTS> held(3, onEvent, 1);
+  able::CallbackButton<Button, able::UntimedCallback, E::IDLE_EVENTS> idle(4, onEvent, 2);
+  able::CallbackButton<Button, able::UntimedCallback, E::NO_TIMED_EVENTS> none(5, onEvent, 3);
+  bool pressed = false, ok = true;
+  unsigned long nextChange = 2000;
+  static const uint8_t sent[4] = {E::ALL_TIMED_EVENTS, E::HELD_EVENTS, E::IDLE_EVENTS, E::NO_TIMED_EVENTS};
+
+  Button::setIdleTime(5000);
+  host::setMillis(1000);
+  for(uint8_t pin = 2; pin < 6; ++pin) host::setPin(pin, HIGH);
+  for(uint8_t i = 0; i < 4; ++i) events[i].clear();
+  all.begin();
+  held.begin();
+  idle.begin();
+  none.begin();
+
+  for(unsigned long t = 1; t <= RUN_MILLIS; ++t) {
+    host::setMillis(1000 + t);
+    if(millis() >= nextChange) {
+      pressed = !pressed;
+      nextChange = millis() + (pressed ? 60 + rnd.next(rnd.next(3) ? 300 : 2000) : 60 + rnd.next(rnd.next(3) ? 300 : 8000));
+    }
+    for(uint8_t pin = 2; pin < 6; ++pin) host::setPin(pin, pressed ? LOW : HIGH);
+    all.handle();
+    held.handle();
+    idle.handle();
+    none.handle();
+  }
+
+  for(uint8_t i = 1; i < 4; ++i) {
+    std::vector<Event> expected;
+    for(size_t j = 0; j < events[0].size(); ++j) {
+      uint8_t event = events[0][j].event;
+      if(event == E::HELD_EVENT && !(sent[i] & E::HELD_EVENTS)) continue;
+      if(event == E::IDLE_EVENT && !(sent[i] & E::IDLE_EVENTS)) continue;
+      expected.push_back(events[0][j]);
+    }
+    bool same = expected.size() == events[i].size();
+    for(size_t j = 0; same && j < expected.size(); ++j) same = !(expected[j] != events[i][j]);
+    printf("%s: timed events %u: events=%zu expected=%zu\n", name, sent[i], events[i].size(), expected.size());
+    if(!same) {
+      printf("FAIL: %s: events of a button sending timed events %u wrong\n", name, sent[i]);
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+int main() {
+  bool ok = true;
+
+  ok = run<able::DebouncedPin<>>("timer") && ok;
+  ok = run<able::DebouncedPin<able::NoCounters, able::IntegratorDebouncer<>>>("integrator") && ok;
+
+  // Clock readings of pressed integrator buttons, waiting to be held.
+  typedef able::Button<able::PullupResistorCircuit, able::DebouncedPin<able::NoCounters, able::IntegratorDebouncer<>, CountingClock>> Button;
+  able::CallbackButton<Button> all(6, onEvent, 0);
+  able::CallbackButton<Button, able::UntimedCallback, E::NO_TIMED_EVENTS> none(7, onEvent, 3);
+  host::setPin(6, LOW);
+  host::setPin(7, LOW);
+  all.begin();
+  none.begin();
+  CountingClock::reads = 0;
+  for(int t = 0; t < 500; ++t) { host::setMillis(400000 + t); all.handle(); }
+  unsigned long allReads = CountingClock::reads;
+  CountingClock::reads = 0;
+  for(int t = 0; t < 500; ++t) { host::setMillis(400000 + t); none.handle(); }
+  unsigned long noneReads = CountingClock::reads;
+  printf("clock reads while pressed: all=%lu none=%lu\n", allReads, noneReads);
+  if(noneReads > 1) { // Only when pressed.
+    printf("FAIL: button sending no timed events reads the clock while not changing\n");
+    ok = false;
+  }
+
+  // What handle() costs, with and without timed events and a clock.
+  cost<CountingClock, E::ALL_TIMED_EVENTS>("all timed events", 0);
+  cost<CountingClock, E::NO_TIMED_EVENTS>("no timed events", 1);
+  cost<able::UntimedClock, E::NO_TIMED_EVENTS>("untimed clock", 2);
+  typedef able::DebouncedPin<able::NoCounters, able::IntegratorDebouncer<>> TimedPin;
+  typedef able::DebouncedPin<able::NoCounters, able::IntegratorDebouncer<>, able::UntimedClock> UntimedPin;
+  bool same = events[1].size() == events[2].size() && events[1].size() > 1000;
+  for(size_t j = 0; same && j < events[1].size(); ++j) same = !(events[1][j] != events[2][j]);
+  printf("untimed clock: events=%zu expected=%zu pin bytes=%zu timed=%zu\n", events[2].size(), events[1].size(),
+    sizeof(able::Button<able::PullupResistorCircuit, UntimedPin>), sizeof(able::Button<able::PullupResistorCircuit, TimedPin>));
+  if(!same || sizeof(able::Button<able::PullupResistorCircuit, UntimedPin>) >= sizeof(able::Button<able::PullupResistorCircuit, TimedPin>)) {
+    printf("FAIL: untimed clock button differs from the button sending no timed events\n");
+    ok = false;
+  }
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
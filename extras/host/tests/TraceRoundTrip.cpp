@@ -0,0 +1,202 @@
+/**
+ * @file TraceRoundTrip.cpp Record-and-replay test of pin traces. Two buttons
+ * with able::TraceRecorder pins are driven live by generated bouncing taps,
+ * holds and double-clicks, recording a trace to memory. The trace is then
+ * replayed through the same button type. The test fails unless the replay
+ * gives exactly the same events as the live run, and a corrupt record ends a
+ * trace. It also reports how fast a long trace replays.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <time.h>
+#include <algorithm>
+#include <vector>
+#include "Fixtures.h"
+#include "Replayer.h"
+
+using LiveButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<able::TraceRecorder<>>>>>;
+using ReplayButton = AblePullupCallbackDoubleClickerButton;
+
+//
+// Recorded trace and events...
+//
+
+/**
+ * Print stream recording a trace in memory.
+ */
+class TraceBuffer: public Print {
+  public:
+    using Print::write;
+    size_t write(uint8_t c) override { data.push_back(c); return 1; } ///< Append a byte to the trace.
+    std::vector<uint8_t> data; ///< The trace.
+};
+
+/**
+ * An event of a button.
+ */
+struct Event {
+  unsigned long millis; ///< When the event occurred.
+  uint8_t pin; ///< The pin of the button.
+  uint8_t event; ///< The event.
+  bool operator!=(const Event &e) const { return millis != e.millis || pin != e.pin || event != e.event; } ///< Compare events.
+};
+
+TraceBuffer trace; ///< The trace recorded by the live run.
+std::vector<Event> liveEvents; ///< Events of the live run.
+std::vector<Event> replayEvents; ///< Events of the replay.
+unsigned long replayCount = 0; ///< Events counted by the soak replay.
+
+void onLiveEvent(able::CallbackEvents::CALLBACK_EVENT event, uint8_t pin) {
+  if(event != able::CallbackEvents::BEGIN_EVENT) liveEvents.push_back(Event{millis(), pin, (uint8_t) event});
+}
+
+void onReplayEvent(unsigned long ms, uint8_t pin, able::CallbackEvents::CALLBACK_EVENT event) {
+  if(event != able::CallbackEvents::BEGIN_EVENT) replayEvents.push_back(Event{ms, pin, (uint8_t) event});
+}
+
+void onSoakEvent(unsigned long, uint8_t, able::CallbackEvents::CALLBACK_EVENT) {
+  ++replayCount;
+}
+
+//
+// Generated signal...
+//
+
+/**
+ * A scheduled change of a pin.
+ */
+struct Change {
+  unsigned long millis; ///< When the pin changes.
+  uint8_t pin; ///< The pin.
+  uint8_t level; ///< The new level of the pin.
+};
+
+host::Random rnd(4242); ///< Pseudo-random sequence, so every run is the same.
+
+/**
+ * Schedule a bouncing change of a pin.
+ *
+ * @param changes The schedule to add to.
+ * @param ms When the pin starts to change (updated to when it settles).
+ * @param pin The pin.
+ * @param level The new level of the pin.
+ */
+void change(std::vector<Change> &changes, unsigned long &ms, uint8_t pin, uint8_t level) {
+  for(unsigned long b = rnd.next(6); b; --b) {
+    changes.push_back(Change{ms, pin, level});
+    ms += 1 + rnd.next(2);
+    changes.push_back(Change{ms, pin, (uint8_t) !level});
+    ms += 1 + rnd.next(2);
+  }
+  changes.push_back(Change{ms, pin, level});
+}
+
+/**
+ * Generate bouncing taps, holds and double-clicks on a pin.
+ *
+ * @param changes The schedule to add to.
+ * @param pin The pin.
+ * @param ms When to start.
+ * @param gestures The number of gestures.
+ */
+void generate(std::vector<Change> &changes, uint8_t pin, unsigned long ms, unsigned long gestures) {
+  while(gestures--) {
+    switch(rnd.next(3)) {
+      case 0: // Tap.
+        change(changes, ms, pin, LOW); ms += 30 + rnd.next(200);
+        change(changes, ms, pin, HIGH);
+        break;
+
+      case 1: // Hold.
+        change(changes, ms, pin, LOW); ms += 900 + rnd.next(400);
+        change(changes, ms, pin, HIGH);
+        break;
+
+      default: // Double-click (sometimes too slow).
+        change(changes, ms, pin, LOW); ms += 40 + rnd.next(100);
+        change(changes, ms, pin, HIGH); ms += 40 + rnd.next(250);
+        change(changes, ms, pin, LOW); ms += 40 + rnd.next(100);
+        change(changes, ms, pin, HIGH);
+        break;
+    }
+    ms += 100 + rnd.next(1500);
+  }
+}
+
+int main() {
+  const uint8_t PINS[] = {2, 5};
+  std::vector<Change> changes;
+  bool ok = true;
+
+  for(uint8_t p = 0; p < 2; ++p) {
+    host::setPin(PINS[p], HIGH);
+    generate(changes, PINS[p], 1100, 500);
+  }
+  std::stable_sort(changes.begin(), changes.end(), [](const Change &a, const Change &b) { return a.millis < b.millis; });
+
+  // Live run, recording the trace.
+  host::setMillis(1000);
+  LiveButton btnA(PINS[0], onLiveEvent, PINS[0]);
+  LiveButton btnB(PINS[1], onLiveEvent, PINS[1]);
+  btnA.begin();
+  btnB.begin();
+  able::Trace::begin(trace);
+  size_t next = 0;
+  for(unsigned long ms = 1000; ms < changes.back().millis + 2000; ++ms) {
+    host::setMillis(ms);
+    for(; next < changes.size() && changes[next].millis == ms; ++next) host::setPin(changes[next].pin, changes[next].level);
+    btnA.handle();
+    btnB.handle();
+  }
+  able::Trace::end();
+
+  // Replay the trace through a fresh button of each pin.
+  host::Replayer<ReplayButton> replayer(onReplayEvent, 1000, 2000);
+  long records = replayer.replay(trace.data.data(), trace.data.size());
+
+  printf("changes=%zu records=%ld bytes=%zu (%.2f per record) live=%zu replay=%zu events\n",
+    changes.size(), records, trace.data.size(), records > 0 ? (double)(trace.data.size() - 9) / records : 0.0,
+    liveEvents.size(), replayEvents.size());
+  if(records <= 0) {
+    printf("FAIL: trace not recorded\n");
+    ok = false;
+  }
+  if(liveEvents.size() != replayEvents.size()) {
+    printf("FAIL: replay gave %zu events, live run gave %zu\n", replayEvents.size(), liveEvents.size());
+    ok = false;
+  }
+  for(size_t i = 0; i < liveEvents.size() && i < replayEvents.size(); ++i) {
+    if(liveEvents[i] != replayEvents[i]) {
+      printf("FAIL: event %zu live %lu %u %s, replay %lu %u %s\n", i,
+        liveEvents[i].millis, liveEvents[i].pin, host::eventName((able::CallbackEvents::CALLBACK_EVENT) liveEvents[i].event),
+        replayEvents[i].millis, replayEvents[i].pin, host::eventName((able::CallbackEvents::CALLBACK_EVENT) replayEvents[i].event));
+      ok = false;
+      break;
+    }
+  }
+
+  // A corrupt record, with a varint too long for a timestamp, ends the trace.
+  std::vector<uint8_t> corrupt(trace.data.begin(), trace.data.begin() + 9);
+  corrupt.push_back(2);
+  corrupt.insert(corrupt.end(), 12, 0xFF);
+  corrupt.push_back(0x01);
+  able::TraceReader reader(corrupt.data(), corrupt.size());
+  uint8_t pin, level;
+  unsigned long changeMicros;
+  if(!reader.isValid() || reader.next(pin, level, changeMicros)) {
+    printf("FAIL: corrupt record read\n");
+    ok = false;
+  }
+
+  // Soak replay of a long trace (the recorded trace repeated), for speed.
+  std::vector<uint8_t> soak(trace.data.begin(), trace.data.end());
+  for(int i = 0; i < 50; ++i) soak.insert(soak.end(), trace.data.begin() + 9, trace.data.end());
+  host::Replayer<ReplayButton> soakReplayer(onSoakEvent, 1000, 2000);
+  clock_t start = clock();
+  long soakRecords = soakReplayer.replay(soak.data(), soak.size());
+  double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+  printf("soak: %ld records, %lu events in %.3fs (%.1fM records/s)\n", soakRecords, replayCount, secs, secs > 0 ? soakRecords / secs / 1e6 : 0.0);
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
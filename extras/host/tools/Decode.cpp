@@ -0,0 +1,112 @@
+/**
+ * @file Decode.cpp Command-line tool decoding a telemetry stream written by
+ * able::TelemetryCallback, printing each event with its timestamp and button
+ * id, or a summary of each button.
+ *
+ * Usage: `Decode [-s] [telemetry-file]`
+ *
+ * The stream is read from standard input if no file is given. Events are
+ * printed as `<time> <id> <EVENT>`, and dropped events as `DROPPED <count>`.
+ * With -s, the counts of each event, the press times (from each press to its
+ * release) and the dropped events are printed for each button instead.
+ *
+ * Streams sent with 16-bit button ids (see Ids.h) have larger frames, so
+ * build the tool with `-DABLE_BUTTON_ID_BITS=16` to decode them.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <vector>
+#include "Replayer.h"
+
+using E = able::CallbackEvents;
+
+/**
+ * Summary of the events of a button.
+ */
+struct Summary {
+  unsigned long counts[E::DOUBLE_CLICKED_EVENT + 1]; ///< Frames of each event.
+  unsigned long pressTime; ///< Time of the last press (if pressed).
+  bool pressed; ///< True between a press and its release.
+  unsigned long presses; ///< Press times measured.
+  unsigned long minPress; ///< Shortest press time.
+  unsigned long maxPress; ///< Longest press time.
+  double totalPress; ///< Sum of the press times.
+};
+
+/**
+ * Print how to use the tool and exit.
+ */
+void usage() {
+  fprintf(stderr, "Usage: Decode [-s] [telemetry-file]\n");
+  exit(2);
+}
+
+int main(int argc, char *argv[]) {
+  bool summary = false;
+  int arg = 1;
+  for(; arg < argc && argv[arg][0] == '-'; ++arg) {
+    if(!strcmp(argv[arg], "-s")) summary = true;
+    else usage();
+  }
+  if(arg + 1 < argc) usage();
+
+  FILE *in = arg < argc ? fopen(argv[arg], "rb") : stdin;
+  if(!in) {
+    perror(argv[arg]);
+    return 1;
+  }
+  std::vector<uint8_t> stream;
+  uint8_t buf[4096];
+  for(size_t n; (n = fread(buf, 1, sizeof(buf), in)) > 0;) stream.insert(stream.end(), buf, buf + n);
+
+  able::TelemetryReader reader(stream.data(), stream.size());
+  std::map<able::ButtonId, Summary> buttons;
+  unsigned long frames = 0, dropped = 0;
+  uint8_t event;
+  able::ButtonId id;
+  unsigned long value;
+  while(reader.next(event, id, value)) {
+    ++frames;
+    if(event == able::Telemetry::DROPPED) {
+      dropped += value;
+      if(!summary) printf("DROPPED %lu\n", value);
+      // The press or release of a button may have been dropped.
+      for(auto &b : buttons) b.second.pressed = false;
+      continue;
+    }
+    if(!summary) {
+      printf("%lu %u %s\n", value, id, host::eventName((E::CALLBACK_EVENT) event));
+      continue;
+    }
+
+    Summary &s = buttons.emplace(id, Summary()).first->second;
+    ++s.counts[event];
+    if(event == E::PRESSED_EVENT) {
+      s.pressTime = value;
+      s.pressed = true;
+    } else if(event == E::RELEASED_EVENT && s.pressed) {
+      unsigned long t = value - s.pressTime;
+      if(!s.presses || t < s.minPress) s.minPress = t;
+      if(t > s.maxPress) s.maxPress = t;
+      s.totalPress += t;
+      ++s.presses;
+      s.pressed = false;
+    }
+  }
+
+  if(summary) {
+    printf("%4s %8s %8s %8s %8s %8s %8s %9s %9s %9s\n", "id", "pressed", "released", "held", "idle", "single", "double", "min ms", "avg ms", "max ms");
+    for(const auto &b : buttons) {
+      const Summary &s = b.second;
+      printf("%4u %8lu %8lu %8lu %8lu %8lu %8lu", b.first, s.counts[E::PRESSED_EVENT], s.counts[E::RELEASED_EVENT], s.counts[E::HELD_EVENT],
+        s.counts[E::IDLE_EVENT], s.counts[E::SINGLE_CLICKED_EVENT], s.counts[E::DOUBLE_CLICKED_EVENT]);
+      if(s.presses) printf(" %9lu %9.1f %9lu\n", s.minPress, s.totalPress / s.presses, s.maxPress);
+      else printf(" %9s %9s %9s\n", "-", "-", "-");
+    }
+  }
+  fprintf(stderr, "%lu frames, %lu events dropped, %zu bytes skipped\n", frames, dropped, reader.skipped());
+  return 0;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file Replay.cpp Command-line tool replaying a pin trace recorded with
+ * able::TraceRecorder through an AbleButtons button type, printing each event
+ * with its timestamp and pin. Replays run on a virtual clock, so long soak
+ * captures replay in seconds and always give the same events.
+ *
+ * Usage: `Replay [-p poll-us] [-t tail-ms] [-q] <button-type> [trace-file]`
+ *
+ * The trace is read from standard input if no file is given. Events are
+ * printed as `<millis> <pin> <EVENT>`. Buttons without callbacks replay
+ * through the callback button with the same pin type, and timed callback
+ * buttons through the untimed one, as they give the same events. Direct
+ * buttons are not supported. With -q only the counts and speed are printed.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+#include "Replayer.h"
+
+//
+// Replay options...
+//
+
+unsigned long pollMicros = 1000; ///< Microseconds between handling buttons.
+unsigned long tailMillis = 2000; ///< Milliseconds to continue after the trace.
+bool quiet = false; ///< Count events rather than print them.
+unsigned long events = 0; ///< Number of events.
+
+/**
+ * Print (or count) an event.
+ *
+ * @param ms The timestamp of the event.
+ * @param pin The pin of the button.
+ * @param event The event.
+ */
+void printEvent(unsigned long ms, uint8_t pin, able::CallbackEvents::CALLBACK_EVENT event) {
+  ++events;
+  if(!quiet) printf("%lu %u %s\n", ms, pin, host::eventName(event));
+}
+
+/**
+ * Replay a trace through a button type.
+ *
+ * @param data The trace.
+ * @param size The size of the trace.
+ *
+ * @return The number of records replayed, or -1 if not a trace.
+ */
+template <typename Button>
+long replay(const uint8_t *data, size_t size) {
+  host::Replayer<Button> replayer(printEvent, pollMicros, tailMillis);
+  return replayer.replay(data, size);
+}
+
+/**
+ * Button type that can be replayed.
+ */
+struct ButtonType {
+  const char *name; ///< The name of the type in AbleButtons.h.
+  long (*replay)(const uint8_t *, size_t); ///< Replays a trace through the type.
+};
+
+#define ABLE_REPLAY(Name, Callback) {#Name, replay<Callback>} ///< Entry replaying Name through the Callback type.
+
+/**
+ * The button types that can be replayed.
+ */
+const ButtonType TYPES[] = {
+  ABLE_REPLAY(AblePulldownButton, AblePulldownCallbackButton),
+  ABLE_REPLAY(AblePulldownCallbackButton, AblePulldownCallbackButton),
+  ABLE_REPLAY(AblePulldownTimedCallbackButton, AblePulldownCallbackButton),
+  ABLE_REPLAY(AblePulldownDeferredCallbackButton, AblePulldownCallbackButton),
+  ABLE_REPLAY(AblePulldownClickerButton, AblePulldownCallbackClickerButton),
+  ABLE_REPLAY(AblePulldownCallbackClickerButton, AblePulldownCallbackClickerButton),
+  ABLE_REPLAY(AblePulldownTimedCallbackClickerButton, AblePulldownCallbackClickerButton),
+  ABLE_REPLAY(AblePulldownDeferredCallbackClickerButton, AblePulldownCallbackClickerButton),
+  ABLE_REPLAY(AblePulldownDoubleClickerButton, AblePulldownCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePulldownCallbackDoubleClickerButton, AblePulldownCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePulldownTimedCallbackDoubleClickerButton, AblePulldownCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePulldownDeferredCallbackDoubleClickerButton, AblePulldownCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePulldownEagerButton, AblePulldownEagerCallbackButton),
+  ABLE_REPLAY(AblePulldownEagerCallbackButton, AblePulldownEagerCallbackButton),
+  ABLE_REPLAY(AblePulldownEagerClickerButton, AblePulldownEagerCallbackClickerButton),
+  ABLE_REPLAY(AblePulldownEagerCallbackClickerButton, AblePulldownEagerCallbackClickerButton),
+  ABLE_REPLAY(AblePulldownEagerDoubleClickerButton, AblePulldownEagerCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePulldownEagerCallbackDoubleClickerButton, AblePulldownEagerCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePulldownIntegratorButton, AblePulldownIntegratorCallbackButton),
+  ABLE_REPLAY(AblePulldownIntegratorCallbackButton, AblePulldownIntegratorCallbackButton),
+  ABLE_REPLAY(AblePulldownIntegratorClickerButton, AblePulldownIntegratorCallbackClickerButton),
+  ABLE_REPLAY(AblePulldownIntegratorCallbackClickerButton, AblePulldownIntegratorCallbackClickerButton),
+  ABLE_REPLAY(AblePulldownIntegratorDoubleClickerButton, AblePulldownIntegratorCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePulldownIntegratorCallbackDoubleClickerButton, AblePulldownIntegratorCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePulldownPatternButton, AblePulldownPatternCallbackButton),
+  ABLE_REPLAY(AblePulldownPatternCallbackButton, AblePulldownPatternCallbackButton),
+  ABLE_REPLAY(AblePulldownPatternClickerButton, AblePulldownPatternCallbackClickerButton),
+  ABLE_REPLAY(AblePulldownPatternCallbackClickerButton, AblePulldownPatternCallbackClickerButton),
+  ABLE_REPLAY(AblePulldownPatternDoubleClickerButton, AblePulldownPatternCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePulldownPatternCallbackDoubleClickerButton, AblePulldownPatternCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePulldownMajorityButton, AblePulldownMajorityCallbackButton),
+  ABLE_REPLAY(AblePulldownMajorityCallbackButton, AblePulldownMajorityCallbackButton),
+  ABLE_REPLAY(AblePulldownMajorityClickerButton, AblePulldownMajorityCallbackClickerButton),
+  ABLE_REPLAY(AblePulldownMajorityCallbackClickerButton, AblePulldownMajorityCallbackClickerButton),
+  ABLE_REPLAY(AblePulldownMajorityDoubleClickerButton, AblePulldownMajorityCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePulldownMajorityCallbackDoubleClickerButton, AblePulldownMajorityCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePullupButton, AblePullupCallbackButton),
+  ABLE_REPLAY(AblePullupCallbackButton, AblePullupCallbackButton),
+  ABLE_REPLAY(AblePullupTimedCallbackButton, AblePullupCallbackButton),
+  ABLE_REPLAY(AblePullupDeferredCallbackButton, AblePullupCallbackButton),
+  ABLE_REPLAY(AblePullupClickerButton, AblePullupCallbackClickerButton),
+  ABLE_REPLAY(AblePullupCallbackClickerButton, AblePullupCallbackClickerButton),
+  ABLE_REPLAY(AblePullupTimedCallbackClickerButton, AblePullupCallbackClickerButton),
+  ABLE_REPLAY(AblePullupDeferredCallbackClickerButton, AblePullupCallbackClickerButton),
+  ABLE_REPLAY(AblePullupDoubleClickerButton, AblePullupCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePullupCallbackDoubleClickerButton, AblePullupCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePullupTimedCallbackDoubleClickerButton, AblePullupCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePullupDeferredCallbackDoubleClickerButton, AblePullupCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePullupEagerButton, AblePullupEagerCallbackButton),
+  ABLE_REPLAY(AblePullupEagerCallbackButton, AblePullupEagerCallbackButton),
+  ABLE_REPLAY(AblePullupEagerClickerButton, AblePullupEagerCallbackClickerButton),
+  ABLE_REPLAY(AblePullupEagerCallbackClickerButton, AblePullupEagerCallbackClickerButton),
+  ABLE_REPLAY(AblePullupEagerDoubleClickerButton, AblePullupEagerCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePullupEagerCallbackDoubleClickerButton, AblePullupEagerCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePullupIntegratorButton, AblePullupIntegratorCallbackButton),
+  ABLE_REPLAY(AblePullupIntegratorCallbackButton, AblePullupIntegratorCallbackButton),
+  ABLE_REPLAY(AblePullupIntegratorClickerButton, AblePullupIntegratorCallbackClickerButton),
+  ABLE_REPLAY(AblePullupIntegratorCallbackClickerButton, AblePullupIntegratorCallbackClickerButton),
+  ABLE_REPLAY(AblePullupIntegratorDoubleClickerButton, AblePullupIntegratorCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePullupIntegratorCallbackDoubleClickerButton, AblePullupIntegratorCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePullupPatternButton, AblePullupPatternCallbackButton),
+  ABLE_REPLAY(AblePullupPatternCallbackButton, AblePullupPatternCallbackButton),
+  ABLE_REPLAY(AblePullupPatternClickerButton, AblePullupPatternCallbackClickerButton),
+  ABLE_REPLAY(AblePullupPatternCallbackClickerButton, AblePullupPatternCallbackClickerButton),
+  ABLE_REPLAY(AblePullupPatternDoubleClickerButton, AblePullupPatternCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePullupPatternCallbackDoubleClickerButton, AblePullupPatternCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePullupMajorityButton, AblePullupMajorityCallbackButton),
+  ABLE_REPLAY(AblePullupMajorityCallbackButton, AblePullupMajorityCallbackButton),
+  ABLE_REPLAY(AblePullupMajorityClickerButton, AblePullupMajorityCallbackClickerButton),
+  ABLE_REPLAY(AblePullupMajorityCallbackClickerButton, AblePullupMajorityCallbackClickerButton),
+  ABLE_REPLAY(AblePullupMajorityDoubleClickerButton, AblePullupMajorityCallbackDoubleClickerButton),
+  ABLE_REPLAY(AblePullupMajorityCallbackDoubleClickerButton, AblePullupMajorityCallbackDoubleClickerButton),
+};
+
+/**
+ * Print how to use the tool and exit.
+ */
+void usage() {
+  fprintf(stderr, "Usage: Replay [-p poll-us] [-t tail-ms] [-q] <button-type> [trace-file]\n\nButton types:\n");
+  for(size_t i = 0; i < sizeof(TYPES) / sizeof(TYPES[0]); ++i) fprintf(stderr, "  %s\n", TYPES[i].name);
+  exit(2);
+}
+
+int main(int argc, char *argv[]) {
+  int arg = 1;
+  for(; arg < argc && argv[arg][0] == '-'; ++arg) {
+    if(!strcmp(argv[arg], "-p") && arg + 1 < argc) pollMicros = strtoul(argv[++arg], 0, 10);
+    else if(!strcmp(argv[arg], "-t") && arg + 1 < argc) tailMillis = strtoul(argv[++arg], 0, 10);
+    else if(!strcmp(argv[arg], "-q")) quiet = true;
+    else usage();
+  }
+  if(arg >= argc) usage();
+
+  const ButtonType *type = 0;
+  for(size_t i = 0; i < sizeof(TYPES) / sizeof(TYPES[0]); ++i) {
+    if(!strcmp(argv[arg], TYPES[i].name)) type = &TYPES[i];
+  }
+  if(!type) usage();
+
+  FILE *in = arg + 1 < argc ? fopen(argv[arg + 1], "rb") : stdin;
+  if(!in) {
+    perror(argv[arg + 1]);
+    return 1;
+  }
+  std::vector<uint8_t> trace;
+  uint8_t buf[4096];
+  for(size_t n; (n = fread(buf, 1, sizeof(buf), in)) > 0;) trace.insert(trace.end(), buf, buf + n);
+
+  clock_t start = clock();
+  long records = type->replay(trace.data(), trace.size());
+  double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+  if(records < 0) {
+    fprintf(stderr, "Not a trace (expected an ABLT version %u header)\n", able::Trace::VERSION);
+    return 1;
+  }
+
+  fprintf(stderr, "%ld records, %lu events in %.3fs (%.1fM records/s)\n", records, events, secs, secs > 0 ? records / secs / 1e6 : 0.0);
+  return 0;
+}
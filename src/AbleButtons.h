@@ -18,7 +18,16 @@
 #pragma once
 #include "Button.h"
 #include "ButtonList.h"
+#include "ButtonArray.h"
 #include "CallbackButton.h"
+#include "HeldLevels.h"
+#include "Telemetry.h"
+#include "Awaitables.h"
+#include "Scheduled.h"
+#include "IdleList.h"
+#include "IsrList.h"
+#include "Tables.h"
+#include "Encoder.h"
 
 //
 // Pulldown buttons...
@@ -29,7 +38,7 @@
  * connected using pulldown resistor circuits. Button presses are debounced to
  * provide a reliable push/released signal.
  */
-using AblePulldownButton = able::Button<able::PulldownResistorCircuit, able::DebouncedPin>;
+using AblePulldownButton = able::Button<able::PulldownResistorCircuit, able::DebouncedPin<>>;
 
 /**
  * AblePulldownCallbackButton extends the basic debouced button with callbacks
@@ -39,7 +48,7 @@ using AblePulldownButton = able::Button<able::PulldownResistorCircuit, able::Deb
  * pointer to the button generating the callback. Similarly, when the button is
  * released, a user-supplied on-released function can be called.  
  */
-using AblePulldownCallbackButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DebouncedPin>>; ///< Shorthand for a callback button using a pulldown resistor.
+using AblePulldownCallbackButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DebouncedPin<>>>; ///< Shorthand for a callback button using a pulldown resistor.
 
 /**
  * AblePulldownClickerButton provides additional button-click capability to the
@@ -47,7 +56,7 @@ using AblePulldownCallbackButton = able::CallbackButton<able::Button<able::Pulld
  * followed by a button-release. As with basic button capabilities, button
  * presses are debounced to provide a reliable push/released signal.
  */
-using AblePulldownClickerButton = able::Button<able::PulldownResistorCircuit, able::ClickerPin>;
+using AblePulldownClickerButton = able::Button<able::PulldownResistorCircuit, able::ClickerPin<>>;
 
 /**
  * AblePulldownCallbackClickerButton provides callback capability to a clicker
@@ -61,7 +70,7 @@ using AblePulldownClickerButton = able::Button<able::PulldownResistorCircuit, ab
  * button capabilities, button presses are debounced to provide a reliable push/
  * released signal.
  */
-using AblePulldownCallbackClickerButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::ClickerPin>>;
+using AblePulldownCallbackClickerButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::ClickerPin<>>>;
 
 /**
  * AblePulldownDirectButton provides basic button is-pressed capability for
@@ -78,7 +87,7 @@ using AblePulldownDirectButton = able::Button<able::PulldownResistorCircuit, abl
  * click time. As with other button capabilities, button presses are debounced
  * to provide a reliable push/released signal.
  */
-using AblePulldownDoubleClickerButton = able::Button<able::PulldownResistorCircuit, able::DoubleClickerPin>;
+using AblePulldownDoubleClickerButton = able::Button<able::PulldownResistorCircuit, able::DoubleClickerPin<>>;
 
 /**
  * AblePulldownCallbackDoubleClickerButton provides additional double-click
@@ -87,7 +96,55 @@ using AblePulldownDoubleClickerButton = able::Button<able::PulldownResistorCircu
  * the double-click time. As with other button capabilities, button presses are
  * debounced to provide a reliable push/released signal.
  */
-using AblePulldownCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DoubleClickerPin>>>;
+using AblePulldownCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DoubleClickerPin<>>>>;
+
+/**
+ * AblePulldownTimedCallbackButton extends the AblePulldownCallbackButton by passing
+ * the timing of each event to the callback function. The callback function
+ * receives an able::EventTiming argument holding the debounced edge timestamp
+ * and how long the button was pressed or released.
+ */
+using AblePulldownTimedCallbackButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DebouncedPin<>>, able::TimedCallback<>>;
+
+/**
+ * AblePulldownTimedCallbackClickerButton extends the AblePulldownCallbackClickerButton
+ * by passing the timing of each event to the callback function. The callback
+ * function receives an able::EventTiming argument holding the debounced edge
+ * timestamp and how long the button was pressed or released.
+ */
+using AblePulldownTimedCallbackClickerButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::ClickerPin<>>, able::TimedCallback<>>;
+
+/**
+ * AblePulldownTimedCallbackDoubleClickerButton extends the
+ * AblePulldownCallbackDoubleClickerButton by passing the timing of each event to
+ * the callback function. The callback function receives an able::EventTiming
+ * argument holding the debounced edge timestamp, how long the button was
+ * pressed or released and, for click events, the inter-click interval.
+ */
+using AblePulldownTimedCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DoubleClickerPin<>>, able::TimedCallback<>>>;
+
+/**
+ * AblePulldownDeferredCallbackButton extends the AblePulldownCallbackButton by
+ * queueing events in handle() and calling the callback function later, from
+ * able::DeferredCallback<>::dispatch(). A slow callback function then does not
+ * delay handling other buttons.
+ */
+using AblePulldownDeferredCallbackButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DebouncedPin<>>, able::DeferredCallback<>>;
+
+/**
+ * AblePulldownDeferredCallbackClickerButton extends the
+ * AblePulldownCallbackClickerButton by queueing events in handle() and calling
+ * the callback function later, from able::DeferredCallback<>::dispatch().
+ */
+using AblePulldownDeferredCallbackClickerButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::ClickerPin<>>, able::DeferredCallback<>>;
+
+/**
+ * AblePulldownDeferredCallbackDoubleClickerButton extends the
+ * AblePulldownCallbackDoubleClickerButton by queueing events in handle() and
+ * calling the callback function later, from
+ * able::DeferredCallback<>::dispatch().
+ */
+using AblePulldownDeferredCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DoubleClickerPin<>>, able::DeferredCallback<>>>;
 
 //
 // Pulldown button lists...
@@ -163,6 +220,60 @@ using AblePulldownDoubleClickerButtonList = able::ButtonList<AblePulldownDoubleC
  */
 using AblePulldownCallbackDoubleClickerButtonList = able::ButtonList<AblePulldownCallbackDoubleClickerButton>;
 
+/**
+ * AblePulldownTimedCallbackButtonList allows an array of AblePulldownTimedCallbackButton
+ * objects to be managed together. Rather than calling begin() and handle()
+ * methods for each button, call the begin() and handle() method of the button
+ * list object, which calls the begin() and handle() methods of each button in
+ * the list. 
+ */
+using AblePulldownTimedCallbackButtonList = able::ButtonList<AblePulldownTimedCallbackButton>;
+
+/**
+ * AblePulldownTimedCallbackClickerButtonList allows an array of AblePulldownTimedCallbackClickerButton
+ * objects to be managed together. Rather than calling begin() and handle()
+ * methods for each button, call the begin() and handle() method of the button
+ * list object, which calls the begin() and handle() methods of each button in
+ * the list. 
+ */
+using AblePulldownTimedCallbackClickerButtonList = able::ButtonList<AblePulldownTimedCallbackClickerButton>;
+
+/**
+ * AblePulldownTimedCallbackDoubleClickerButtonList allows an array of AblePulldownTimedCallbackDoubleClickerButton
+ * objects to be managed together. Rather than calling begin() and handle()
+ * methods for each button, call the begin() and handle() method of the button
+ * list object, which calls the begin() and handle() methods of each button in
+ * the list. 
+ */
+using AblePulldownTimedCallbackDoubleClickerButtonList = able::ButtonList<AblePulldownTimedCallbackDoubleClickerButton>;
+
+/**
+ * AblePulldownDeferredCallbackButtonList allows an array of
+ * AblePulldownDeferredCallbackButton objects to be managed together. Rather
+ * than calling begin() and handle() methods for each button, call the begin()
+ * and handle() method of the button list object, which calls the begin() and
+ * handle() methods of each button in the list. 
+ */
+using AblePulldownDeferredCallbackButtonList = able::ButtonList<AblePulldownDeferredCallbackButton>;
+
+/**
+ * AblePulldownDeferredCallbackClickerButtonList allows an array of
+ * AblePulldownDeferredCallbackClickerButton objects to be managed together. Rather
+ * than calling begin() and handle() methods for each button, call the begin()
+ * and handle() method of the button list object, which calls the begin() and
+ * handle() methods of each button in the list. 
+ */
+using AblePulldownDeferredCallbackClickerButtonList = able::ButtonList<AblePulldownDeferredCallbackClickerButton>;
+
+/**
+ * AblePulldownDeferredCallbackDoubleClickerButtonList allows an array of
+ * AblePulldownDeferredCallbackDoubleClickerButton objects to be managed together. Rather
+ * than calling begin() and handle() methods for each button, call the begin()
+ * and handle() method of the button list object, which calls the begin() and
+ * handle() methods of each button in the list. 
+ */
+using AblePulldownDeferredCallbackDoubleClickerButtonList = able::ButtonList<AblePulldownDeferredCallbackDoubleClickerButton>;
+
 //
 // Pull-up buttons...
 //
@@ -172,7 +283,7 @@ using AblePulldownCallbackDoubleClickerButtonList = able::ButtonList<AblePulldow
  * connected using pull-up resistor circuits. Button presses are debounced to
  * provide a reliable push/released signal.
  */
-using AblePullupButton = able::Button<able::PullupResistorCircuit, able::DebouncedPin>;
+using AblePullupButton = able::Button<able::PullupResistorCircuit, able::DebouncedPin<>>;
 
 /**
  * AblePullupCallbackButton extends the basic debouced button with callbacks
@@ -182,7 +293,7 @@ using AblePullupButton = able::Button<able::PullupResistorCircuit, able::Debounc
  * pointer to the button generating the callback. Similarly, when the button is
  * released, a user-supplied on-released function can be called.  
  */
-using AblePullupCallbackButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DebouncedPin>>; ///< Shorthand for a callback button using a pulldown resistor.
+using AblePullupCallbackButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DebouncedPin<>>>; ///< Shorthand for a callback button using a pulldown resistor.
 
 /**
  * AblePullupClickerButton provides additional button-click capability to the
@@ -190,7 +301,7 @@ using AblePullupCallbackButton = able::CallbackButton<able::Button<able::PullupR
  * followed by a button-release. As with basic button capabilities, button
  * presses are debounced to provide a reliable push/released signal.
  */
-using AblePullupClickerButton = able::Button<able::PullupResistorCircuit, able::ClickerPin>;
+using AblePullupClickerButton = able::Button<able::PullupResistorCircuit, able::ClickerPin<>>;
 
 /**
  * AblePullupCallbackClickerButton provides callback capability to a clicker
@@ -204,7 +315,7 @@ using AblePullupClickerButton = able::Button<able::PullupResistorCircuit, able::
  * button capabilities, button presses are debounced to provide a reliable push/
  * released signal.
  */
-using AblePullupCallbackClickerButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::ClickerPin>>; ///< Shorthand for clicker using pulldown resistor circuit.
+using AblePullupCallbackClickerButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::ClickerPin<>>>; ///< Shorthand for clicker using pulldown resistor circuit.
 
 /**
  * AblePullupDirectButton provides basic button is-pressed capability for
@@ -221,7 +332,7 @@ using AblePullupDirectButton = able::Button<able::PullupResistorCircuit, able::P
  * click time. As with other button capabilities, button presses are debounced
  * to provide a reliable push/released signal.
  */
-using AblePullupDoubleClickerButton = able::Button<able::PullupResistorCircuit, able::DoubleClickerPin>;
+using AblePullupDoubleClickerButton = able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<>>;
 
 /**
  * AblePullupCallbackDoubleClickerButton provides additional double-click capability to
@@ -230,7 +341,55 @@ using AblePullupDoubleClickerButton = able::Button<able::PullupResistorCircuit,
  * click time. As with other button capabilities, button presses are debounced
  * to provide a reliable push/released signal.
  */
-using AblePullupCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DoubleClickerPin>>>;
+using AblePullupCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<>>>>;
+
+/**
+ * AblePullupTimedCallbackButton extends the AblePullupCallbackButton by passing
+ * the timing of each event to the callback function. The callback function
+ * receives an able::EventTiming argument holding the debounced edge timestamp
+ * and how long the button was pressed or released.
+ */
+using AblePullupTimedCallbackButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DebouncedPin<>>, able::TimedCallback<>>;
+
+/**
+ * AblePullupTimedCallbackClickerButton extends the AblePullupCallbackClickerButton
+ * by passing the timing of each event to the callback function. The callback
+ * function receives an able::EventTiming argument holding the debounced edge
+ * timestamp and how long the button was pressed or released.
+ */
+using AblePullupTimedCallbackClickerButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::ClickerPin<>>, able::TimedCallback<>>;
+
+/**
+ * AblePullupTimedCallbackDoubleClickerButton extends the
+ * AblePullupCallbackDoubleClickerButton by passing the timing of each event to
+ * the callback function. The callback function receives an able::EventTiming
+ * argument holding the debounced edge timestamp, how long the button was
+ * pressed or released and, for click events, the inter-click interval.
+ */
+using AblePullupTimedCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<>>, able::TimedCallback<>>>;
+
+/**
+ * AblePullupDeferredCallbackButton extends the AblePullupCallbackButton by
+ * queueing events in handle() and calling the callback function later, from
+ * able::DeferredCallback<>::dispatch(). A slow callback function then does not
+ * delay handling other buttons.
+ */
+using AblePullupDeferredCallbackButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DebouncedPin<>>, able::DeferredCallback<>>;
+
+/**
+ * AblePullupDeferredCallbackClickerButton extends the
+ * AblePullupCallbackClickerButton by queueing events in handle() and calling
+ * the callback function later, from able::DeferredCallback<>::dispatch().
+ */
+using AblePullupDeferredCallbackClickerButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::ClickerPin<>>, able::DeferredCallback<>>;
+
+/**
+ * AblePullupDeferredCallbackDoubleClickerButton extends the
+ * AblePullupCallbackDoubleClickerButton by queueing events in handle() and
+ * calling the callback function later, from
+ * able::DeferredCallback<>::dispatch().
+ */
+using AblePullupDeferredCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<>>, able::DeferredCallback<>>>;
 
 //
 // Pull-up button lists...
@@ -296,3 +455,354 @@ using AblePullupDoubleClickerButtonList = able::ButtonList<AblePullupDoubleClick
  * handle() methods of each button in the list. 
  */
 using AblePullupCallbackDoubleClickerButtonList = able::ButtonList<AblePullupCallbackDoubleClickerButton>;
+
+/**
+ * AblePullupTimedCallbackButtonList allows an array of AblePullupTimedCallbackButton
+ * objects to be managed together. Rather than calling begin() and handle()
+ * methods for each button, call the begin() and handle() method of the button
+ * list object, which calls the begin() and handle() methods of each button in
+ * the list. 
+ */
+using AblePullupTimedCallbackButtonList = able::ButtonList<AblePullupTimedCallbackButton>;
+
+/**
+ * AblePullupTimedCallbackClickerButtonList allows an array of AblePullupTimedCallbackClickerButton
+ * objects to be managed together. Rather than calling begin() and handle()
+ * methods for each button, call the begin() and handle() method of the button
+ * list object, which calls the begin() and handle() methods of each button in
+ * the list. 
+ */
+using AblePullupTimedCallbackClickerButtonList = able::ButtonList<AblePullupTimedCallbackClickerButton>;
+
+/**
+ * AblePullupTimedCallbackDoubleClickerButtonList allows an array of AblePullupTimedCallbackDoubleClickerButton
+ * objects to be managed together. Rather than calling begin() and handle()
+ * methods for each button, call the begin() and handle() method of the button
+ * list object, which calls the begin() and handle() methods of each button in
+ * the list. 
+ */
+using AblePullupTimedCallbackDoubleClickerButtonList = able::ButtonList<AblePullupTimedCallbackDoubleClickerButton>;
+
+/**
+ * AblePullupDeferredCallbackButtonList allows an array of
+ * AblePullupDeferredCallbackButton objects to be managed together. Rather
+ * than calling begin() and handle() methods for each button, call the begin()
+ * and handle() method of the button list object, which calls the begin() and
+ * handle() methods of each button in the list. 
+ */
+using AblePullupDeferredCallbackButtonList = able::ButtonList<AblePullupDeferredCallbackButton>;
+
+/**
+ * AblePullupDeferredCallbackClickerButtonList allows an array of
+ * AblePullupDeferredCallbackClickerButton objects to be managed together. Rather
+ * than calling begin() and handle() methods for each button, call the begin()
+ * and handle() method of the button list object, which calls the begin() and
+ * handle() methods of each button in the list. 
+ */
+using AblePullupDeferredCallbackClickerButtonList = able::ButtonList<AblePullupDeferredCallbackClickerButton>;
+
+/**
+ * AblePullupDeferredCallbackDoubleClickerButtonList allows an array of
+ * AblePullupDeferredCallbackDoubleClickerButton objects to be managed together. Rather
+ * than calling begin() and handle() methods for each button, call the begin()
+ * and handle() method of the button list object, which calls the begin() and
+ * handle() methods of each button in the list. 
+ */
+using AblePullupDeferredCallbackDoubleClickerButtonList = able::ButtonList<AblePullupDeferredCallbackDoubleClickerButton>;
+
+//
+// Mixed resistor circuit buttons...
+//
+
+/**
+ * AbleMixed... buttons use a pulldown or pull-up resistor circuit chosen for
+ * each pin with able::MixedResistorCircuit::setPullup(pin) before they begin,
+ * so one button list can manage buttons on both circuits. Readings are XORed
+ * with the circuit's polarity, so the buttons otherwise behave exactly as the
+ * AblePulldown... and AblePullup... buttons of the same name.
+ */
+using AbleMixedButton = able::Button<able::MixedResistorCircuit, able::DebouncedPin<>>; ///< Basic debounced button on a mixed resistor circuit.
+using AbleMixedCallbackButton = able::CallbackButton<able::Button<able::MixedResistorCircuit, able::DebouncedPin<>>>; ///< Callback button on a mixed resistor circuit.
+using AbleMixedClickerButton = able::Button<able::MixedResistorCircuit, able::ClickerPin<>>; ///< Clicker button on a mixed resistor circuit.
+using AbleMixedCallbackClickerButton = able::CallbackButton<able::Button<able::MixedResistorCircuit, able::ClickerPin<>>>; ///< Callback clicker button on a mixed resistor circuit.
+using AbleMixedDirectButton = able::Button<able::MixedResistorCircuit, able::Pin>; ///< Direct button on a mixed resistor circuit.
+using AbleMixedDoubleClickerButton = able::Button<able::MixedResistorCircuit, able::DoubleClickerPin<>>; ///< Double-clicker button on a mixed resistor circuit.
+using AbleMixedCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::MixedResistorCircuit, able::DoubleClickerPin<>>>>; ///< Callback double-clicker button on a mixed resistor circuit.
+
+/**
+ * Lists of the AbleMixed... buttons, managing an array of buttons on either
+ * resistor circuit together as for the other button lists.
+ */
+using AbleMixedButtonList = able::ButtonList<AbleMixedButton>; ///< Handler for list of AbleMixedButton objects.
+using AbleMixedCallbackButtonList = able::ButtonList<AbleMixedCallbackButton>; ///< Handler for list of AbleMixedCallbackButton objects.
+using AbleMixedClickerButtonList = able::ButtonList<AbleMixedClickerButton>; ///< Handler for list of AbleMixedClickerButton objects.
+using AbleMixedCallbackClickerButtonList = able::ButtonList<AbleMixedCallbackClickerButton>; ///< Handler for list of AbleMixedCallbackClickerButton objects.
+using AbleMixedDirectButtonList = able::ButtonList<AbleMixedDirectButton>; ///< Handler for list of AbleMixedDirectButton objects.
+using AbleMixedDoubleClickerButtonList = able::ButtonList<AbleMixedDoubleClickerButton>; ///< Handler for list of AbleMixedDoubleClickerButton objects.
+using AbleMixedCallbackDoubleClickerButtonList = able::ButtonList<AbleMixedCallbackDoubleClickerButton>; ///< Handler for list of AbleMixedCallbackDoubleClickerButton objects.
+
+//
+// Pulldown debounce algorithm buttons...
+//
+
+/**
+ * AblePulldownEager... buttons report presses and releases on their leading
+ * edge (able::EagerDebouncer), removing the debounce delay. The bounce
+ * following each edge is ignored until the pin is steady for the debounce time.
+ * Only use them with pins free of noise spikes, which would be reported as
+ * short presses.
+ */
+using AblePulldownEagerButton = able::Button<able::PulldownResistorCircuit, able::DebouncedPin<able::NoCounters, able::EagerDebouncer<>>>; ///< Basic debounced button using the eager debouncer.
+using AblePulldownEagerCallbackButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DebouncedPin<able::NoCounters, able::EagerDebouncer<>>>>; ///< Callback button using the eager debouncer.
+using AblePulldownEagerClickerButton = able::Button<able::PulldownResistorCircuit, able::ClickerPin<able::NoCounters, able::EagerDebouncer<>>>; ///< Clicker button using the eager debouncer.
+using AblePulldownEagerCallbackClickerButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::ClickerPin<able::NoCounters, able::EagerDebouncer<>>>>; ///< Callback clicker button using the eager debouncer.
+using AblePulldownEagerDoubleClickerButton = able::Button<able::PulldownResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::EagerDebouncer<>>>; ///< Double-clicker button using the eager debouncer.
+using AblePulldownEagerCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::EagerDebouncer<>>>>>; ///< Callback double-clicker button using the eager debouncer.
+
+/**
+ * AblePulldownIntegrator... buttons debounce the pin integrating readings in a
+ * saturating counter (able::IntegratorDebouncer). A change needs 8 readings in
+ * the same direction. Uses 1 byte per button instead of 5, and only reads the
+ * clock when the button changes state. Call handle() at a steady rate (e.g.
+ * every 1-5ms) so 8 readings cover the contact bounce.
+ */
+using AblePulldownIntegratorButton = able::Button<able::PulldownResistorCircuit, able::DebouncedPin<able::NoCounters, able::IntegratorDebouncer<>>>; ///< Basic debounced button using the integrator debouncer.
+using AblePulldownIntegratorCallbackButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DebouncedPin<able::NoCounters, able::IntegratorDebouncer<>>>>; ///< Callback button using the integrator debouncer.
+using AblePulldownIntegratorClickerButton = able::Button<able::PulldownResistorCircuit, able::ClickerPin<able::NoCounters, able::IntegratorDebouncer<>>>; ///< Clicker button using the integrator debouncer.
+using AblePulldownIntegratorCallbackClickerButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::ClickerPin<able::NoCounters, able::IntegratorDebouncer<>>>>; ///< Callback clicker button using the integrator debouncer.
+using AblePulldownIntegratorDoubleClickerButton = able::Button<able::PulldownResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::IntegratorDebouncer<>>>; ///< Double-clicker button using the integrator debouncer.
+using AblePulldownIntegratorCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::IntegratorDebouncer<>>>>>; ///< Callback double-clicker button using the integrator debouncer.
+
+/**
+ * AblePulldownPattern... buttons debounce the pin matching a pattern in the
+ * last 8 readings (able::PatternDebouncer). A change needs the 2 oldest
+ * readings in the old state and the 3 newest in the new state, ignoring the
+ * bounce between. Uses 1 byte per button instead of 5, and only reads the clock
+ * when the button changes state. Call handle() at a steady rate (e.g. every
+ * 1-5ms) so 8 readings cover the contact bounce.
+ */
+using AblePulldownPatternButton = able::Button<able::PulldownResistorCircuit, able::DebouncedPin<able::NoCounters, able::PatternDebouncer>>; ///< Basic debounced button using the pattern debouncer.
+using AblePulldownPatternCallbackButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DebouncedPin<able::NoCounters, able::PatternDebouncer>>>; ///< Callback button using the pattern debouncer.
+using AblePulldownPatternClickerButton = able::Button<able::PulldownResistorCircuit, able::ClickerPin<able::NoCounters, able::PatternDebouncer>>; ///< Clicker button using the pattern debouncer.
+using AblePulldownPatternCallbackClickerButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::ClickerPin<able::NoCounters, able::PatternDebouncer>>>; ///< Callback clicker button using the pattern debouncer.
+using AblePulldownPatternDoubleClickerButton = able::Button<able::PulldownResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::PatternDebouncer>>; ///< Double-clicker button using the pattern debouncer.
+using AblePulldownPatternCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::PatternDebouncer>>>>; ///< Callback double-clicker button using the pattern debouncer.
+
+/**
+ * AblePulldownMajority... buttons debounce the pin taking a majority vote of
+ * the last 7 readings (able::MajorityDebouncer). Tolerates isolated noise
+ * spikes even when the button is not moving. Uses 1 byte per button instead of
+ * 5, and only reads the clock when the button changes state. Call handle() at a
+ * steady rate (e.g. every 1-5ms) so 7 readings cover the contact bounce.
+ */
+using AblePulldownMajorityButton = able::Button<able::PulldownResistorCircuit, able::DebouncedPin<able::NoCounters, able::MajorityDebouncer>>; ///< Basic debounced button using the majority debouncer.
+using AblePulldownMajorityCallbackButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DebouncedPin<able::NoCounters, able::MajorityDebouncer>>>; ///< Callback button using the majority debouncer.
+using AblePulldownMajorityClickerButton = able::Button<able::PulldownResistorCircuit, able::ClickerPin<able::NoCounters, able::MajorityDebouncer>>; ///< Clicker button using the majority debouncer.
+using AblePulldownMajorityCallbackClickerButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::ClickerPin<able::NoCounters, able::MajorityDebouncer>>>; ///< Callback clicker button using the majority debouncer.
+using AblePulldownMajorityDoubleClickerButton = able::Button<able::PulldownResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::MajorityDebouncer>>; ///< Double-clicker button using the majority debouncer.
+using AblePulldownMajorityCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::MajorityDebouncer>>>>; ///< Callback double-clicker button using the majority debouncer.
+
+//
+// Pulldown debounce algorithm button lists...
+//
+
+/**
+ * Lists of the AblePulldown... debounce algorithm buttons, managing an array of
+ * buttons together as for the other button lists.
+ */
+using AblePulldownEagerButtonList = able::ButtonList<AblePulldownEagerButton>; ///< Handler for list of AblePulldownEagerButton objects.
+using AblePulldownEagerCallbackButtonList = able::ButtonList<AblePulldownEagerCallbackButton>; ///< Handler for list of AblePulldownEagerCallbackButton objects.
+using AblePulldownEagerClickerButtonList = able::ButtonList<AblePulldownEagerClickerButton>; ///< Handler for list of AblePulldownEagerClickerButton objects.
+using AblePulldownEagerCallbackClickerButtonList = able::ButtonList<AblePulldownEagerCallbackClickerButton>; ///< Handler for list of AblePulldownEagerCallbackClickerButton objects.
+using AblePulldownEagerDoubleClickerButtonList = able::ButtonList<AblePulldownEagerDoubleClickerButton>; ///< Handler for list of AblePulldownEagerDoubleClickerButton objects.
+using AblePulldownEagerCallbackDoubleClickerButtonList = able::ButtonList<AblePulldownEagerCallbackDoubleClickerButton>; ///< Handler for list of AblePulldownEagerCallbackDoubleClickerButton objects.
+using AblePulldownIntegratorButtonList = able::ButtonList<AblePulldownIntegratorButton>; ///< Handler for list of AblePulldownIntegratorButton objects.
+using AblePulldownIntegratorCallbackButtonList = able::ButtonList<AblePulldownIntegratorCallbackButton>; ///< Handler for list of AblePulldownIntegratorCallbackButton objects.
+using AblePulldownIntegratorClickerButtonList = able::ButtonList<AblePulldownIntegratorClickerButton>; ///< Handler for list of AblePulldownIntegratorClickerButton objects.
+using AblePulldownIntegratorCallbackClickerButtonList = able::ButtonList<AblePulldownIntegratorCallbackClickerButton>; ///< Handler for list of AblePulldownIntegratorCallbackClickerButton objects.
+using AblePulldownIntegratorDoubleClickerButtonList = able::ButtonList<AblePulldownIntegratorDoubleClickerButton>; ///< Handler for list of AblePulldownIntegratorDoubleClickerButton objects.
+using AblePulldownIntegratorCallbackDoubleClickerButtonList = able::ButtonList<AblePulldownIntegratorCallbackDoubleClickerButton>; ///< Handler for list of AblePulldownIntegratorCallbackDoubleClickerButton objects.
+using AblePulldownPatternButtonList = able::ButtonList<AblePulldownPatternButton>; ///< Handler for list of AblePulldownPatternButton objects.
+using AblePulldownPatternCallbackButtonList = able::ButtonList<AblePulldownPatternCallbackButton>; ///< Handler for list of AblePulldownPatternCallbackButton objects.
+using AblePulldownPatternClickerButtonList = able::ButtonList<AblePulldownPatternClickerButton>; ///< Handler for list of AblePulldownPatternClickerButton objects.
+using AblePulldownPatternCallbackClickerButtonList = able::ButtonList<AblePulldownPatternCallbackClickerButton>; ///< Handler for list of AblePulldownPatternCallbackClickerButton objects.
+using AblePulldownPatternDoubleClickerButtonList = able::ButtonList<AblePulldownPatternDoubleClickerButton>; ///< Handler for list of AblePulldownPatternDoubleClickerButton objects.
+using AblePulldownPatternCallbackDoubleClickerButtonList = able::ButtonList<AblePulldownPatternCallbackDoubleClickerButton>; ///< Handler for list of AblePulldownPatternCallbackDoubleClickerButton objects.
+using AblePulldownMajorityButtonList = able::ButtonList<AblePulldownMajorityButton>; ///< Handler for list of AblePulldownMajorityButton objects.
+using AblePulldownMajorityCallbackButtonList = able::ButtonList<AblePulldownMajorityCallbackButton>; ///< Handler for list of AblePulldownMajorityCallbackButton objects.
+using AblePulldownMajorityClickerButtonList = able::ButtonList<AblePulldownMajorityClickerButton>; ///< Handler for list of AblePulldownMajorityClickerButton objects.
+using AblePulldownMajorityCallbackClickerButtonList = able::ButtonList<AblePulldownMajorityCallbackClickerButton>; ///< Handler for list of AblePulldownMajorityCallbackClickerButton objects.
+using AblePulldownMajorityDoubleClickerButtonList = able::ButtonList<AblePulldownMajorityDoubleClickerButton>; ///< Handler for list of AblePulldownMajorityDoubleClickerButton objects.
+using AblePulldownMajorityCallbackDoubleClickerButtonList = able::ButtonList<AblePulldownMajorityCallbackDoubleClickerButton>; ///< Handler for list of AblePulldownMajorityCallbackDoubleClickerButton objects.
+
+//
+// Pull-up debounce algorithm buttons...
+//
+
+/**
+ * AblePullupEager... buttons report presses and releases on their leading edge
+ * (able::EagerDebouncer), removing the debounce delay. The bounce following
+ * each edge is ignored until the pin is steady for the debounce time. Only use
+ * them with pins free of noise spikes, which would be reported as short
+ * presses.
+ */
+using AblePullupEagerButton = able::Button<able::PullupResistorCircuit, able::DebouncedPin<able::NoCounters, able::EagerDebouncer<>>>; ///< Basic debounced button using the eager debouncer.
+using AblePullupEagerCallbackButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DebouncedPin<able::NoCounters, able::EagerDebouncer<>>>>; ///< Callback button using the eager debouncer.
+using AblePullupEagerClickerButton = able::Button<able::PullupResistorCircuit, able::ClickerPin<able::NoCounters, able::EagerDebouncer<>>>; ///< Clicker button using the eager debouncer.
+using AblePullupEagerCallbackClickerButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::ClickerPin<able::NoCounters, able::EagerDebouncer<>>>>; ///< Callback clicker button using the eager debouncer.
+using AblePullupEagerDoubleClickerButton = able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::EagerDebouncer<>>>; ///< Double-clicker button using the eager debouncer.
+using AblePullupEagerCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::EagerDebouncer<>>>>>; ///< Callback double-clicker button using the eager debouncer.
+
+/**
+ * AblePullupIntegrator... buttons debounce the pin integrating readings in a
+ * saturating counter (able::IntegratorDebouncer). A change needs 8 readings in
+ * the same direction. Uses 1 byte per button instead of 5, and only reads the
+ * clock when the button changes state. Call handle() at a steady rate (e.g.
+ * every 1-5ms) so 8 readings cover the contact bounce.
+ */
+using AblePullupIntegratorButton = able::Button<able::PullupResistorCircuit, able::DebouncedPin<able::NoCounters, able::IntegratorDebouncer<>>>; ///< Basic debounced button using the integrator debouncer.
+using AblePullupIntegratorCallbackButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DebouncedPin<able::NoCounters, able::IntegratorDebouncer<>>>>; ///< Callback button using the integrator debouncer.
+using AblePullupIntegratorClickerButton = able::Button<able::PullupResistorCircuit, able::ClickerPin<able::NoCounters, able::IntegratorDebouncer<>>>; ///< Clicker button using the integrator debouncer.
+using AblePullupIntegratorCallbackClickerButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::ClickerPin<able::NoCounters, able::IntegratorDebouncer<>>>>; ///< Callback clicker button using the integrator debouncer.
+using AblePullupIntegratorDoubleClickerButton = able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::IntegratorDebouncer<>>>; ///< Double-clicker button using the integrator debouncer.
+using AblePullupIntegratorCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::IntegratorDebouncer<>>>>>; ///< Callback double-clicker button using the integrator debouncer.
+
+/**
+ * AblePullupPattern... buttons debounce the pin matching a pattern in the last
+ * 8 readings (able::PatternDebouncer). A change needs the 2 oldest readings in
+ * the old state and the 3 newest in the new state, ignoring the bounce between.
+ * Uses 1 byte per button instead of 5, and only reads the clock when the button
+ * changes state. Call handle() at a steady rate (e.g. every 1-5ms) so 8
+ * readings cover the contact bounce.
+ */
+using AblePullupPatternButton = able::Button<able::PullupResistorCircuit, able::DebouncedPin<able::NoCounters, able::PatternDebouncer>>; ///< Basic debounced button using the pattern debouncer.
+using AblePullupPatternCallbackButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DebouncedPin<able::NoCounters, able::PatternDebouncer>>>; ///< Callback button using the pattern debouncer.
+using AblePullupPatternClickerButton = able::Button<able::PullupResistorCircuit, able::ClickerPin<able::NoCounters, able::PatternDebouncer>>; ///< Clicker button using the pattern debouncer.
+using AblePullupPatternCallbackClickerButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::ClickerPin<able::NoCounters, able::PatternDebouncer>>>; ///< Callback clicker button using the pattern debouncer.
+using AblePullupPatternDoubleClickerButton = able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::PatternDebouncer>>; ///< Double-clicker button using the pattern debouncer.
+using AblePullupPatternCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::PatternDebouncer>>>>; ///< Callback double-clicker button using the pattern debouncer.
+
+/**
+ * AblePullupMajority... buttons debounce the pin taking a majority vote of the
+ * last 7 readings (able::MajorityDebouncer). Tolerates isolated noise spikes
+ * even when the button is not moving. Uses 1 byte per button instead of 5, and
+ * only reads the clock when the button changes state. Call handle() at a steady
+ * rate (e.g. every 1-5ms) so 7 readings cover the contact bounce.
+ */
+using AblePullupMajorityButton = able::Button<able::PullupResistorCircuit, able::DebouncedPin<able::NoCounters, able::MajorityDebouncer>>; ///< Basic debounced button using the majority debouncer.
+using AblePullupMajorityCallbackButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DebouncedPin<able::NoCounters, able::MajorityDebouncer>>>; ///< Callback button using the majority debouncer.
+using AblePullupMajorityClickerButton = able::Button<able::PullupResistorCircuit, able::ClickerPin<able::NoCounters, able::MajorityDebouncer>>; ///< Clicker button using the majority debouncer.
+using AblePullupMajorityCallbackClickerButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::ClickerPin<able::NoCounters, able::MajorityDebouncer>>>; ///< Callback clicker button using the majority debouncer.
+using AblePullupMajorityDoubleClickerButton = able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::MajorityDebouncer>>; ///< Double-clicker button using the majority debouncer.
+using AblePullupMajorityCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::MajorityDebouncer>>>>; ///< Callback double-clicker button using the majority debouncer.
+
+//
+// Pull-up debounce algorithm button lists...
+//
+
+/**
+ * Lists of the AblePullup... debounce algorithm buttons, managing an array of
+ * buttons together as for the other button lists.
+ */
+using AblePullupEagerButtonList = able::ButtonList<AblePullupEagerButton>; ///< Handler for list of AblePullupEagerButton objects.
+using AblePullupEagerCallbackButtonList = able::ButtonList<AblePullupEagerCallbackButton>; ///< Handler for list of AblePullupEagerCallbackButton objects.
+using AblePullupEagerClickerButtonList = able::ButtonList<AblePullupEagerClickerButton>; ///< Handler for list of AblePullupEagerClickerButton objects.
+using AblePullupEagerCallbackClickerButtonList = able::ButtonList<AblePullupEagerCallbackClickerButton>; ///< Handler for list of AblePullupEagerCallbackClickerButton objects.
+using AblePullupEagerDoubleClickerButtonList = able::ButtonList<AblePullupEagerDoubleClickerButton>; ///< Handler for list of AblePullupEagerDoubleClickerButton objects.
+using AblePullupEagerCallbackDoubleClickerButtonList = able::ButtonList<AblePullupEagerCallbackDoubleClickerButton>; ///< Handler for list of AblePullupEagerCallbackDoubleClickerButton objects.
+using AblePullupIntegratorButtonList = able::ButtonList<AblePullupIntegratorButton>; ///< Handler for list of AblePullupIntegratorButton objects.
+using AblePullupIntegratorCallbackButtonList = able::ButtonList<AblePullupIntegratorCallbackButton>; ///< Handler for list of AblePullupIntegratorCallbackButton objects.
+using AblePullupIntegratorClickerButtonList = able::ButtonList<AblePullupIntegratorClickerButton>; ///< Handler for list of AblePullupIntegratorClickerButton objects.
+using AblePullupIntegratorCallbackClickerButtonList = able::ButtonList<AblePullupIntegratorCallbackClickerButton>; ///< Handler for list of AblePullupIntegratorCallbackClickerButton objects.
+using AblePullupIntegratorDoubleClickerButtonList = able::ButtonList<AblePullupIntegratorDoubleClickerButton>; ///< Handler for list of AblePullupIntegratorDoubleClickerButton objects.
+using AblePullupIntegratorCallbackDoubleClickerButtonList = able::ButtonList<AblePullupIntegratorCallbackDoubleClickerButton>; ///< Handler for list of AblePullupIntegratorCallbackDoubleClickerButton objects.
+using AblePullupPatternButtonList = able::ButtonList<AblePullupPatternButton>; ///< Handler for list of AblePullupPatternButton objects.
+using AblePullupPatternCallbackButtonList = able::ButtonList<AblePullupPatternCallbackButton>; ///< Handler for list of AblePullupPatternCallbackButton objects.
+using AblePullupPatternClickerButtonList = able::ButtonList<AblePullupPatternClickerButton>; ///< Handler for list of AblePullupPatternClickerButton objects.
+using AblePullupPatternCallbackClickerButtonList = able::ButtonList<AblePullupPatternCallbackClickerButton>; ///< Handler for list of AblePullupPatternCallbackClickerButton objects.
+using AblePullupPatternDoubleClickerButtonList = able::ButtonList<AblePullupPatternDoubleClickerButton>; ///< Handler for list of AblePullupPatternDoubleClickerButton objects.
+using AblePullupPatternCallbackDoubleClickerButtonList = able::ButtonList<AblePullupPatternCallbackDoubleClickerButton>; ///< Handler for list of AblePullupPatternCallbackDoubleClickerButton objects.
+using AblePullupMajorityButtonList = able::ButtonList<AblePullupMajorityButton>; ///< Handler for list of AblePullupMajorityButton objects.
+using AblePullupMajorityCallbackButtonList = able::ButtonList<AblePullupMajorityCallbackButton>; ///< Handler for list of AblePullupMajorityCallbackButton objects.
+using AblePullupMajorityClickerButtonList = able::ButtonList<AblePullupMajorityClickerButton>; ///< Handler for list of AblePullupMajorityClickerButton objects.
+using AblePullupMajorityCallbackClickerButtonList = able::ButtonList<AblePullupMajorityCallbackClickerButton>; ///< Handler for list of AblePullupMajorityCallbackClickerButton objects.
+using AblePullupMajorityDoubleClickerButtonList = able::ButtonList<AblePullupMajorityDoubleClickerButton>; ///< Handler for list of AblePullupMajorityDoubleClickerButton objects.
+using AblePullupMajorityCallbackDoubleClickerButtonList = able::ButtonList<AblePullupMajorityCallbackDoubleClickerButton>; ///< Handler for list of AblePullupMajorityCallbackDoubleClickerButton objects.
+
+//
+// Press-only callback buttons...
+//
+
+/**
+ * Able...PressCallbackButton buttons call the callback function only when
+ * pressed or released (no held or idle events), so never check the held and
+ * idle times. Use them for buttons that only need presses and releases. The
+ * integrator versions are timed by the UntimedClock, so never read a clock
+ * and keep a 1-byte timestamp.
+ */
+using AblePulldownPressCallbackButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DebouncedPin<>>, able::UntimedCallback, able::CallbackEvents::NO_TIMED_EVENTS>; ///< Press-only callback button using a pulldown resistor.
+using AblePulldownIntegratorPressCallbackButton = able::CallbackButton<able::Button<able::PulldownResistorCircuit, able::DebouncedPin<able::NoCounters, able::IntegratorDebouncer<>, able::UntimedClock>>, able::UntimedCallback, able::CallbackEvents::NO_TIMED_EVENTS>; ///< Press-only callback button using a pulldown resistor and the integrator debouncer.
+using AblePullupPressCallbackButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DebouncedPin<>>, able::UntimedCallback, able::CallbackEvents::NO_TIMED_EVENTS>; ///< Press-only callback button using a pull-up resistor.
+using AblePullupIntegratorPressCallbackButton = able::CallbackButton<able::Button<able::PullupResistorCircuit, able::DebouncedPin<able::NoCounters, able::IntegratorDebouncer<>, able::UntimedClock>>, able::UntimedCallback, able::CallbackEvents::NO_TIMED_EVENTS>; ///< Press-only callback button using a pull-up resistor and the integrator debouncer.
+using AblePulldownPressCallbackButtonList = able::ButtonList<AblePulldownPressCallbackButton>; ///< Handler for list of AblePulldownPressCallbackButton objects.
+using AblePulldownIntegratorPressCallbackButtonList = able::ButtonList<AblePulldownIntegratorPressCallbackButton>; ///< Handler for list of AblePulldownIntegratorPressCallbackButton objects.
+using AblePullupPressCallbackButtonList = able::ButtonList<AblePullupPressCallbackButton>; ///< Handler for list of AblePullupPressCallbackButton objects.
+using AblePullupIntegratorPressCallbackButtonList = able::ButtonList<AblePullupIntegratorPressCallbackButton>; ///< Handler for list of AblePullupIntegratorPressCallbackButton objects.
+
+//
+// Table buttons...
+//
+
+/**
+ * AbleTable...Button buttons are configured by a PROGMEM table (see Tables.h)
+ * giving the pin, resistor circuit, id and debounce time of each button, and
+ * are held in an AbleTable...ButtonList of the size of the table, e.g.
+ * `AbleTableCallbackButtonList<4> btnList(table, onEvent);`. Only the state
+ * of the buttons that changes is held in RAM.
+ */
+using AbleTableButton = able::Button<able::TableResistorCircuit, able::DebouncedPin<able::NoCounters, able::TimerDebouncer, able::MillisClock, able::TablePin>>; ///< Basic debounced button configured by a table.
+using AbleTableCallbackButton = able::CallbackButton<able::Button<able::TableResistorCircuit, able::DebouncedPin<able::NoCounters, able::TimerDebouncer, able::MillisClock, able::TablePin>>>; ///< Callback button configured by a table.
+using AbleTableClickerButton = able::Button<able::TableResistorCircuit, able::ClickerPin<able::NoCounters, able::TimerDebouncer, able::MillisClock, able::TablePin>>; ///< Clicker button configured by a table.
+using AbleTableCallbackClickerButton = able::CallbackButton<able::Button<able::TableResistorCircuit, able::ClickerPin<able::NoCounters, able::TimerDebouncer, able::MillisClock, able::TablePin>>>; ///< Callback clicker button configured by a table.
+using AbleTableDoubleClickerButton = able::Button<able::TableResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::TimerDebouncer, able::MillisClock, able::TablePin>>; ///< Double-clicker button configured by a table.
+using AbleTableCallbackDoubleClickerButton = able::CallbackClickerButton<able::CallbackButton<able::Button<able::TableResistorCircuit, able::DoubleClickerPin<able::NoCounters, able::TimerDebouncer, able::MillisClock, able::TablePin>>>>; ///< Callback double-clicker button configured by a table.
+template <size_t N> using AbleTableButtonList = able::ButtonTable<AbleTableButton, N>; ///< Table of N AbleTableButton objects.
+template <size_t N> using AbleTableCallbackButtonList = able::ButtonTable<AbleTableCallbackButton, N>; ///< Table of N AbleTableCallbackButton objects.
+template <size_t N> using AbleTableClickerButtonList = able::ButtonTable<AbleTableClickerButton, N>; ///< Table of N AbleTableClickerButton objects.
+template <size_t N> using AbleTableCallbackClickerButtonList = able::ButtonTable<AbleTableCallbackClickerButton, N>; ///< Table of N AbleTableCallbackClickerButton objects.
+template <size_t N> using AbleTableDoubleClickerButtonList = able::ButtonTable<AbleTableDoubleClickerButton, N>; ///< Table of N AbleTableDoubleClickerButton objects.
+template <size_t N> using AbleTableCallbackDoubleClickerButtonList = able::ButtonTable<AbleTableCallbackDoubleClickerButton, N>; ///< Table of N AbleTableCallbackDoubleClickerButton objects.
+
+//
+// Button arrays...
+//
+
+/**
+ * Able...ButtonArray<N> arrays hold the state of N double-clicker buttons in
+ * contiguous arrays (see ButtonArray.h), so scanning and querying them runs
+ * along the arrays rather than through a pointer to each button. Create with
+ * an array of the pins, e.g. `AblePullupButtonArray<4> btns(pins);`.
+ */
+template <size_t N> using AblePulldownButtonArray = able::ButtonArray<able::PulldownResistorCircuit, N>; ///< Array of N buttons using pulldown resistor circuits.
+template <size_t N> using AblePullupButtonArray = able::ButtonArray<able::PullupResistorCircuit, N>; ///< Array of N buttons using pull-up resistor circuits.
+template <size_t N> using AbleMixedButtonArray = able::ButtonArray<able::MixedResistorCircuit, N>; ///< Array of N buttons using mixed resistor circuits.
+
+//
+// Rotary encoders...
+//
+
+/**
+ * Able...Encoder classes read a rotary encoder with a push switch. The switch
+ * is a clicker button (AblePulldownClickerButton and so on), or a callback
+ * clicker button for the ...CallbackEncoder classes, so encoders can be
+ * handled in a ButtonList with the switch states read as for buttons. Create
+ * with the A, B and switch pins, e.g. `AblePullupEncoder enc(2, 3, 4);`.
+ */
+using AblePulldownEncoder = able::Encoder<able::PulldownResistorCircuit, AblePulldownClickerButton>; ///< Encoder using pulldown resistor circuits.
+using AblePulldownCallbackEncoder = able::Encoder<able::PulldownResistorCircuit, AblePulldownCallbackClickerButton>; ///< Encoder with a callback switch using pulldown resistor circuits.
+using AblePullupEncoder = able::Encoder<able::PullupResistorCircuit, AblePullupClickerButton>; ///< Encoder using pull-up resistor circuits.
+using AblePullupCallbackEncoder = able::Encoder<able::PullupResistorCircuit, AblePullupCallbackClickerButton>; ///< Encoder with a callback switch using pull-up resistor circuits.
+using AblePulldownEncoderList = able::ButtonList<AblePulldownEncoder>; ///< Handler for list of AblePulldownEncoder objects.
+using AblePulldownCallbackEncoderList = able::ButtonList<AblePulldownCallbackEncoder>; ///< Handler for list of AblePulldownCallbackEncoder objects.
+using AblePullupEncoderList = able::ButtonList<AblePullupEncoder>; ///< Handler for list of AblePullupEncoder objects.
+using AblePullupCallbackEncoderList = able::ButtonList<AblePullupCallbackEncoder>; ///< Handler for list of AblePullupCallbackEncoder objects.
@@ -0,0 +1,574 @@
+/**
+ * @file Awaitables.h Definitions of the AwaitableButton and
+ * AwaitableButtonList template classes, letting C++20 coroutines wait for
+ * button events instead of polling them in loop():
+ *
+ *     able::ButtonTask blink() {
+ *       for(;;) {
+ *         co_await btn.clicked();
+ *         digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+ *       }
+ *     }
+ *
+ * A waiting coroutine is resumed from the handle() of its button (or list) in
+ * the same pass that reads the pins, as soon as the event occurs. The events
+ * are the same as the callback events of a CallbackButton, in the same order,
+ * so a coroutine resumed by a release can wait for the click it completes.
+ * Waiting needs no heap memory: each wait is linked into its button from the
+ * coroutine's own frame.
+ *
+ * Coroutines need a C++20 compiler (e.g. `-std=c++20`). Without coroutine
+ * support this file defines nothing, so it is safe to include everywhere.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+#include <exception>
+#include "ButtonList.h"
+#include "CallbackButton.h"
+
+namespace able {
+  template <typename Source> class Awaiters;
+
+  /**
+   * Awaitable wait for an event of a button or button list. Returned by the
+   * event methods of AwaitableButton and AwaitableButtonList, an Awaiter is
+   * used with co_await, or converted to bool to read the matching state now.
+   *
+   * A wait is either for events (e.g. a press of any button in a list), or
+   * for a state to become true (e.g. all buttons in a list being pressed).
+   *
+   * @param Source The AwaitableButton or AwaitableButtonList class.
+   */
+  template <typename Source>
+  class Awaiter {
+    friend class Awaiters<Source>;
+
+    public:
+      //
+      // Types...
+      //
+      typedef bool (Source::*State)() const; ///< The state of the wait (e.g. isClicked).
+
+    public:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create a wait for events of a button or button list, or for a state
+       * to become true.
+       *
+       * @param source The button or button list.
+       * @param state The state read when converted to bool.
+       * @param events Bit mask of the events waited for (`1 << event`), or 0
+       *               to wait for the state to become true.
+       */
+      Awaiter(const Source &source, State state, uint8_t events)
+      :source_(source), state_(state), next_(0), handle_(), events_(events), armed_(false) {}
+
+      /**
+       * Destroy the wait, removing it from the button if still waiting (e.g.
+       * the coroutine was destroyed).
+       */
+      ~Awaiter() {
+        if(handle_) source_.awaiters_.remove(this);
+      }
+
+    private:
+      //
+      // Copying and assignment (not supported)...
+      //
+      Awaiter(const Awaiter &cpy) = delete; ///< Copying is not supported.
+      Awaiter &operator=(const Awaiter &) = delete; ///< Assigning is not supported.
+
+    public:
+      //
+      // Coroutine interface...
+      //
+
+      /**
+       * Never ready, so co_await always waits for the next event.
+       *
+       * @return Always false.
+       */
+      bool await_ready() const {
+        return false;
+      }
+
+      /**
+       * Suspend the coroutine until the event. When waiting for a state that
+       * is already true, it must become false before the next event.
+       *
+       * @param handle The suspended coroutine.
+       */
+      void await_suspend(std::coroutine_handle<> handle) {
+        handle_ = handle;
+        armed_ = !*this;
+        source_.awaiters_.add(this);
+      }
+
+      /**
+       * Resume the coroutine after the event. Nothing is returned.
+       */
+      void await_resume() const {}
+
+    public:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Return the state now, so an Awaiter can be used as a bool (e.g.
+       * `if(list.anyHeld())`).
+       *
+       * @return True if the state is true, else false.
+       */
+      operator bool() const {
+        return (source_.*state_)();
+      }
+
+    private:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Check if the wait is over.
+       *
+       * @param events Bit mask of the events that occurred, or 0 to check
+       *               the state.
+       *
+       * @return True if the wait is over, else false.
+       */
+      bool occurred(uint8_t events) {
+        if(events_ || events) return (events_ & events) != 0;
+        if(!*this) {
+          armed_ = true;
+          return false;
+        }
+        return armed_;
+      }
+
+    private:
+      //
+      // Data...
+      //
+      const Source &source_; ///< The button or button list.
+      State state_; ///< The state of the wait.
+      Awaiter *next_; ///< The next wait for the button.
+      std::coroutine_handle<> handle_; ///< The waiting coroutine (null when not waiting).
+      uint8_t events_; ///< Bit mask of the events waited for (0 for a state).
+      bool armed_; ///< True once the state has been false.
+  };
+
+  /**
+   * List of the coroutines waiting for a button or button list, in the order
+   * they started waiting. The waits live in the coroutine frames, so the list
+   * needs no memory of its own beyond the first pointer.
+   *
+   * @param Source The AwaitableButton or AwaitableButtonList class.
+   */
+  template <typename Source>
+  class Awaiters {
+    public:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create an empty list.
+       */
+      Awaiters(): head_(0) {}
+
+    public:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Add a wait to the end of the list.
+       *
+       * @param awaiter The wait to add.
+       */
+      void add(Awaiter<Source> *awaiter) {
+        Awaiter<Source> **pp = &head_;
+        while(*pp) pp = &(*pp)->next_;
+        awaiter->next_ = 0;
+        *pp = awaiter;
+      }
+
+      /**
+       * Remove a wait from the list.
+       *
+       * @param awaiter The wait to remove.
+       */
+      void remove(Awaiter<Source> *awaiter) {
+        for(Awaiter<Source> **pp = &head_; *pp; pp = &(*pp)->next_) {
+          if(*pp == awaiter) {
+            *pp = awaiter->next_;
+            break;
+          }
+        }
+      }
+
+      /**
+       * Resume each coroutine whose wait is over, keeping the others waiting.
+       * A resumed coroutine may wait again (on any button), but must not
+       * destroy another waiting coroutine.
+       *
+       * @param events Bit mask of the events that occurred, or 0 to check
+       *               the states waited for.
+       */
+      void resume(uint8_t events) {
+        Awaiter<Source> *awaiter = head_;
+        Awaiter<Source> *waiting = 0;
+        Awaiter<Source> **tail = &waiting;
+
+        head_ = 0; // Waits added while resuming are checked next time.
+        while(awaiter) {
+          Awaiter<Source> *next = awaiter->next_;
+          if(awaiter->occurred(events)) {
+            std::coroutine_handle<> handle = awaiter->handle_;
+            awaiter->handle_ = nullptr;
+            handle.resume(); // NB: May destroy awaiter.
+          } else {
+            *tail = awaiter;
+            tail = &awaiter->next_;
+          }
+          awaiter = next;
+        }
+        *tail = head_;
+        head_ = waiting;
+      }
+
+    private:
+      //
+      // Data...
+      //
+      Awaiter<Source> *head_; ///< The first wait.
+  };
+
+  /**
+   * The callback button class an AwaitableButton is built on: the button
+   * class itself for a callback button, else a callback clicker button of it
+   * with no callback function. Events then always come from the callback
+   * logic of CallbackButton and CallbackClickerButton.
+   *
+   * @param Button The button class.
+   */
+  template <typename Button, typename = void>
+  struct AwaitableBase {
+    typedef CallbackClickerButton<CallbackButton<Button>> Type; ///< The callback button class.
+  };
+
+  /// @copydoc AwaitableBase
+  template <typename Button>
+  struct AwaitableBase<Button, decltype(void(sizeof(typename Button::CallbackFn)))> {
+    typedef Button Type; ///< The callback button class.
+  };
+
+  /**
+   * Awaitable button template, adding co_await-able events to a debounced
+   * button or callback button (e.g. `co_await btn.clicked()`). Waiting
+   * coroutines are resumed from handle(). The events are those sent by the
+   * callback button (see AwaitableBase), so a callback button only gives the
+   * events it sends (e.g. click events need a CallbackClickerButton). Uses a
+   * pointer and a byte of memory per button, plus the memory of a callback
+   * button for other buttons.
+   *
+   * @param Button The button class (e.g. AblePullupClickerButton). Click
+   *               events only occur for clicker and double-clicker buttons.
+   */
+  template <typename Button>
+  class AwaitableButton: public AwaitableBase<Button>::Type {
+    friend class Awaiter<AwaitableButton>;
+
+    public:
+      //
+      // Types...
+      //
+      typedef typename AwaitableBase<Button>::Type Base; ///< The callback button class.
+      typedef Awaiter<AwaitableButton> Event; ///< The co_await-able event type.
+      typedef CallbackEvents::CALLBACK_EVENT EventCode; ///< The event codes.
+
+    public:
+      //
+      // Creators...
+      //
+      using Base::Base; ///< Created as the callback button class.
+
+    public:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Handle the button, resuming coroutines waiting for each event the
+       * callback button sent. Called from loop() of an Arduino program.
+       */
+      void handle() {
+        uint8_t currState = this->currState_;
+        EventCode lastEvent = this->lastEvent_;
+        events_ = 0;
+        Base::handle();
+        if(currState != this->currState_) {
+          lastEvent = this->isPressed() ? CallbackEvents::PRESSED_EVENT : CallbackEvents::RELEASED_EVENT;
+          signal(lastEvent);
+        }
+        if(this->lastEvent_ != lastEvent) { // Held, idle or click (e.g. a double-click known on release).
+          signal(this->lastEvent_);
+        }
+      }
+
+    protected:
+      /**
+       * Record an event and resume the coroutines waiting for it.
+       *
+       * @param event The event that occurred.
+       */
+      void signal(EventCode event) {
+        events_ |= 1 << event;
+        awaiters_.resume(1 << event);
+      }
+
+    public:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Return the events of the last call of handle().
+       *
+       * @return Bit mask of the events (`1 << event`).
+       */
+      uint8_t events() const {
+        return events_;
+      }
+
+      /**
+       * Determine if the button is currently released.
+       *
+       * @return True if released, else false.
+       */
+      bool isReleased() const {
+        return !this->isPressed();
+      }
+
+      /**
+       * Wait for the button to be pressed.
+       *
+       * @return The event to co_await.
+       */
+      Event pressed() const {
+        return Event(*this, &AwaitableButton::isPressed, 1 << CallbackEvents::PRESSED_EVENT);
+      }
+
+      /**
+       * Wait for the button to be released.
+       *
+       * @return The event to co_await.
+       */
+      Event released() const {
+        return Event(*this, &AwaitableButton::isReleased, 1 << CallbackEvents::RELEASED_EVENT);
+      }
+
+      /**
+       * Wait for the button to be held.
+       *
+       * @return The event to co_await.
+       */
+      Event held() const {
+        return Event(*this, &AwaitableButton::isHeld, 1 << CallbackEvents::HELD_EVENT);
+      }
+
+      /**
+       * Wait for the button to become idle.
+       *
+       * @return The event to co_await.
+       */
+      Event idle() const {
+        return Event(*this, &AwaitableButton::isIdle, 1 << CallbackEvents::IDLE_EVENT);
+      }
+
+      /**
+       * Wait for the button to be clicked or double-clicked.
+       *
+       * @return The event to co_await.
+       */
+      Event clicked() const {
+        return Event(*this, &AwaitableButton::isClicked, (1 << CallbackEvents::SINGLE_CLICKED_EVENT) | (1 << CallbackEvents::DOUBLE_CLICKED_EVENT));
+      }
+
+      /**
+       * Wait for the button to be single-clicked (exclusively, for double-
+       * clicker buttons).
+       *
+       * @return The event to co_await.
+       */
+      Event singleClicked() const {
+        return Event(*this, &AwaitableButton::isSingleClicked, 1 << CallbackEvents::SINGLE_CLICKED_EVENT);
+      }
+
+      /**
+       * Wait for the button to be double-clicked.
+       *
+       * @return The event to co_await.
+       */
+      Event doubleClicked() const {
+        return Event(*this, &AwaitableButton::isDoubleClicked, 1 << CallbackEvents::DOUBLE_CLICKED_EVENT);
+      }
+
+    private:
+      //
+      // Data...
+      //
+      mutable Awaiters<AwaitableButton> awaiters_; ///< Coroutines waiting for the button.
+      uint8_t events_ = 0; ///< Events of the last call of handle().
+  };
+
+  /**
+   * Awaitable button list template, adding co_await-able events to a list of
+   * AwaitableButtons (e.g. `co_await list.anyHeld()`). The any...() methods
+   * wait for an event of any button, and the allPressed(), allHeld() and
+   * allIdle() methods wait for all the buttons to be in that state. They may
+   * also be used as bool, as for a ButtonList. Waiting coroutines are resumed
+   * from handle(), as each button is handled (or after all the buttons are
+   * handled for the all...() methods).
+   *
+   * @param Button The AwaitableButton class of the list.
+   */
+  template <typename Button>
+  class AwaitableButtonList: public ButtonList<Button> {
+    friend class Awaiter<AwaitableButtonList>;
+
+    public:
+      //
+      // Types...
+      //
+      typedef Awaiter<AwaitableButtonList> Event; ///< The co_await-able event type.
+      typedef ButtonList<Button> List; ///< The button list class.
+
+    public:
+      //
+      // Creators...
+      //
+      using List::List; ///< Created as a button list.
+
+    public:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Handle all the buttons, resuming coroutines waiting for events of the
+       * list. Called from loop() of an Arduino program.
+       */
+      void handle() {
+        this->anyStates_ = 0;
+        for(size_t i = 0; i < this->len_; ++i) {
+          this->buttons_[i]->handle();
+          if(this->buttons_[i]->events()) awaiters_.resume(this->buttons_[i]->events());
+        }
+        awaiters_.resume(0);
+      }
+
+    public:
+      //
+      // Accessors...
+      //
+      Event anyPressed() const { return Event(*this, &List::anyPressed, 1 << CallbackEvents::PRESSED_EVENT); } ///< Wait for any button to be pressed.
+      Event anyHeld() const { return Event(*this, &List::anyHeld, 1 << CallbackEvents::HELD_EVENT); } ///< Wait for any button to be held.
+      Event anyIdle() const { return Event(*this, &List::anyIdle, 1 << CallbackEvents::IDLE_EVENT); } ///< Wait for any button to become idle.
+      Event anyClicked() const { return Event(*this, &List::anyClicked, (1 << CallbackEvents::SINGLE_CLICKED_EVENT) | (1 << CallbackEvents::DOUBLE_CLICKED_EVENT)); } ///< Wait for any button to be clicked or double-clicked.
+      Event anySingleClicked() const { return Event(*this, &List::anySingleClicked, 1 << CallbackEvents::SINGLE_CLICKED_EVENT); } ///< Wait for any button to be single-clicked.
+      Event anyDoubleClicked() const { return Event(*this, &List::anyDoubleClicked, 1 << CallbackEvents::DOUBLE_CLICKED_EVENT); } ///< Wait for any button to be double-clicked.
+      Event allPressed() const { return Event(*this, &List::allPressed, 0); } ///< Wait for all buttons to be pressed.
+      Event allHeld() const { return Event(*this, &List::allHeld, 0); } ///< Wait for all buttons to be held.
+      Event allIdle() const { return Event(*this, &List::allIdle, 0); } ///< Wait for all buttons to be idle.
+
+    private:
+      //
+      // Data...
+      //
+      mutable Awaiters<AwaitableButtonList> awaiters_; ///< Coroutines waiting for the list.
+  };
+
+  /**
+   * Minimal coroutine type for tasks waiting on buttons. A ButtonTask runs as
+   * soon as it is called until its first co_await, and is then resumed by the
+   * handle() of the buttons it waits for. The coroutine is destroyed with the
+   * ButtonTask, so keep it (e.g. as a global) while it should run.
+   */
+  class ButtonTask {
+    public:
+      /**
+       * The promise of a ButtonTask, as required by C++20 coroutines.
+       */
+      struct promise_type {
+        ButtonTask get_return_object() { return ButtonTask(std::coroutine_handle<promise_type>::from_promise(*this)); } ///< Create the task.
+        std::suspend_never initial_suspend() noexcept { return {}; } ///< Run until the first co_await.
+        std::suspend_always final_suspend() noexcept { return {}; } ///< Keep the finished coroutine until the task is destroyed.
+        void return_void() {} ///< Finish the task.
+        void unhandled_exception() { std::terminate(); } ///< Exceptions are not supported.
+      };
+
+    public:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create a task owning a coroutine.
+       *
+       * @param handle The coroutine.
+       */
+      explicit ButtonTask(std::coroutine_handle<promise_type> handle): handle_(handle) {}
+
+      /**
+       * Move a task, so it can be returned and stored.
+       *
+       * @param task The task to move from.
+       */
+      ButtonTask(ButtonTask &&task): handle_(task.handle_) {
+        task.handle_ = nullptr;
+      }
+
+      /**
+       * Destroy the task and its coroutine.
+       */
+      ~ButtonTask() {
+        if(handle_) handle_.destroy();
+      }
+
+    private:
+      //
+      // Copying and assignment (not supported)...
+      //
+      ButtonTask(const ButtonTask &cpy) = delete; ///< Copying is not supported.
+      ButtonTask &operator=(const ButtonTask &) = delete; ///< Assigning is not supported.
+
+    public:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Determine if the task has finished.
+       *
+       * @return True if finished, else false.
+       */
+      bool done() const {
+        return !handle_ || handle_.done();
+      }
+
+    private:
+      //
+      // Data...
+      //
+      std::coroutine_handle<promise_type> handle_; ///< The coroutine.
+  };
+}
+#endif
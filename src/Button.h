@@ -14,7 +14,8 @@ namespace able {
    * using the Pin template parameter.
    * 
    * @param Circuit Either a PullupResistorCircuit or PulldownResistorCircuit
-   *                class matching the resistor circuit used with the button.
+   *                class matching the resistor circuit used with the button,
+   *                or MixedResistorCircuit to choose it for each pin.
    * @param Pin The Pin class, or a subclass (DebouncedPin or ClickerPin)
    *            providing additional debounced readings and clicked states.
    */
@@ -58,14 +59,35 @@ namespace able {
        * Initialise the button. Called from setup() of an Arduino program.
        */
       void begin() {
-        pinMode(this->pin_, Circuit::PIN_MODE);
+        begin(this->source());
+      }
+
+      /**
+       * Initialise the button configured by a source (see Pin::source()).
+       * Used by lists whose buttons do not hold their own pin (see
+       * ButtonTable).
+       *
+       * @param source The source of the pin.
+       */
+      void begin(typename Pin::Source source) {
+        pinMode(Pin::pin(source), Circuit::inputMode(source));
       }
 
       /**
        * Handle the button. Called from loop() of an Arduino program.
        */
       void handle() {
-        this->readPin();
+        handle(this->source());
+      }
+
+      /**
+       * Handle the button configured by a source (see Pin::source()). Used by
+       * lists whose buttons do not hold their own pin (see ButtonTable).
+       *
+       * @param source The source of the pin.
+       */
+      void handle(typename Pin::Source source) {
+        this->template readPin<Circuit>(source);
       }
 
       /**
@@ -134,7 +156,7 @@ namespace able {
        * @return True if held, else false.
        */
       bool isHeld() const {
-        return isPressed() && ((millis() - this->millisStart_) >= this->heldTime_);
+        return isPressed() && this->elapsed() >= this->heldTime_;
       }
 
       /**
@@ -143,7 +165,7 @@ namespace able {
        * @return True if idle, else false.
        */
       bool isIdle() const {
-        return !isPressed() && ((millis() - this->millisStart_) >= this->idleTime_);
+        return !isPressed() && this->elapsed() >= this->idleTime_;
       }
       
       /**
@@ -168,7 +190,7 @@ namespace able {
        * @return True if exclusively clicked else false.
        */
       bool isSingleClicked() const {
-        return this->stateCount_ == 2 && ((millis() - this->millisStart_) >= this->clickTime_);
+        return this->stateCount_ == 2 && this->elapsed() >= this->clickTime_;
       }
 
       /**
@@ -182,5 +204,17 @@ namespace able {
       bool isDoubleClicked() const {
         return this->stateCount_ >= 4;
       }
+
+      /**
+       * Return all the states of the button at once, reading the clock only
+       * once. Used by the snapshot() of a ButtonList. States the pin does not
+       * support (e.g. double-clicks of a ClickerPin) are never set.
+       *
+       * @return The ButtonStates bits of the button (e.g.
+       *         ButtonStates::PRESSED | ButtonStates::HELD).
+       */
+      uint8_t states() const {
+        return Pin::states(Circuit::BUTTON_PRESSED, Circuit::BUTTON_RELEASED);
+      }
   };
 }
@@ -0,0 +1,503 @@
+/**
+ * @file ButtonArray.h Definition of the ButtonArray template class. A button
+ * array holds the state of N double-clicker buttons itself, in a structure of
+ * arrays: the pins together, the debounced states together, the timestamps
+ * together, and so on, rather than in N separate button objects.
+ *
+ * A ButtonList reaches each button through a pointer, and each button's state
+ * is spread through the button object. Scanning a button array instead runs
+ * along a few small arrays, reading the clock once per scan rather than once
+ * per button, and queries of the whole array (e.g. anyPressed()) read just the
+ * array they need. Loops over the arrays have simple indexing on AVR boards,
+ * and may be vectorised by the compiler on larger processors.
+ *
+ * Buttons of an array debounce, and report their pressed, held, idle,
+ * clicked, single-clicked and double-clicked states, exactly as double-
+ * clicker buttons using the TimerDebouncer (e.g.
+ * AblePullupDoubleClickerButton): the array applies the debounce rule of the
+ * TimerDebouncer to each pin, and shares the held, idle and click rules, and
+ * the times, of the debounced pins timed by the same clock (see PinTimes).
+ * They do not call callback functions; poll them after handle(), or use a
+ * ButtonList of callback buttons.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#include <Arduino.h>
+#include "Pins.h"
+
+namespace able {
+  /**
+   * Button array template, holding the state of N buttons in contiguous
+   * arrays (see above). Buttons are identified by their position in the
+   * array (0 to N-1).
+   *
+   * @param Circuit The resistor circuit class of the buttons
+   *                (PullupResistorCircuit, PulldownResistorCircuit or
+   *                MixedResistorCircuit).
+   * @param N The number of buttons.
+   * @param Clock The clock class timing the buttons. Defaults to MillisClock.
+   */
+  template <typename Circuit, size_t N, typename Clock = MillisClock>
+  class ButtonArray: public PinTimes<Clock> {
+    public:
+      //
+      // Types...
+      //
+      typedef Clock PinClock; ///< The clock timing the buttons.
+      typedef typename Clock::Time Time; ///< Type of timestamps.
+
+    public:
+      //
+      // Static Members...
+      //
+
+      /**
+       * Set the debounce time for the buttons of all arrays and debounced pins
+       * timed by the same clock (see PinTimes).
+       *
+       * @param debounceTime The number of milliseconds (clock ticks) before a
+       *                     button state change is returned (default 50ms).
+       */
+      inline static void setDebounceTime(typename Clock::DebounceTime debounceTime) {
+        PinTimes<Clock>::debounceTime_ = debounceTime;
+      }
+
+      /**
+       * Set the held time for the buttons of all arrays and debounced pins
+       * timed by the same clock (see PinTimes).
+       *
+       * @param heldTime The number of milliseconds (clock ticks) for a held
+       *                 state (default 1s).
+       */
+      inline static void setHeldTime(typename Clock::HeldTime heldTime) {
+        PinTimes<Clock>::heldTime_ = heldTime;
+      }
+
+      /**
+       * Set the idle time for the buttons of all arrays and debounced pins
+       * timed by the same clock (see PinTimes).
+       *
+       * @param idleTime The number of milliseconds (clock ticks) for an idle
+       *                 state (default 60s).
+       */
+      inline static void setIdleTime(typename Clock::IdleTime idleTime) {
+        PinTimes<Clock>::idleTime_ = idleTime;
+      }
+
+      /**
+       * Set the click time for the buttons of all arrays and debounced pins
+       * timed by the same clock (see PinTimes).
+       *
+       * @param clickTime The number of milliseconds (clock ticks) between
+       *                  clicks (default 500ms).
+       */
+      inline static void setClickTime(typename Clock::HeldTime clickTime) {
+        PinTimes<Clock>::clickTime_ = clickTime / 2; // Halve clickTime as we count presses and releases.
+      }
+
+    public:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create an array of buttons on the specified pins.
+       *
+       * @param pins The pins connected to the buttons.
+       */
+      ButtonArray(const uint8_t (&pins)[N]) {
+        for(size_t i = 0; i < N; ++i) {
+          pins_[i] = pins[i];
+          currState_[i] = prevState_[i] = prevReading_[i] = Circuit::BUTTON_RELEASED;
+          stateCount_[i] = 0;
+          millisStart_[i] = prevMillis_[i] = 0;
+        }
+      }
+
+    private:
+      //
+      // Copying and assignment (not supported)...
+      //
+      ButtonArray(const ButtonArray &cpy) = delete; ///< Copying arrays is not supported.
+      ButtonArray &operator=(const ButtonArray &) = delete; ///< Assigning arrays is not supported.
+
+    public:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Initialise all the buttons. Called from setup() of an Arduino program.
+       */
+      void begin() {
+        for(size_t i = 0; i < N; ++i) {
+          pinMode(pins_[i], Circuit::inputMode(pins_[i]));
+        }
+      }
+
+      /**
+       * Handle all the buttons. Called in the loop() of an Arduino program to
+       * read and debounce the pins.
+       */
+      void handle() {
+        Time now = Clock::now();
+
+        for(size_t i = 0; i < N; ++i) {
+          uint8_t reading = digitalRead(pins_[i]) ^ Circuit::polarity(pins_[i]);
+
+          if(reading != prevReading_[i]) {
+            millisStart_[i] = now;
+          } else if(reading != currState_[i] && (Time)(now - millisStart_[i]) >= PinTimes<Clock>::debounceTime_) {
+            prevState_[i] = currState_[i];
+            currState_[i] = reading;
+            PinTimes<Clock>::countStateChange(stateCount_[i], prevMillis_[i], millisStart_[i]);
+          } else {
+            limitAge<Clock>(millisStart_[i], now); // Stay held or idle over the wrap of a short clock.
+          }
+          prevReading_[i] = reading;
+        }
+      }
+
+      /**
+       * Reset the clicked state of a button, returning what it was.
+       *
+       * @param i The position of the button.
+       *
+       * @return True if the button was clicked, else false.
+       */
+      bool resetClicked(size_t i) {
+        bool rc = isClicked(i);
+        prevState_[i] = currState_[i];
+        return rc;
+      }
+
+      /**
+       * Reset the single-clicked state of a button, returning what it was.
+       *
+       * @param i The position of the button.
+       *
+       * @return True if the button was single-clicked, else false.
+       */
+      bool resetSingleClicked(size_t i) {
+        bool rc = isSingleClicked(i);
+        if(rc) stateCount_[i] = 0;
+        return rc;
+      }
+
+      /**
+       * Reset the double-clicked state of a button, returning what it was.
+       *
+       * @param i The position of the button.
+       *
+       * @return True if the button was double-clicked, else false.
+       */
+      bool resetDoubleClicked(size_t i) {
+        bool rc = isDoubleClicked(i);
+        if(rc) stateCount_[i] = 0;
+        return rc;
+      }
+
+      /**
+       * Reset clicked state of all buttons, returning true if any were clicked.
+       *
+       * @return True if any clicked, else false.
+       */
+      bool resetClicked() {
+        bool rc = false;
+        for(size_t i = 0; i < N; ++i) {
+          rc = resetClicked(i) || rc;
+        }
+        return rc;
+      }
+
+      /**
+       * Reset single-clicked state of all buttons, returning true if any were
+       * single-clicked.
+       *
+       * @return True if any single-clicked, else false.
+       */
+      bool resetSingleClicked() {
+        bool rc = false;
+        for(size_t i = 0; i < N; ++i) {
+          rc = resetSingleClicked(i) || rc;
+        }
+        return rc;
+      }
+
+      /**
+       * Reset double-clicked state of all buttons, returning true if any were
+       * double-clicked.
+       *
+       * @return True if any double-clicked, else false.
+       */
+      bool resetDoubleClicked() {
+        bool rc = false;
+        for(size_t i = 0; i < N; ++i) {
+          rc = resetDoubleClicked(i) || rc;
+        }
+        return rc;
+      }
+
+    public:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Return the number of buttons in the array.
+       *
+       * @return The number of buttons.
+       */
+      static inline size_t size() {
+        return N;
+      }
+
+      /**
+       * Return the pin of a button.
+       *
+       * @param i The position of the button.
+       *
+       * @return The Arduino pin.
+       */
+      inline uint8_t pin(size_t i) const {
+        return pins_[i];
+      }
+
+      /**
+       * Determine if a button is currently pressed.
+       *
+       * @param i The position of the button.
+       *
+       * @return True if pressed, else false.
+       */
+      inline bool isPressed(size_t i) const {
+        return currState_[i] == Circuit::BUTTON_PRESSED;
+      }
+
+      /**
+       * Determine if a button is currently held down.
+       *
+       * @param i The position of the button.
+       *
+       * @return True if held, else false.
+       */
+      inline bool isHeld(size_t i) const {
+        return PinTimes<Clock>::timedStates(isPressed(i), elapsed<Clock>(millisStart_[i])) & ButtonStates::HELD;
+      }
+
+      /**
+       * Determine if a button is currently idle (unpressed for a "long" time).
+       *
+       * @param i The position of the button.
+       *
+       * @return True if idle, else false.
+       */
+      inline bool isIdle(size_t i) const {
+        return PinTimes<Clock>::timedStates(isPressed(i), elapsed<Clock>(millisStart_[i])) & ButtonStates::IDLE;
+      }
+
+      /**
+       * Determine if a button is clicked (pressed then released).
+       *
+       * @param i The position of the button.
+       *
+       * @return True if clicked, else false.
+       */
+      inline bool isClicked(size_t i) const {
+        return currState_[i] == Circuit::BUTTON_RELEASED && prevState_[i] == Circuit::BUTTON_PRESSED;
+      }
+
+      /**
+       * Determine if a button is exclusively single-clicked, once the double-
+       * click time has passed.
+       *
+       * @param i The position of the button.
+       *
+       * @return True if exclusively clicked, else false.
+       */
+      inline bool isSingleClicked(size_t i) const {
+        return PinTimes<Clock>::clickStates(stateCount_[i], elapsed<Clock>(millisStart_[i])) & ButtonStates::SINGLE_CLICKED;
+      }
+
+      /**
+       * Determine if a button is double-clicked.
+       *
+       * @param i The position of the button.
+       *
+       * @return True if double-clicked, else false.
+       */
+      inline bool isDoubleClicked(size_t i) const {
+        return PinTimes<Clock>::clickStates(stateCount_[i], 0) & ButtonStates::DOUBLE_CLICKED;
+      }
+
+      /**
+       * Determine if all of the buttons are currently pressed.
+       *
+       * @return True if all pressed, else false.
+       */
+      bool allPressed() const {
+        return countStates(ButtonStates::PRESSED) == N;
+      }
+
+      /**
+       * Determine if any of the buttons are currently pressed.
+       *
+       * @return True if any pressed, else false.
+       */
+      bool anyPressed() const {
+        return countStates(ButtonStates::PRESSED) != 0;
+      }
+
+      /**
+       * Determine if all of the buttons are currently held.
+       *
+       * @return True if all held, else false.
+       */
+      bool allHeld() const {
+        return countStates(ButtonStates::HELD) == N;
+      }
+
+      /**
+       * Determine if any of the buttons are currently held.
+       *
+       * @return True if any held, else false.
+       */
+      bool anyHeld() const {
+        return countStates(ButtonStates::HELD) != 0;
+      }
+
+      /**
+       * Determine if all of the buttons are currently idle.
+       *
+       * @return True if all idle, else false.
+       */
+      bool allIdle() const {
+        return countStates(ButtonStates::IDLE) == N;
+      }
+
+      /**
+       * Determine if any of the buttons are currently idle.
+       *
+       * @return True if any idle, else false.
+       */
+      bool anyIdle() const {
+        return countStates(ButtonStates::IDLE) != 0;
+      }
+
+      /**
+       * Determine if all of the buttons are clicked.
+       *
+       * @return True if all clicked, else false.
+       */
+      bool allClicked() const {
+        return countStates(ButtonStates::CLICKED) == N;
+      }
+
+      /**
+       * Determine if any of the buttons are clicked.
+       *
+       * @return True if any clicked, else false.
+       */
+      bool anyClicked() const {
+        return countStates(ButtonStates::CLICKED) != 0;
+      }
+
+      /**
+       * Determine if all of the buttons are double-clicked.
+       *
+       * @return True if all double-clicked, else false.
+       */
+      bool allDoubleClicked() const {
+        return countStates(ButtonStates::DOUBLE_CLICKED) == N;
+      }
+
+      /**
+       * Determine if any of the buttons are double-clicked.
+       *
+       * @return True if any double-clicked, else false.
+       */
+      bool anyDoubleClicked() const {
+        return countStates(ButtonStates::DOUBLE_CLICKED) != 0;
+      }
+
+      /**
+       * Determine if all of the buttons are single-clicked.
+       *
+       * @return True if all single-clicked, else false.
+       */
+      bool allSingleClicked() const {
+        return countStates(ButtonStates::SINGLE_CLICKED) == N;
+      }
+
+      /**
+       * Determine if any of the buttons are single-clicked.
+       *
+       * @return True if any single-clicked, else false.
+       */
+      bool anySingleClicked() const {
+        return countStates(ButtonStates::SINGLE_CLICKED) != 0;
+      }
+
+    protected:
+      /**
+       * Count the buttons in a state, reading the clock at most once.
+       *
+       * @param state The ButtonStates bit of the state (e.g.
+       *              ButtonStates::HELD).
+       *
+       * @return The number of buttons in the state.
+       */
+      size_t countStates(uint8_t state) const {
+        size_t count = 0;
+        switch(state) {
+          case ButtonStates::PRESSED:
+            for(size_t i = 0; i < N; ++i) {
+              count += currState_[i] == Circuit::BUTTON_PRESSED;
+            }
+            break;
+
+          case ButtonStates::CLICKED:
+            for(size_t i = 0; i < N; ++i) {
+              count += currState_[i] == Circuit::BUTTON_RELEASED && prevState_[i] == Circuit::BUTTON_PRESSED;
+            }
+            break;
+
+          case ButtonStates::DOUBLE_CLICKED:
+            for(size_t i = 0; i < N; ++i) {
+              count += (PinTimes<Clock>::clickStates(stateCount_[i], 0) & state) != 0;
+            }
+            break;
+
+          case ButtonStates::SINGLE_CLICKED: {
+            Time now = Clock::now();
+            for(size_t i = 0; i < N; ++i) {
+              count += (PinTimes<Clock>::clickStates(stateCount_[i], now - millisStart_[i]) & state) != 0;
+            }
+            break;
+          }
+
+          default: { // Held or idle.
+            Time now = Clock::now();
+            for(size_t i = 0; i < N; ++i) {
+              count += (PinTimes<Clock>::timedStates(currState_[i] == Circuit::BUTTON_PRESSED, now - millisStart_[i]) & state) != 0;
+            }
+            break;
+          }
+        }
+        return count;
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      uint8_t pins_[N]; ///< The pins of the buttons.
+      uint8_t currState_[N]; ///< The debounced states of the buttons.
+      uint8_t prevState_[N]; ///< The previous debounced states, to identify clicks.
+      uint8_t prevReading_[N]; ///< The previous pin readings.
+      uint8_t stateCount_[N]; ///< Changes in state within the double-click time.
+      Time millisStart_[N]; ///< When each pin last changed.
+      Time prevMillis_[N]; ///< When each button's debounced state last changed.
+  };
+}
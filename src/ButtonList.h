@@ -15,8 +15,13 @@ namespace able {
    * same button list. Use separate lists to manage collections of pulldown, 
    * and pull-up resistors, buttons and clickers) s in the same list (use
    * separate lists).
+   *
+   * @param Button The button class of the list.
+   * @param Buttons The type holding the buttons, indexed to give a pointer
+   *                to each button. Defaults to an array of button pointers
+   *                (see ButtonTable for buttons held by the list itself).
    */
-  template <typename Button>
+  template <typename Button, typename Buttons = Button **>
   class ButtonList {
     public:
       //
@@ -40,7 +45,17 @@ namespace able {
        * @param len The number of buttons in the list.
        */
       inline ButtonList(Button **buttons, size_t len)
-      : buttons_(buttons), len_(len) {}
+      : buttons_(buttons), len_(len), anyStates_(0), allStates_(0) {}
+
+    protected:
+      /**
+       * Protected constructor used by sub-classes holding the buttons in
+       * buttons_ themselves (see ButtonTable).
+       *
+       * @param len The number of buttons in the list.
+       */
+      inline explicit ButtonList(size_t len)
+      : len_(len), anyStates_(0), allStates_(0) {}
 
     public:
       //
@@ -51,6 +66,7 @@ namespace able {
        * Initialise all the buttons. Called from setup() of an Arduino program.
        */
       inline void begin() { 
+        anyStates_ = 0;
         for(size_t i = 0; i < len_; ++i) {
           buttons_[i]->begin(); 
         } 
@@ -61,11 +77,36 @@ namespace able {
        * monitor all button states and dispatch any callback events if required.
        */
       void handle() {
+        anyStates_ = 0;
         for(size_t i = 0; i < len_; ++i) {
           buttons_[i]->handle();
         }
       }
 
+      /**
+       * Read the states of all the buttons in a single pass, reading the clock
+       * once per button. Until the list is next handled, begun or reset, the
+       * any and all queries (e.g. anyPressed()) read the snapshot rather than
+       * each button. Handling or resetting buttons directly (rather than the
+       * list) leaves the snapshot out of date until then.
+       *
+       *     ButtonStates states = btnList.snapshot();
+       *     if(states.clicked & 0x05) {
+       *       // The first or third button was clicked...
+       *     }
+       *     if(btnList.allHeld()) {
+       *       // Read from the snapshot...
+       *     }
+       *
+       * @return The states of the buttons.
+       */
+      ButtonStates snapshot() {
+        ButtonStates rc = readStates();
+        anyStates_ = rc.any | SNAPSHOT;
+        allStates_ = rc.all;
+        return rc;
+      }
+
       /**
        * Reset clicked state of all buttons, returning true if any were clicked.
        * 
@@ -73,6 +114,7 @@ namespace able {
        */
       bool resetClicked() {
         bool rc = false;
+        anyStates_ = 0;
         for(size_t i = 0; i < len_; ++i) {
           if(buttons_[i]->resetClicked()) {
             rc = true;
@@ -89,6 +131,7 @@ namespace able {
        */
       bool resetDoubleClicked() {
         bool rc = false;
+        anyStates_ = 0;
         for(size_t i = 0; i < len_; ++i) {
           if(buttons_[i]->resetDoubleClicked()) {
             rc = true;
@@ -105,6 +148,7 @@ namespace able {
        */
       bool resetSingleClicked() {
         bool rc = false;
+        anyStates_ = 0;
         for(size_t i = 0; i < len_; ++i) {
           if(buttons_[i]->resetSingleClicked()) {
             rc = true;
@@ -113,6 +157,34 @@ namespace able {
         return rc;
       }
 
+      /**
+       * For buttons using PinCounters, reset the counts of all the buttons.
+       */
+      void resetCounts() {
+        for(size_t i = 0; i < len_; ++i) {
+          buttons_[i]->resetCounts();
+        }
+      }
+
+      /**
+       * For buttons using BounceHistogram, set the debounce time of each button
+       * just above the percentile of its bounce histogram. Buttons without
+       * enough bounces measured are left unchanged.
+       * 
+       * @param percentile The percentage (1-100) of bursts to debounce.
+       * 
+       * @return The number of buttons tuned.
+       */
+      size_t autoTune(uint8_t percentile) {
+        size_t rc = 0;
+        for(size_t i = 0; i < len_; ++i) {
+          if(buttons_[i]->autoTune(percentile)) {
+            ++rc;
+          }
+        }
+        return rc;
+      }
+
     public:
       //
       // Accessors...
@@ -120,9 +192,9 @@ namespace able {
 
       /**
        * For CallbackButtons (which each have an id), return a pointer to the
-       * first button matching the id (or a null pointer if the id is not
-       * found). When using the button, always check if the return value is
-       * non-zero.
+       * button matching the id (or a null pointer if the id is not found).
+       * Ids should be unique; if not, any matching button may be returned.
+       * When using the button, always check if the return value is non-zero.
        * 
        *       Button *btn = btnList.button(id);
        *       if(btn) {
@@ -131,11 +203,23 @@ namespace able {
        *         // Id not found in list...
        *       }
        * 
+       * When ids increase by one through the list (as auto-assigned ids do
+       * when the buttons are created in list order), the button is found
+       * directly from the id without searching, however long the list.
+       * 
        * @param id The identifier of the button to find in the list.
        * 
-       * @return The first id-matching button, or a null pointer.
+       * @return The id-matching button, or a null pointer.
        */
-      Button *button(uint8_t id) const {
+      Button *button(ButtonId id) const {
+        if(!len_) return 0;
+
+        // Buttons in id order: the button is at the id's offset from the first.
+        size_t i = (ButtonId)(id - buttons_[0]->id());
+        if(i < len_ && buttons_[i]->id() == id) {
+          return buttons_[i];
+        }
+
         Button *rc = 0;
         for(size_t i = 0; i < len_; ++i) {
           if(buttons_[i]->id() == id ) {
@@ -152,6 +236,7 @@ namespace able {
        * @return True if all pressed, else false.
        */
       bool allPressed() const {
+        if(anyStates_ & SNAPSHOT) return allStates_ & ButtonStates::PRESSED;
         bool rc = true;
         for(size_t i = 0; i < len_; ++i) {
           if(!buttons_[i]->isPressed()) {
@@ -167,6 +252,7 @@ namespace able {
        * @return True if any pressed, else false.
        */
       bool anyPressed() const {
+        if(anyStates_ & SNAPSHOT) return anyStates_ & ButtonStates::PRESSED;
         bool rc = false;
         for(size_t i = 0; i < len_; ++i) {
           if(buttons_[i]->isPressed()) {
@@ -182,6 +268,7 @@ namespace able {
        * @return True if all held, else false.
        */
       bool allHeld() const {
+        if(anyStates_ & SNAPSHOT) return allStates_ & ButtonStates::HELD;
         bool rc = true;
         for(size_t i = 0; i < len_; ++i) {
           if(!buttons_[i]->isHeld()) {
@@ -197,6 +284,7 @@ namespace able {
        * @return True if any held, else false.
        */
       bool anyHeld() const {
+        if(anyStates_ & SNAPSHOT) return anyStates_ & ButtonStates::HELD;
         bool rc = false;
         for(size_t i = 0; i < len_; ++i) {
           if(buttons_[i]->isHeld()) {
@@ -212,6 +300,7 @@ namespace able {
        * @return True if all idle, else false.
        */
       bool allIdle() const {
+        if(anyStates_ & SNAPSHOT) return allStates_ & ButtonStates::IDLE;
         bool rc = true;
         for(size_t i = 0; i < len_; ++i) {
           if(!buttons_[i]->isIdle()) {
@@ -227,6 +316,7 @@ namespace able {
        * @return True if any idle, else false.
        */
       bool anyIdle() const {
+        if(anyStates_ & SNAPSHOT) return anyStates_ & ButtonStates::IDLE;
         bool rc = false;
         for(size_t i = 0; i < len_; ++i) {
           if(buttons_[i]->isIdle()) {
@@ -242,6 +332,7 @@ namespace able {
        * @return True if all pressed, else false.
        */
       bool allClicked() const {
+        if(anyStates_ & SNAPSHOT) return allStates_ & ButtonStates::CLICKED;
         bool rc = true;
         for(size_t i = 0; i < len_; ++i) {
           if(!buttons_[i]->isClicked()) {
@@ -257,6 +348,7 @@ namespace able {
        * @return True if any clicked, else false.
        */
       bool anyClicked() const {
+        if(anyStates_ & SNAPSHOT) return anyStates_ & ButtonStates::CLICKED;
         bool rc = false;
         for(size_t i = 0; i < len_; ++i) {
           if(buttons_[i]->isClicked()) {
@@ -272,6 +364,7 @@ namespace able {
        * @return True if all double-clicked, else false.
        */
       bool allDoubleClicked() const {
+        if(anyStates_ & SNAPSHOT) return allStates_ & ButtonStates::DOUBLE_CLICKED;
         bool rc = true;
         for(size_t i = 0; i < len_; ++i) {
           if(!buttons_[i]->isDoubleClicked()) {
@@ -287,6 +380,7 @@ namespace able {
        * @return True if any double-clicked, else false.
        */
       bool anyDoubleClicked() const {
+        if(anyStates_ & SNAPSHOT) return anyStates_ & ButtonStates::DOUBLE_CLICKED;
         bool rc = false;
         for(size_t i = 0; i < len_; ++i) {
           if(buttons_[i]->isDoubleClicked()) {
@@ -302,6 +396,7 @@ namespace able {
        * @return True if all single-clicked, else false.
        */
       bool allSingleClicked() const {
+        if(anyStates_ & SNAPSHOT) return allStates_ & ButtonStates::SINGLE_CLICKED;
         bool rc = true;
         for(size_t i = 0; i < len_; ++i) {
           if(!buttons_[i]->isSingleClicked()) {
@@ -317,6 +412,7 @@ namespace able {
        * @return True if any single-clicked, else false.
        */
       bool anySingleClicked() const {
+        if(anyStates_ & SNAPSHOT) return anyStates_ & ButtonStates::SINGLE_CLICKED;
         bool rc = false;
         for(size_t i = 0; i < len_; ++i) {
           if(buttons_[i]->isSingleClicked()) {
@@ -326,11 +422,99 @@ namespace able {
         return rc;
       }
 
-    private:
+      /**
+       * For buttons using PinCounters, return the counts totalled across all
+       * the buttons. The maxBurst is the largest of all the buttons.
+       * 
+       * @return The total counts of the buttons in the list.
+       */
+      PinCounts counts() const {
+        PinCounts rc = {0, 0, 0, 0, 0, 0};
+        for(size_t i = 0; i < len_; ++i) {
+          const PinCounts &counts = buttons_[i]->counts();
+          rc.bounces += counts.bounces;
+          rc.presses += counts.presses;
+          rc.holds += counts.holds;
+          rc.clicks += counts.clicks;
+          rc.doubleClicks += counts.doubleClicks;
+          if(counts.maxBurst > rc.maxBurst) rc.maxBurst = counts.maxBurst;
+        }
+        return rc;
+      }
+
+      /**
+       * For buttons using PinCounters, print the counts of each button (by
+       * position in the list) followed by the totals. Output goes to Serial
+       * unless another print-stream is given.
+       * 
+       * @param out The print-stream to output to (default Serial).
+       */
+      void printCounts(Print &out = Serial) const {
+        for(size_t i = 0; i < len_; ++i) {
+          out.print(F("Button "));
+          out.print(i);
+          out.print(F(": "));
+          able::printCounts(out, buttons_[i]->counts());
+        }
+        out.print(F("Total: "));
+        able::printCounts(out, counts());
+      }
+
+      /**
+       * For buttons using BounceHistogram, print the bounce histogram and
+       * debounce time of each button (by position in the list). Output goes
+       * to Serial unless another print-stream is given.
+       * 
+       * @param out The print-stream to output to (default Serial).
+       */
+      void printHistograms(Print &out = Serial) const {
+        for(size_t i = 0; i < len_; ++i) {
+          out.print(F("Button "));
+          out.print(i);
+          out.print(F(": debounce="));
+          printTicks<typename Button::PinClock>(out, buttons_[i]->tunedDebounceTime() ? buttons_[i]->tunedDebounceTime() : Button::debounceTime());
+          out.print(' ');
+          buttons_[i]->template printHistogram<typename Button::PinClock>(out);
+        }
+      }
+
+    protected:
+      /**
+       * Read the states of all the buttons in a single pass (see snapshot()).
+       *
+       * @return The states of the buttons.
+       */
+      ButtonStates readStates() const {
+        ButtonStates rc = {0, 0, 0, 0, 0, 0, 0, ButtonStates::ALL_STATES};
+        uint32_t bit = 1;
+        for(size_t i = 0; i < len_; ++i, bit <<= 1) {
+          uint8_t states = buttons_[i]->states();
+          if(states & ButtonStates::PRESSED) rc.pressed |= bit;
+          if(states & ButtonStates::HELD) rc.held |= bit;
+          if(states & ButtonStates::IDLE) rc.idle |= bit;
+          if(states & ButtonStates::CLICKED) rc.clicked |= bit;
+          if(states & ButtonStates::SINGLE_CLICKED) rc.singleClicked |= bit;
+          if(states & ButtonStates::DOUBLE_CLICKED) rc.doubleClicked |= bit;
+          rc.any |= states;
+          rc.all &= states;
+        }
+        return rc;
+      }
+
+    protected:
+      //
+      // Constants...
+      //
+      enum {
+        SNAPSHOT = 128 ///< Flag set in anyStates_ while the snapshot is current.
+      };
+
       //
       // Data...
       //
-      Button **buttons_; ///< The array of buttons to manage together.
+      Buttons buttons_; ///< The array of buttons to manage together.
       size_t len_; ///< The length o the button array.
+      uint8_t anyStates_; ///< States of any button at the last snapshot(), plus SNAPSHOT while current.
+      uint8_t allStates_; ///< States of all buttons at the last snapshot().
   };
 }
@@ -6,6 +6,7 @@
  */
 #pragma once
 #include "Button.h"
+#include "Callbacks.h"
 
 namespace able {
   /**
@@ -13,22 +14,27 @@ namespace able {
    * 
    * @param Button The base button class for Callback. Defaults to the Button
    *               template class.
+   * @param Callback The callback class (UntimedCallback, TimedCallback or
+   *                 DeferredCallback) defining the callback function
+   *                 arguments and when it is called. Defaults to
+   *                 UntimedCallback.
+   * @param TIMED The timed events to send (see CallbackEvents::TIMED_EVENTS).
+   *              Defaults to held and idle events. Events not sent are not
+   *              checked, so cost no time or memory.
    */
-  template <typename Button>
-  class CallbackButton: public Button {
+  template <typename Button, typename Callback = UntimedCallback, uint8_t TIMED = CallbackEvents::ALL_TIMED_EVENTS>
+  class CallbackButton: public Button, public CallbackEvents, protected Callback {
     public:
-      /**
-       * Button event codes. When a callback function is called, the first
-       * argument is an event code below.
-       */
-      enum CALLBACK_EVENT {
-        BEGIN_EVENT, ///< The button's begin() method has completed.
-        PRESSED_EVENT, ///< The button has been pressed.
-        RELEASED_EVENT, ///< The button has been released.
-        HELD_EVENT, ///< The button has been held down for a while.
-        IDLE_EVENT, ///< The button has been idle (untouched) for a while.
-        SINGLE_CLICKED_EVENT, ///< The button has been clicked (pressed+released).
-        DOUBLE_CLICKED_EVENT  ///< The button has been double-clicked.
+      //
+      // Types...
+      //
+      typedef typename Callback::CallbackFn CallbackFn; ///< The callback function type.
+
+      //
+      // Constants...
+      //
+      enum {
+        TIMED_EVENTS_SENT = TIMED ///< The timed events sent (see TIMED_EVENTS).
       };
 
     public:
@@ -44,9 +50,9 @@ namespace able {
        * @param id Callback identifier for the button (default auto-assigned).
        */ 
       inline CallbackButton(uint8_t pin,
-                     void(*callbackFn)(enum CALLBACK_EVENT, uint8_t) = 0,
-                     uint8_t id = Pin::nextId())
-      :Button(pin), callbackFn_(callbackFn), id_(id) {}
+                     CallbackFn callbackFn = 0,
+                     ButtonId id = Pin::nextId())
+      :Button(pin), id_(id), callbackFn_(callbackFn) {}
 
     private:
       //
@@ -64,7 +70,16 @@ namespace able {
        * Initialise the button. Called from setup() of an Arduino program.
        */
       void begin() {
-        Button::begin();
+        begin(this->source());
+      }
+
+      /**
+       * Initialise the button configured by a source (see Button::begin()).
+       *
+       * @param source The source of the pin.
+       */
+      void begin(typename Button::Source source) {
+        Button::begin(source);
         this->doCallback(BEGIN_EVENT);
       }
 
@@ -72,18 +87,22 @@ namespace able {
        * Handle the button. Called from loop() of an Arduino program.
        */
       void handle() {
-        uint8_t currState = this->currState_;
-        Button::handle();
-        if(currState != this->currState_) {
-          if(this->isPressed()) {
-            this->doCallback(PRESSED_EVENT);
-          } else {
-            this->doCallback(RELEASED_EVENT);
-          }
-        } else if(lastEvent_ != HELD_EVENT && this->isHeld()) {
-            this->doCallback(HELD_EVENT);
-        } else if(lastEvent_ != IDLE_EVENT && this->isIdle()) {
-            this->doCallback(IDLE_EVENT);
+        handle(this->source());
+      }
+
+      /**
+       * Handle the button configured by a source (see Button::handle()).
+       *
+       * @param source The source of the pin.
+       */
+      void handle(typename Button::Source source) {
+        if(handlePin(source)) {
+          return;
+        }
+        if((TIMED & HELD_EVENTS) && lastEvent_ != HELD_EVENT && this->isHeld()) {
+          this->doCallback(HELD_EVENT);
+        } else if((TIMED & IDLE_EVENTS) && lastEvent_ != IDLE_EVENT && this->isIdle()) {
+          this->doCallback(IDLE_EVENT);
         }
       }
       
@@ -93,14 +112,58 @@ namespace able {
        * @param callbackFn The function to call for a button event. Use 0 to
        *                   clear the callback function.
        */
-      inline void setCallback(void(*callbackFn)(CALLBACK_EVENT, uint8_t)) {
+      inline void setCallback(CallbackFn callbackFn) {
         callbackFn_ = callbackFn;
       }
 
     protected:
+      /**
+       * Read the pin, calling the callback function if the button was pressed
+       * or released, without checking the held and idle times.
+       * 
+       * @return True if the button was pressed or released, else false.
+       */
+      inline bool handlePin() {
+        return handlePin(this->source());
+      }
+
+      /**
+       * Read the pin configured by a source, calling the callback function if
+       * the button was pressed or released (see handlePin()).
+       *
+       * @param source The source of the pin.
+       *
+       * @return True if the button was pressed or released, else false.
+       */
+      inline bool handlePin(typename Button::Source source) {
+        uint8_t currState = this->currState_;
+        Button::handle(source);
+        if(currState != this->currState_) {
+          if(this->isPressed()) {
+            this->doCallback(PRESSED_EVENT);
+          } else {
+            this->doCallback(RELEASED_EVENT);
+          }
+          return true;
+        }
+        return false;
+      }
+
+      /**
+       * Call the callback function for any clicks. Nothing to do, as callback
+       * buttons do not send click events (see CallbackClickerButton).
+       */
+      inline void handleClicks() {}
+
+      /**
+       * Record the event and call the callback function. The timestamp of the
+       * last debounced edge is passed to the Callback class for timings.
+       * 
+       * @param event The event to send to the callback function.
+       */
       inline void doCallback(CALLBACK_EVENT event) {
         lastEvent_ = event;
-        if(callbackFn_) callbackFn_(event, id_);
+        Callback::template call<typename Button::PinClock>(callbackFn_, event, id_, this->millisStart_);
       }
 
     public:
@@ -113,7 +176,7 @@ namespace able {
        * 
        * @return The id of the button (auto-assigned or set when created).
        */
-      inline uint8_t id() const {
+      inline ButtonId id() const {
         return id_;
       }
     
@@ -121,9 +184,9 @@ namespace able {
       //
       // Data...
       //
-      void (*callbackFn_)(enum CALLBACK_EVENT, uint8_t); ///< Callback function.
-      uint8_t id_; ///< Identifier for the button passed to callback functions.
+      ButtonId id_; ///< Identifier for the button passed to callback functions.
       CALLBACK_EVENT lastEvent_; ///< Indicates the last event sent.
+      CallbackFn callbackFn_; ///< Callback function (after the smaller members, which can share the padding of the callback class).
   };
 
   /**
@@ -147,8 +210,8 @@ namespace able {
        * @param id Callback identifier for the button (default auto-assigned).
        */ 
       inline CallbackClickerButton(uint8_t pin,
-                     void(*callbackFn)(enum Button::CALLBACK_EVENT, uint8_t) = 0,
-                     uint8_t id = Pin::nextId())
+                     typename Button::CallbackFn callbackFn = 0,
+                     ButtonId id = Pin::nextId())
       :Button(pin, callbackFn, id) {}
 
     private:
@@ -167,7 +230,37 @@ namespace able {
        * Handle the button. Called from loop() of an Arduino program.
        */
       void handle() {
-        Button::handle();
+        handle(this->source());
+      }
+
+      /**
+       * Handle the button configured by a source (see Button::handle()).
+       *
+       * @param source The source of the pin.
+       */
+      void handle(typename Button::Source source) {
+        Button::handle(source);
+        handleClicks();
+      }
+
+    protected:
+      /**
+       * Read the pin, calling the callback function if the button was pressed
+       * or released, or for a click known when released (e.g. a double-click).
+       * 
+       * @return True if the button was pressed or released, else false.
+       */
+      inline bool handlePin() {
+        bool rc = Button::handlePin();
+        handleClicks();
+        return rc;
+      }
+
+      /**
+       * Call the callback function if the button was released and has been
+       * single-clicked or double-clicked.
+       */
+      inline void handleClicks() {
         if(this->lastEvent_ == Button::RELEASED_EVENT) {
           switch(Button::clicks(Button::BUTTON_PRESSED, Button::BUTTON_RELEASED)){
             case 1:
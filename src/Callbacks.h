@@ -0,0 +1,438 @@
+/**
+ * @file Callbacks.h Definition of the callback event codes and the callback
+ * classes (UntimedCallback, TimedCallback and DeferredCallback) used by
+ * CallbackButton to call a user-supplied function when button events occur.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#include <Arduino.h>
+#include "Clocks.h"
+#include "Ids.h"
+
+namespace able {
+  /**
+   * Callback event codes. All callback classes (and so all callback buttons)
+   * share these event codes. Access them through the button type (e.g.
+   * `Button::PRESSED_EVENT`).
+   */
+  class CallbackEvents {
+    public:
+      /**
+       * Button event codes. When a callback function is called, the first
+       * argument is an event code below.
+       */
+      enum CALLBACK_EVENT {
+        BEGIN_EVENT, ///< The button's begin() method has completed.
+        PRESSED_EVENT, ///< The button has been pressed.
+        RELEASED_EVENT, ///< The button has been released.
+        HELD_EVENT, ///< The button has been held down for a while.
+        IDLE_EVENT, ///< The button has been idle (untouched) for a while.
+        SINGLE_CLICKED_EVENT, ///< The button has been clicked (pressed+released).
+        DOUBLE_CLICKED_EVENT  ///< The button has been double-clicked.
+      };
+
+      /**
+       * Timed events sent by a callback button, combined as the TIMED
+       * argument of CallbackButton. Held and idle times are only checked for
+       * the events chosen, so a button sending neither reads no clock and
+       * keeps no held or idle time once it is debounced.
+       */
+      enum TIMED_EVENTS {
+        NO_TIMED_EVENTS = 0x00, ///< Send only pressed, released and click events.
+        HELD_EVENTS = 0x01, ///< Send held events.
+        IDLE_EVENTS = 0x02, ///< Send idle events.
+        ALL_TIMED_EVENTS = 0x03 ///< Send held and idle events (the default).
+      };
+  };
+
+  /**
+   * Timing of a button event, passed to the callback function of a button
+   * using the TimedCallback class. Times are taken from the debounced edges
+   * of the button signal rather than when handle() was called, so they are not
+   * affected by how long the loop() takes. Times are in ticks of the clock of
+   * the button (milliseconds with the default MillisClock).
+   */
+  struct EventTiming {
+    /**
+     * The millisecond timestamp of the debounced edge causing the event. For
+     * held events it is when the button was pressed. For idle events it is
+     * when the button was released. For click events it is the release
+     * completing the click.
+     */
+    unsigned long millis;
+
+    /**
+     * The number of milliseconds the button was in its previous state. For a
+     * pressed event, how long it was released (zero until the button has
+     * been released since it began). For a released event or a
+     * click event, how long it was pressed. For held and idle events, how long
+     * it has been pressed or released so far.
+     */
+    unsigned long duration;
+
+    /**
+     * For click events, the number of milliseconds between the press starting
+     * this click and the press before it (the inter-click interval). Zero for
+     * other events and the first press since the button began.
+     */
+    unsigned long interval;
+  };
+
+  /**
+   * Callback class calling a function with the event code and button id. This
+   * is the default for CallbackButton and needs no memory of its own.
+   */
+  class UntimedCallback {
+    public:
+      /// The callback function type: `void fn(Button::CALLBACK_EVENT event, ButtonId id)` (see Ids.h).
+      typedef void (*CallbackFn)(CallbackEvents::CALLBACK_EVENT, ButtonId);
+
+    protected:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Call the callback function (if there is one).
+       *
+       * @param callbackFn The callback function to call (may be 0).
+       * @param event The event that occurred.
+       * @param id The identifier of the button.
+       * @param edgeMillis The timestamp of the last debounced edge (unused).
+       */
+      template <typename Clock>
+      inline void call(CallbackFn callbackFn, CallbackEvents::CALLBACK_EVENT event, ButtonId id, typename Clock::Time /* edgeMillis */) {
+        if(callbackFn) callbackFn(event, id);
+      }
+  };
+
+  /**
+   * Callback class calling a function with the event code, button id and the
+   * EventTiming of the event. Remembers the last press and release edges of
+   * the button, and the interval between the last two presses, in timestamps
+   * of the clock of the button, plus a byte of the edges seen: 13 bytes per
+   * button with the MillisClock, 7 with the Millis16Clock.
+   *
+   * @param Clock The clock class of the button (e.g. MillisClock, the
+   *              default). Must match the clock of the button's pin.
+   */
+  template <typename Clock = MillisClock>
+  class TimedCallback {
+    public:
+      /// The callback function type: `void fn(Button::CALLBACK_EVENT event, ButtonId id, const able::EventTiming &timing)` (see Ids.h).
+      typedef void (*CallbackFn)(CallbackEvents::CALLBACK_EVENT, ButtonId, const EventTiming &);
+
+    protected:
+      //
+      // Types...
+      //
+      typedef typename Clock::Time Time; ///< Type of timestamps.
+
+      //
+      // Constants...
+      //
+      enum {
+        PRESS_SEEN = 1, ///< Flag set once a press edge has been seen.
+        RELEASE_SEEN = 2 ///< Flag set once a release edge has been seen.
+      };
+
+    protected:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create the timed callback with no edges recorded.
+       */
+      inline TimedCallback()
+      :pressMillis_(0), releaseMillis_(0), interval_(0), edges_(0) {}
+
+    protected:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Work out the timing of the event and call the callback function (if
+       * there is one). Edges are recorded even without a callback function so
+       * timings are correct once a callback function is set. Until a release
+       * (or a press) has been seen since the button began, the duration of a
+       * press (or the interval of a click) is 0.
+       *
+       * @param PinClock The clock class of the button's pin.
+       * @param callbackFn The callback function to call (may be 0).
+       * @param event The event that occurred.
+       * @param id The identifier of the button.
+       * @param edgeMillis The timestamp of the last debounced edge.
+       */
+      template <typename PinClock>
+      void call(CallbackFn callbackFn, CallbackEvents::CALLBACK_EVENT event, ButtonId id, typename PinClock::Time edgeMillis) {
+        static_assert(sizeof(typename PinClock::Time) == sizeof(Time), "TimedCallback clock must match the clock of the button");
+        EventTiming timing;
+
+        switch(event) {
+          case CallbackEvents::BEGIN_EVENT:
+            pressMillis_ = releaseMillis_ = Clock::now();
+            edges_ = 0;
+            timing.millis = releaseMillis_;
+            timing.duration = 0;
+            timing.interval = 0;
+            break;
+
+          case CallbackEvents::PRESSED_EVENT:
+            interval_ = (edges_ & PRESS_SEEN) ? (Time)(edgeMillis - pressMillis_) : 0;
+            pressMillis_ = edgeMillis;
+            edges_ |= PRESS_SEEN;
+            timing.millis = edgeMillis;
+            timing.duration = (edges_ & RELEASE_SEEN) ? (Time)(edgeMillis - releaseMillis_) : 0;
+            timing.interval = 0;
+            break;
+
+          case CallbackEvents::RELEASED_EVENT:
+            releaseMillis_ = edgeMillis;
+            edges_ |= RELEASE_SEEN;
+            timing.millis = edgeMillis;
+            timing.duration = (Time)(edgeMillis - pressMillis_);
+            timing.interval = 0;
+            break;
+
+          case CallbackEvents::HELD_EVENT:
+            timing.millis = pressMillis_;
+            timing.duration = elapsed<Clock>(pressMillis_);
+            timing.interval = 0;
+            break;
+
+          case CallbackEvents::IDLE_EVENT:
+            timing.millis = releaseMillis_;
+            timing.duration = elapsed<Clock>(releaseMillis_);
+            timing.interval = 0;
+            break;
+
+          default: // Click events.
+            timing.millis = releaseMillis_;
+            timing.duration = (Time)(releaseMillis_ - pressMillis_);
+            timing.interval = interval_;
+            break;
+        }
+
+        if(callbackFn) callbackFn(event, id, timing);
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      Time pressMillis_; ///< Timestamp of the last debounced press edge.
+      Time releaseMillis_; ///< Timestamp of the last debounced release edge.
+      Time interval_; ///< Clock ticks between the last two press edges.
+      uint8_t edges_; ///< The edges seen since the button began (PRESS_SEEN and RELEASE_SEEN).
+  };
+
+  /**
+   * Callback class queueing each event to call the function later, from
+   * dispatch(), rather than from handle(). A slow callback function then
+   * cannot delay handling the other buttons, so the time taken by handle() is
+   * bounded. Call dispatch() when there is time for the callback functions
+   * (e.g. at the end of loop()). Buttons with the same queue size share one
+   * queue, so events are dispatched in the order they occurred. If the queue
+   * is full, new events are dropped and counted by overflows().
+   *
+   * The buttons may be handled from an interrupt service routine (ISR), such
+   * as a timer interrupt, with dispatch() called from loop(). The queue is a
+   * ring buffer with one writer and one reader: handle() (through call())
+   * only writes the tail and dispatch() only writes the head, so neither
+   * needs interrupts disabled. Handle the buttons of a queue either all from
+   * the ISR or all from loop(), and do not handle buttons in the callback
+   * functions when handling them from the ISR.
+   *
+   * Each queued event uses 8 bytes of memory (on an ATmega328, or 9 with
+   * 16-bit ids), with no memory per button.
+   *
+   * @param SIZE The number of events the queue can hold (default 16, max
+   *             127).
+   */
+  template <uint8_t SIZE = 16>
+  class DeferredCallback {
+    static_assert(SIZE > 0 && SIZE <= 127, "DeferredCallback queue size must be 1-127");
+
+    public:
+      /// The callback function type: `void fn(Button::CALLBACK_EVENT event, ButtonId id)` (see Ids.h).
+      typedef void (*CallbackFn)(CallbackEvents::CALLBACK_EVENT, ButtonId);
+
+    public:
+      //
+      // Static Members...
+      //
+
+      /**
+       * Call the callback functions of queued events, oldest first. Events
+       * queued by the callback functions, or by an ISR while dispatching, are
+       * dispatched too if maxEvents allows.
+       *
+       * @param maxEvents The maximum number of events to dispatch (default
+       *                  the queue size).
+       *
+       * @return The number of events dispatched.
+       */
+      static uint8_t dispatch(uint8_t maxEvents = SIZE) {
+        uint8_t dispatched = 0;
+        uint8_t head = head_;
+
+        while(dispatched < maxEvents && head != tail_) {
+          barrier(); // Read the event after the tail showing it is queued.
+          Event e = queue_[slot(head)];
+          barrier(); // Free the slot only once the event is read.
+          head = next(head);
+          head_ = head;
+          ++dispatched;
+
+          eventTime_ = e.time;
+          e.callbackFn((CallbackEvents::CALLBACK_EVENT) e.event, e.id);
+        }
+        return dispatched;
+      }
+
+      /**
+       * Return the number of events waiting to be dispatched.
+       *
+       * @return The number of queued events.
+       */
+      static inline uint8_t pending() {
+        uint8_t head = head_;
+        uint8_t tail = tail_;
+        return tail >= head ? tail - head : tail + 2 * SIZE - head;
+      }
+
+      /**
+       * Return the number of events dropped because the queue was full.
+       * Interrupts are disabled while it is read.
+       *
+       * @return The number of dropped events (up to 65535).
+       */
+      static inline uint16_t overflows() {
+        noInterrupts();
+        uint16_t rc = overflows_;
+        interrupts();
+        return rc;
+      }
+
+      /**
+       * Reset the count of dropped events to zero. Interrupts are disabled
+       * while it is reset.
+       */
+      static inline void resetOverflows() {
+        noInterrupts();
+        overflows_ = 0;
+        interrupts();
+      }
+
+      /**
+       * Return when the event being dispatched occurred. Use it in a callback
+       * function to tell how long ago the event occurred.
+       *
+       * @return The clock time of the button (millis() with the default clock)
+       *         of the debounced edge for pressed, released and click events
+       *         (the release completing the click), else when handle() queued
+       *         the event.
+       */
+      static inline unsigned long eventTime() {
+        return eventTime_;
+      }
+
+    protected:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Queue the event to call the callback function (if there is one) from
+       * dispatch(). Drops and counts the event if the queue is full.
+       *
+       * @param callbackFn The callback function to call (may be 0).
+       * @param event The event that occurred.
+       * @param id The identifier of the button.
+       * @param edgeMillis The timestamp of the last debounced edge.
+       */
+      template <typename Clock>
+      inline void call(CallbackFn callbackFn, CallbackEvents::CALLBACK_EVENT event, ButtonId id, typename Clock::Time edgeMillis) {
+        if(!callbackFn) return;
+        if(pending() == SIZE) {
+          if(overflows_ < 0xFFFF) overflows_ = overflows_ + 1;
+          return;
+        }
+
+        uint8_t tail = tail_;
+        Event &e = queue_[slot(tail)];
+        e.callbackFn = callbackFn;
+        e.time = event == CallbackEvents::BEGIN_EVENT || event == CallbackEvents::HELD_EVENT || event == CallbackEvents::IDLE_EVENT ? Clock::now() : edgeMillis;
+        e.event = event;
+        e.id = id;
+        barrier(); // Queue the event only once it is written.
+        tail_ = next(tail);
+      }
+
+    protected:
+      /**
+       * Stop the compiler moving reads and writes of the queued events past
+       * reads and writes of the head and tail.
+       */
+      static inline void barrier() {
+        __asm__ __volatile__("" ::: "memory");
+      }
+
+      /**
+       * Return the position after a position of the queue. Positions count
+       * to twice the queue size, so a full queue can be told from an empty
+       * one.
+       *
+       * @param pos The position (0 to 2 * SIZE - 1).
+       *
+       * @return The next position.
+       */
+      static inline uint8_t next(uint8_t pos) {
+        return ++pos == 2 * SIZE ? 0 : pos;
+      }
+
+      /**
+       * Return the slot of the queue holding the event at a position.
+       *
+       * @param pos The position (0 to 2 * SIZE - 1).
+       *
+       * @return The index of the slot in queue_.
+       */
+      static inline uint8_t slot(uint8_t pos) {
+        return pos < SIZE ? pos : pos - SIZE;
+      }
+
+    protected:
+      //
+      // Data...
+      //
+
+      /**
+       * A queued event.
+       */
+      struct Event {
+        CallbackFn callbackFn; ///< The callback function to call.
+        unsigned long time; ///< When the event occurred (see eventTime()).
+        uint8_t event; ///< The event that occurred.
+        ButtonId id; ///< The identifier of the button.
+      };
+
+      static Event queue_[SIZE]; ///< The queued events (a ring buffer).
+      static volatile uint8_t head_; ///< Position of the oldest queued event, written only by dispatch().
+      static volatile uint8_t tail_; ///< Position after the newest queued event, written only by call().
+      static volatile uint16_t overflows_; ///< Events dropped because the queue was full.
+      static unsigned long eventTime_; ///< When the event being dispatched occurred.
+  };
+
+  //
+  // Static Members...
+  //
+  template <uint8_t SIZE> typename DeferredCallback<SIZE>::Event DeferredCallback<SIZE>::queue_[SIZE];
+  template <uint8_t SIZE> volatile uint8_t DeferredCallback<SIZE>::head_ = 0;
+  template <uint8_t SIZE> volatile uint8_t DeferredCallback<SIZE>::tail_ = 0;
+  template <uint8_t SIZE> volatile uint16_t DeferredCallback<SIZE>::overflows_ = 0;
+  template <uint8_t SIZE> unsigned long DeferredCallback<SIZE>::eventTime_ = 0;
+}
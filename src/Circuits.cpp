@@ -0,0 +1,8 @@
+/**
+ * @file Circuits.cpp Implementation of the MixedResistorCircuit class.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include "Circuits.h"
+
+uint8_t able::MixedResistorCircuit::pullups_[(able::MixedResistorCircuit::PINS + 7) / 8];
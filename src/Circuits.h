@@ -1,5 +1,6 @@
 /**
- * @file Circuits.h Definition of Pulldown and pull-up ressitor circuits.
+ * @file Circuits.h Definition of Pulldown and pull-up ressitor circuits, and
+ * the mixed resistor circuit for lists of both.
  *
  * @copyright Copyright (c) 2022 John Scott.
  */
@@ -40,6 +41,33 @@ namespace able {
         BUTTON_RELEASED = LOW
       };
 
+    public:
+      //
+      // Static Members...
+      //
+
+      /**
+       * Return the pin mode of a pin.
+       *
+       * @param pin The pin.
+       *
+       * @return Always PIN_MODE.
+       */
+      static inline uint8_t inputMode(uint8_t /* pin */) {
+        return PIN_MODE;
+      }
+
+      /**
+       * Return the polarity XORed with readings of a pin.
+       *
+       * @param pin The pin.
+       *
+       * @return Always LOW, as readings are used as they are.
+       */
+      static inline uint8_t polarity(uint8_t /* pin */) {
+        return LOW;
+      }
+
     private:
       //
       // Creators, copying and assignment (not supported)...
@@ -68,6 +96,33 @@ namespace able {
         BUTTON_RELEASED = HIGH
       };
 
+    public:
+      //
+      // Static Members...
+      //
+
+      /**
+       * Return the pin mode of a pin.
+       *
+       * @param pin The pin.
+       *
+       * @return Always PIN_MODE.
+       */
+      static inline uint8_t inputMode(uint8_t /* pin */) {
+        return PIN_MODE;
+      }
+
+      /**
+       * Return the polarity XORed with readings of a pin.
+       *
+       * @param pin The pin.
+       *
+       * @return Always LOW, as readings are used as they are.
+       */
+      static inline uint8_t polarity(uint8_t /* pin */) {
+        return LOW;
+      }
+
     private:
       //
       // Creators, copying and assignment (not supported)...
@@ -76,4 +131,97 @@ namespace able {
       PullupResistorCircuit(const PullupResistorCircuit &) = delete; ///< Copying resistor objects is not supported.
       PullupResistorCircuit &operator=(const PullupResistorCircuit &) = delete; ///< Assignment is not supported.
   };
+
+  /**
+   * Declaration of a mixed resistor circuit, where each pin uses either a
+   * pulldown or a pull-up resistor circuit. Use it to keep buttons of both
+   * circuits in one ButtonList. Pins use pulldown resistor circuits unless
+   * set with setPullup(), which must be called before the button begins.
+   *
+   * The circuit of each pin is one bit of a polarity mask, and readings are
+   * XORed with it, so buttons on either circuit read HIGH when pressed. The
+   * mask uses 1 bit per Arduino pin (NUM_DIGITAL_PINS).
+   */
+  class MixedResistorCircuit: private Circuit {
+    public:
+      //
+      // Constants...
+      //
+      enum {
+#if defined(NUM_DIGITAL_PINS)
+        PINS = NUM_DIGITAL_PINS, ///< Pins in the polarity mask.
+#else
+        PINS = 64, ///< Pins in the polarity mask.
+#endif
+        BUTTON_PRESSED = HIGH, ///< Reading of any pressed button, after the XOR.
+        BUTTON_RELEASED = LOW ///< Reading of any released button, after the XOR.
+      };
+
+    public:
+      //
+      // Static Members...
+      //
+
+      /**
+       * Set the resistor circuit of a pin. Pins beyond the mask are always
+       * pulldown.
+       *
+       * @param pin The pin.
+       * @param pullup True for a pull-up resistor circuit (the default),
+       *               false for a pulldown.
+       */
+      static inline void setPullup(uint8_t pin, bool pullup = true) {
+        if(pin >= PINS) return;
+        if(pullup) pullups_[pin >> 3] |= (uint8_t)(1 << (pin & 7));
+        else pullups_[pin >> 3] &= (uint8_t) ~(1 << (pin & 7));
+      }
+
+      /**
+       * Determine if a pin uses a pull-up resistor circuit.
+       *
+       * @param pin The pin.
+       *
+       * @return True if pull-up, false if pulldown.
+       */
+      static inline bool isPullup(uint8_t pin) {
+        return pin < PINS && (pullups_[pin >> 3] >> (pin & 7)) & 1;
+      }
+
+      /**
+       * Return the pin mode of a pin.
+       *
+       * @param pin The pin.
+       *
+       * @return INPUT_PULLUP for a pull-up resistor circuit, else INPUT.
+       */
+      static inline uint8_t inputMode(uint8_t pin) {
+        return isPullup(pin) ? INPUT_PULLUP : INPUT;
+      }
+
+      /**
+       * Return the polarity XORed with readings of a pin.
+       *
+       * @param pin The pin.
+       *
+       * @return HIGH for a pull-up resistor circuit (inverting its readings),
+       *         else LOW.
+       */
+      static inline uint8_t polarity(uint8_t pin) {
+        return isPullup(pin) ? HIGH : LOW;
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      static uint8_t pullups_[(PINS + 7) / 8]; ///< Polarity mask, set for pull-up pins.
+
+    private:
+      //
+      // Creators, copying and assignment (not supported)...
+      //
+      MixedResistorCircuit() = delete; ///< Creating resistor circuits is not supported.
+      MixedResistorCircuit(const MixedResistorCircuit &) = delete; ///< Copying resistor circuits is not supported.
+      MixedResistorCircuit &operator=(const MixedResistorCircuit &) = delete; ///< Assigning resistor circuits is not supported.
+  };
 }
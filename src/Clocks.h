@@ -0,0 +1,260 @@
+/**
+ * @file Clocks.h Definition of the clock classes (MillisClock, MicrosClock,
+ * Millis16Clock and UntimedClock). Debounced pins use a clock class to time
+ * debounce, held, idle and click states. All times of a pin (e.g.
+ * setDebounceTime()) are in ticks of its clock, and the timestamps kept by
+ * each button are the width of the clock's Time type, so a shorter clock uses
+ * less memory.
+ *
+ * | Clock         | Tick | Time          | Wraps   | Memory | Debounce  |
+ * | :------------ | :--: | :------------ | :------ | :----: | :-------- |
+ * | MillisClock   | 1ms  | unsigned long | 49 days | 4      | 1-255ms   |
+ * | MicrosClock   | 1us  | unsigned long | 71 mins | 4      | 1us-65ms  |
+ * | Millis16Clock | 1ms  | uint16_t      | 65s     | 2      | 1-255ms   |
+ * | UntimedClock  | none | uint8_t       | never   | 1      | none      |
+ *
+ * The MicrosClock ticks in microseconds, but micros() only counts in steps
+ * of 4us on 16MHz AVR boards, so times there are good to 4us.
+ *
+ * Memory is per timestamp (one per DebouncedPin or ClickerPin, two per
+ * DoubleClickerPin). Times are compared as the difference of two timestamps
+ * in the Time type, so are safe when the clock wraps around. A clock with
+ * timestamps shorter than 32 bits (e.g. the Millis16Clock) would wrap within
+ * a long hold or idle spell, so pins timed by it keep the time since they
+ * changed no longer than 15/16 of the wrap period (see limitAge()): a button
+ * stays held or idle however long it is left, as long as it is handled at
+ * least every 1/16 of the wrap period (4s for the Millis16Clock). Held and
+ * idle times must be within the limit (61.4s for the Millis16Clock).
+ *
+ * TICKS_PER_SECOND converts ticks to rates (e.g. the velocity of an
+ * Encoder). Any class with the same members may be used as a clock (e.g. reading a
+ * hardware timer counter). Times and timestamps must be unsigned.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#include <Arduino.h>
+
+namespace able {
+  /**
+   * Clock timing pins in milliseconds using millis(). The default clock.
+   */
+  class MillisClock {
+    public:
+      //
+      // Types...
+      //
+      typedef unsigned long Time; ///< Type of timestamps.
+      typedef uint8_t DebounceTime; ///< Type of debounce times.
+      typedef uint16_t HeldTime; ///< Type of held and click times.
+      typedef uint32_t IdleTime; ///< Type of idle times.
+
+      //
+      // Constants...
+      //
+      static const DebounceTime DEBOUNCE_TIME = 50; ///< Default debounce time (50ms).
+      static const HeldTime HELD_TIME = 1000; ///< Default held time (1s).
+      static const IdleTime IDLE_TIME = 60000; ///< Default idle time (60s).
+      static const HeldTime CLICK_TIME = 500; ///< Default double-click time (500ms).
+      static const unsigned long TICKS_PER_SECOND = 1000; ///< Clock ticks per second.
+
+      /**
+       * Return the time now.
+       *
+       * @return The milliseconds since the Arduino started.
+       */
+      static inline Time now() {
+        return millis();
+      }
+  };
+
+  /**
+   * Clock timing pins in microseconds using micros(), for sub-millisecond
+   * debounce times (e.g. fast-bouncing reed switches). micros() counts in
+   * steps of 4us on 16MHz Arduinos and wraps every 71 minutes.
+   */
+  class MicrosClock {
+    public:
+      //
+      // Types...
+      //
+      typedef unsigned long Time; ///< Type of timestamps.
+      typedef uint16_t DebounceTime; ///< Type of debounce times.
+      typedef uint32_t HeldTime; ///< Type of held and click times.
+      typedef uint32_t IdleTime; ///< Type of idle times.
+
+      //
+      // Constants...
+      //
+      static const DebounceTime DEBOUNCE_TIME = 50000; ///< Default debounce time (50ms).
+      static const HeldTime HELD_TIME = 1000000; ///< Default held time (1s).
+      static const IdleTime IDLE_TIME = 60000000; ///< Default idle time (60s).
+      static const HeldTime CLICK_TIME = 500000; ///< Default double-click time (500ms).
+      static const unsigned long TICKS_PER_SECOND = 1000000; ///< Clock ticks per second.
+
+      /**
+       * Return the time now.
+       *
+       * @return The microseconds since the Arduino started.
+       */
+      static inline Time now() {
+        return micros();
+      }
+  };
+
+  /**
+   * Clock timing pins in milliseconds with 16-bit timestamps, saving 2 bytes
+   * per timestamp. The clock wraps every 65.5 seconds, so pins limit their
+   * age to 61.4 seconds (see limitAge()) and idle times must be no longer
+   * than that (the default 60s is).
+   */
+  class Millis16Clock {
+    public:
+      //
+      // Types...
+      //
+      typedef uint16_t Time; ///< Type of timestamps.
+      typedef uint8_t DebounceTime; ///< Type of debounce times.
+      typedef uint16_t HeldTime; ///< Type of held and click times.
+      typedef uint16_t IdleTime; ///< Type of idle times.
+
+      //
+      // Constants...
+      //
+      static const DebounceTime DEBOUNCE_TIME = 50; ///< Default debounce time (50ms).
+      static const HeldTime HELD_TIME = 1000; ///< Default held time (1s).
+      static const IdleTime IDLE_TIME = 60000; ///< Default idle time (60s).
+      static const HeldTime CLICK_TIME = 500; ///< Default double-click time (500ms).
+      static const unsigned long TICKS_PER_SECOND = 1000; ///< Clock ticks per second.
+
+      /**
+       * Return the time now.
+       *
+       * @return The milliseconds since the Arduino started, modulo 65536.
+       */
+      static inline Time now() {
+        return (Time) millis();
+      }
+  };
+
+  /**
+   * Clock that never ticks, for pins that only need presses and releases.
+   * Its time is always 0, so pins timed by it never read a clock, keep a
+   * 1-byte timestamp, and are never held, idle, single-clicked or
+   * double-clicked (ClickerPin clicks still work). Use it with a debouncer
+   * counting readings (IntegratorDebouncer, PatternDebouncer or
+   * MajorityDebouncer); the TimerDebouncer cannot time a debounce with it.
+   */
+  class UntimedClock {
+    public:
+      //
+      // Types...
+      //
+      typedef uint8_t Time; ///< Type of timestamps.
+      typedef uint8_t DebounceTime; ///< Type of debounce times.
+      typedef uint8_t HeldTime; ///< Type of held and click times.
+      typedef uint8_t IdleTime; ///< Type of idle times.
+
+      //
+      // Constants...
+      //
+      static const DebounceTime DEBOUNCE_TIME = 0; ///< Default debounce time (none).
+      static const HeldTime HELD_TIME = 1; ///< Default held time (never reached).
+      static const IdleTime IDLE_TIME = 1; ///< Default idle time (never reached).
+      static const HeldTime CLICK_TIME = 0; ///< Default double-click time (no double-clicks).
+      static const unsigned long TICKS_PER_SECOND = 1; ///< Clock ticks per second.
+
+      /**
+       * Return the time now.
+       *
+       * @return Always 0.
+       */
+      static inline Time now() {
+        return 0;
+      }
+  };
+
+  /**
+   * Return the ticks of a clock since a timestamp. The difference is taken in
+   * the Time type of the clock, so is correct when the clock wraps around.
+   *
+   * @param Clock The clock class (e.g. MillisClock).
+   * @param since The timestamp.
+   *
+   * @return The ticks since the timestamp.
+   */
+  template <typename Clock>
+  inline typename Clock::Time elapsed(typename Clock::Time since) {
+    return Clock::now() - since;
+  }
+
+  /**
+   * Keep the age of a timestamp (the ticks since it) within 15/16 of the wrap
+   * period of a clock whose timestamps are shorter than 32 bits, moving the
+   * timestamp on if it is older. A pin whose age is kept within the limit at
+   * least every 1/16 of the wrap period stays held or idle rather than
+   * appearing to change again each time the clock wraps. Timestamps of
+   * 32-bit clocks are left unchanged.
+   *
+   * @param Clock The clock class (e.g. Millis16Clock).
+   * @param since The timestamp (updated).
+   * @param now The time now.
+   *
+   * @return True if the timestamp was moved on, else false.
+   */
+  template <typename Clock>
+  inline bool limitAge(typename Clock::Time &since, typename Clock::Time now) {
+    typedef typename Clock::Time Time;
+    const Time LIMIT = (Time) ~(Time) 0 - (Time)((Time) ~(Time) 0 >> 4);
+    if(sizeof(Time) >= sizeof(uint32_t) || (Time)(now - since) <= LIMIT) {
+      return false;
+    }
+    since = now - LIMIT;
+    return true;
+  }
+
+  /**
+   * Keep the age of a timestamp of the UntimedClock, which never ticks, so
+   * its timestamps never age.
+   *
+   * @return Always false.
+   */
+  template <>
+  inline bool limitAge<UntimedClock>(UntimedClock::Time & /* since */, UntimedClock::Time /* now */) {
+    return false;
+  }
+
+  /**
+   * Keep the age of a timestamp within the limit of its clock (see above),
+   * reading the clock only if its timestamps are shorter than 32 bits.
+   *
+   * @param Clock The clock class (e.g. Millis16Clock).
+   * @param since The timestamp (updated).
+   *
+   * @return True if the timestamp was moved on, else false.
+   */
+  template <typename Clock>
+  inline bool limitAge(typename Clock::Time &since) {
+    return sizeof(typename Clock::Time) < sizeof(uint32_t) && limitAge<Clock>(since, Clock::now());
+  }
+
+  /**
+   * Print a number of ticks of a clock with its units: "ms" for a clock
+   * ticking in milliseconds, "us" in microseconds, else " ticks".
+   *
+   * @param Clock The clock class (e.g. MillisClock).
+   * @param out The print-stream to output to.
+   * @param ticks The number of ticks.
+   */
+  template <typename Clock>
+  void printTicks(Print &out, unsigned long ticks) {
+    out.print(ticks);
+    if(Clock::TICKS_PER_SECOND == 1000) {
+      out.print(F("ms"));
+    } else if(Clock::TICKS_PER_SECOND == 1000000) {
+      out.print(F("us"));
+    } else {
+      out.print(F(" ticks"));
+    }
+  }
+}
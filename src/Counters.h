@@ -0,0 +1,592 @@
+/**
+ * @file Counters.h Definition of the pin counter classes (NoCounters,
+ * PinCounters and BounceHistogram). Debounced pins use a counter class to
+ * optionally count what happens to a button (bounces, presses, holds and
+ * clicks) for diagnostics, or to measure contact bounce and tune the debounce
+ * time of each button.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#include <Arduino.h>
+#include "Clocks.h"
+
+namespace able {
+  /**
+   * Counts collected by PinCounters for a button (or totalled across a
+   * ButtonList).
+   */
+  struct PinCounts {
+    unsigned long bounces; ///< Raw pin changes filtered out as contact bounce.
+    unsigned long presses; ///< Debounced button presses.
+    unsigned long holds; ///< Presses lasting at least the held time.
+    unsigned long clicks; ///< Clicks (press then release). Needs a ClickerPin.
+    unsigned long doubleClicks; ///< Double-clicks. Needs a DoubleClickerPin.
+    uint8_t maxBurst; ///< Most raw pin changes seen before the reading settled.
+  };
+
+  /**
+   * Print counts on a single line (e.g. to Serial) in the form
+   * `bounces=12 presses=3 holds=1 clicks=3 doubleClicks=0 maxBurst=5`.
+   *
+   * @param out The print-stream to output to.
+   * @param counts The counts to print.
+   */
+  inline void printCounts(Print &out, const PinCounts &counts) {
+    out.print(F("bounces="));
+    out.print(counts.bounces);
+    out.print(F(" presses="));
+    out.print(counts.presses);
+    out.print(F(" holds="));
+    out.print(counts.holds);
+    out.print(F(" clicks="));
+    out.print(counts.clicks);
+    out.print(F(" doubleClicks="));
+    out.print(counts.doubleClicks);
+    out.print(F(" maxBurst="));
+    out.println(counts.maxBurst);
+  }
+
+  /**
+   * Counter class counting nothing. This is the default for debounced pins.
+   * All the counting functions are empty, so they compile to nothing and use
+   * no memory.
+   */
+  class NoCounters {
+    protected:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create the (empty) counters.
+       *
+       * @param initState The initial (un-pushed) state of the button (unused).
+       */
+      inline NoCounters(uint8_t /* initState */) {}
+
+    protected:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Count a raw pin change (not counted).
+       *
+       * @param pin The pin that changed.
+       * @param reading The new raw reading of the pin.
+       */
+      template <typename Clock>
+      inline void countChange(uint8_t /* pin */, uint8_t /* reading */) {}
+
+      /**
+       * Count a settled reading (not counted).
+       *
+       * @param prevState The debounced state before the reading settled.
+       * @param currState The settled reading.
+       * @param changeMillis The timestamp of the last change.
+       * @param heldTime The held time in clock ticks.
+       */
+      template <typename Clock>
+      inline void countSettled(uint8_t /* prevState */, uint8_t /* currState */, typename Clock::Time /* changeMillis */, typename Clock::HeldTime /* heldTime */) {}
+
+      /**
+       * Count a click (not counted).
+       *
+       * @param currState The new debounced state of the pin.
+       */
+      inline void countClick(uint8_t /* currState */) {}
+
+      /// Count a double-click (not counted).
+      inline void countDoubleClick() {}
+
+    protected:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Return the debounce time to use for the pin.
+       *
+       * @param debounceTime The debounce time for all pins.
+       *
+       * @return Always the debounce time for all pins.
+       */
+      template <typename DebounceTime>
+      inline DebounceTime pinDebounceTime(DebounceTime debounceTime) const {
+        return debounceTime;
+      }
+
+      /**
+       * Determine if the next settled reading would be counted.
+       *
+       * @param currState The debounced state of the pin (unused).
+       *
+       * @return Always false, as nothing is counted.
+       */
+      inline bool countsSettled(uint8_t /* currState */) const {
+        return false;
+      }
+  };
+
+  /**
+   * Counter class counting bounces, presses, holds and clicks of a button.
+   * Uses 24 bytes of memory per button. Access the counts with the counts()
+   * method of the button, or total them with the counts() method of a
+   * ButtonList.
+   */
+  class PinCounters {
+    public:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Reset all counts to zero.
+       */
+      inline void resetCounts() {
+        counts_.bounces = counts_.presses = counts_.holds = 0;
+        counts_.clicks = counts_.doubleClicks = 0;
+        counts_.maxBurst = 0;
+      }
+
+    public:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Return the counts for the button.
+       *
+       * @return The counts collected since created or resetCounts() called.
+       */
+      inline const PinCounts &counts() const {
+        return counts_;
+      }
+
+    protected:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create the counters, all zero.
+       *
+       * @param initState The initial (un-pushed) state of the button.
+       */
+      inline PinCounters(uint8_t initState)
+      :releasedState_(initState), burst_(0), held_(false) {
+        resetCounts();
+      }
+
+    protected:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Count a raw pin change. Changes are counted in a burst until the
+       * reading settles.
+       *
+       * @param pin The pin that changed (unused).
+       * @param reading The new raw reading of the pin (unused).
+       */
+      template <typename Clock>
+      inline void countChange(uint8_t /* pin */, uint8_t /* reading */) {
+        if(burst_ < 255) ++burst_;
+      }
+
+      /**
+       * Count a settled reading. Called each time the reading is settled. The
+       * first time after a burst of changes, all but one change (if the
+       * debounced state changed) were bounces.
+       *
+       * @param prevState The debounced state before the reading settled.
+       * @param currState The settled reading.
+       * @param changeMillis The timestamp of the last change.
+       * @param heldTime The held time in clock ticks.
+       */
+      template <typename Clock>
+      inline void countSettled(uint8_t prevState, uint8_t currState, typename Clock::Time changeMillis, typename Clock::HeldTime heldTime) {
+        if(burst_ > counts_.maxBurst) counts_.maxBurst = burst_;
+        if(prevState != currState) {
+          if(burst_) --burst_; // Change in state was not a bounce.
+          if(currState != releasedState_) ++counts_.presses;
+          held_ = false;
+        }
+        if(burst_) {
+          counts_.bounces += burst_;
+          burst_ = 0;
+        }
+
+        if(!held_ && currState != releasedState_ && elapsed<Clock>(changeMillis) >= heldTime) {
+          ++counts_.holds;
+          held_ = true;
+        }
+      }
+
+      /**
+       * Count a click when the debounced state changes to released.
+       *
+       * @param currState The new debounced state of the pin.
+       */
+      inline void countClick(uint8_t currState) {
+        if(currState == releasedState_) ++counts_.clicks;
+      }
+
+      /// Count a double-click.
+      inline void countDoubleClick() {
+        ++counts_.doubleClicks;
+      }
+
+    protected:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Return the debounce time to use for the pin.
+       *
+       * @param debounceTime The debounce time for all pins.
+       *
+       * @return Always the debounce time for all pins.
+       */
+      template <typename DebounceTime>
+      inline DebounceTime pinDebounceTime(DebounceTime debounceTime) const {
+        return debounceTime;
+      }
+
+      /**
+       * Determine if the next settled reading would be counted: it ends a
+       * burst of changes, or the pin is pressed and not yet counted as held.
+       *
+       * @param currState The debounced state of the pin.
+       *
+       * @return True if the next settled reading would be counted, else false.
+       */
+      inline bool countsSettled(uint8_t currState) const {
+        return burst_ || (!held_ && currState != releasedState_);
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      PinCounts counts_; ///< The counts collected.
+      uint8_t releasedState_; ///< The released state of the button, to count presses.
+      uint8_t burst_; ///< Raw pin changes since the reading last settled.
+      bool held_; ///< Counted the current press as a hold.
+  };
+
+  /**
+   * Counter class recording a histogram of how long contact bounce lasts for a
+   * button and tuning the debounce time of the button from it. A bounce burst
+   * lasts from the first raw pin change until the last one before the reading
+   * settles. A clean switch (one change) is a burst of 0ms.
+   *
+   * The debounce time of a button is the debounce time for all pins until
+   * autoTune() sets a debounce time just for that button, just above the
+   * chosen percentile of the bursts seen. Measure bounce with a generous
+   * debounce time (e.g. the default 50ms) before tuning, as bounces longer
+   * than the debounce time look like separate presses. Times are in ticks of
+   * the clock of the pin (milliseconds with the default MillisClock).
+   *
+   * Uses 2 bytes of memory per bin plus 12 bytes per button.
+   *
+   * @param BINS The number of histogram bins (default 16). The last bin
+   *             counts bursts too long for the other bins.
+   * @param BIN_MILLIS The milliseconds covered by each bin (default 2ms).
+   *                   Tuned debounce times are at most (BINS - 1) *
+   *                   BIN_MILLIS, which must fit a debounce time (255).
+   */
+  template <uint8_t BINS = 16, uint8_t BIN_MILLIS = 2>
+  class BounceHistogram {
+    static_assert((BINS - 1) * BIN_MILLIS <= 255, "BounceHistogram bins too wide for a debounce time (max 255)");
+
+    public:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Clear the histogram.
+       */
+      void resetHistogram() {
+        for(uint8_t i = 0; i < BINS; ++i) {
+          bins_[i] = 0;
+        }
+        samples_ = 0;
+      }
+
+      /**
+       * Set the debounce time of this button just above the percentile of the
+       * bursts in the histogram. For example, autoTune(99) sets the debounce
+       * time so 99% of the bursts seen would have been debounced.
+       *
+       * @param percentile The percentage (1-100) of bursts to debounce.
+       *
+       * @return True if tuned, false if there are no bursts or the percentile
+       *         is in the last bin (too long to tell), leaving the debounce
+       *         time unchanged.
+       */
+      bool autoTune(uint8_t percentile) {
+        uint8_t ms = percentileMillis(percentile);
+        if(ms) {
+          tunedTime_ = ms;
+        }
+        return ms != 0;
+      }
+
+      /**
+       * Automatically call autoTune() once the histogram has enough bursts.
+       * Useful to calibrate buttons when first used.
+       *
+       * @param percentile The percentage (1-100) of bursts to debounce, or 0
+       *                   to cancel automatic tuning.
+       * @param samples The number of bursts to see before tuning.
+       */
+      inline void setAutoTune(uint8_t percentile, uint16_t samples) {
+        autoTunePercentile_ = percentile;
+        autoTuneSamples_ = samples;
+      }
+
+      /**
+       * Clear the debounce time of this button, so it uses the debounce time
+       * for all pins again.
+       */
+      inline void resetTunedDebounceTime() {
+        tunedTime_ = 0;
+      }
+
+    public:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Return the number of histogram bins.
+       *
+       * @return The number of bins.
+       */
+      static inline uint8_t bins() {
+        return BINS;
+      }
+
+      /**
+       * Return the milliseconds covered by each histogram bin.
+       *
+       * @return The width of each bin in milliseconds.
+       */
+      static inline uint8_t binMillis() {
+        return BIN_MILLIS;
+      }
+
+      /**
+       * Return the count of bursts in a bin. Bin i counts bursts lasting from
+       * i * binMillis() up to (i + 1) * binMillis() milliseconds. The last bin
+       * also counts all longer bursts.
+       *
+       * @param i The bin (0 to bins() - 1).
+       *
+       * @return The number of bursts in the bin.
+       */
+      inline uint16_t bin(uint8_t i) const {
+        return bins_[i];
+      }
+
+      /**
+       * Return the number of bursts in the histogram.
+       *
+       * @return The number of bursts.
+       */
+      inline uint16_t samples() const {
+        return samples_;
+      }
+
+      /**
+       * Return the milliseconds just above the percentile of the bursts in the
+       * histogram (the top of the bin containing the percentile).
+       *
+       * @param percentile The percentage (1-100) of bursts.
+       *
+       * @return The milliseconds, or 0 if there are no bursts or the
+       *         percentile is in the last bin.
+       */
+      uint8_t percentileMillis(uint8_t percentile) const {
+        unsigned long target = ((unsigned long)samples_ * percentile + 99) / 100;
+        unsigned long total = 0;
+
+        if(samples_ == 0) {
+          return 0;
+        }
+
+        for(uint8_t i = 0; i < BINS - 1; ++i) {
+          total += bins_[i];
+          if(total >= target) {
+            return (i + 1) * BIN_MILLIS;
+          }
+        }
+        return 0;
+      }
+
+      /**
+       * Return the debounce time set for this button by autoTune().
+       *
+       * @return The milliseconds, or 0 if using the debounce time for all pins.
+       */
+      inline uint8_t tunedDebounceTime() const {
+        return tunedTime_;
+      }
+
+      /**
+       * Print the histogram on a single line (e.g. to Serial) in the form
+       * `2ms bins: 5 3 0 1 ...`, with the bin width in the units of the clock
+       * (e.g. `2us bins:` for the MicrosClock).
+       *
+       * @param Clock The clock of the pin. Defaults to MillisClock.
+       * @param out The print-stream to output to (default Serial).
+       */
+      template <typename Clock = MillisClock>
+      void printHistogram(Print &out = Serial) const {
+        printTicks<Clock>(out, BIN_MILLIS);
+        out.print(F(" bins:"));
+        for(uint8_t i = 0; i < BINS; ++i) {
+          out.print(' ');
+          out.print(bins_[i]);
+        }
+        out.println();
+      }
+
+    protected:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create an empty histogram using the debounce time for all pins.
+       *
+       * @param initState The initial (un-pushed) state of the button (unused).
+       */
+      inline BounceHistogram(uint8_t /* initState */)
+      :burstMillis_(0), samples_(0), autoTuneSamples_(0), tunedTime_(0),
+       autoTunePercentile_(0), burstTicks_(0), inBurst_(false) {
+        resetHistogram();
+      }
+
+    protected:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Remember when a burst of raw pin changes started, and how long after
+       * that the last change of the burst was.
+       *
+       * @param pin The pin that changed (unused).
+       * @param reading The new raw reading of the pin (unused).
+       */
+      template <typename Clock>
+      inline void countChange(uint8_t /* pin */, uint8_t /* reading */) {
+        if(!inBurst_) {
+          burstMillis_ = Clock::now();
+          burstTicks_ = 0;
+          inBurst_ = true;
+        } else {
+          typename Clock::Time ticks = elapsed<Clock>(burstMillis_);
+          burstTicks_ = ticks < 255 ? ticks : 255;
+        }
+      }
+
+      /**
+       * Add the burst to the histogram the first time the reading settles
+       * after it. Halves all bins if one is full, keeping the shape of the
+       * histogram.
+       *
+       * The burst lasts until its last raw change, recorded by countChange():
+       * the timestamp of the last change of the pin is only that of the last
+       * raw change for the TimerDebouncer (other debouncers time changes of
+       * the debounced state).
+       *
+       * @param prevState The debounced state before the reading settled (unused).
+       * @param currState The settled reading (unused).
+       * @param changeMillis The timestamp of the last change (unused).
+       * @param heldTime The held time in clock ticks (unused).
+       */
+      template <typename Clock>
+      void countSettled(uint8_t /* prevState */, uint8_t /* currState */, typename Clock::Time /* changeMillis */, typename Clock::HeldTime /* heldTime */) {
+        if(inBurst_) {
+          uint8_t i = burstTicks_ / BIN_MILLIS;
+          if(i >= BINS) i = BINS - 1;
+
+          if(bins_[i] == 0xFFFF) {
+            samples_ = 0;
+            for(uint8_t j = 0; j < BINS; ++j) {
+              bins_[j] /= 2;
+              samples_ += bins_[j];
+            }
+          }
+          ++bins_[i];
+          if(samples_ < 0xFFFF) ++samples_;
+          inBurst_ = false;
+
+          if(autoTunePercentile_ && samples_ >= autoTuneSamples_) {
+            autoTune(autoTunePercentile_);
+            autoTunePercentile_ = 0;
+          }
+        }
+      }
+
+      /**
+       * Count a click (not counted).
+       *
+       * @param currState The new debounced state of the pin.
+       */
+      inline void countClick(uint8_t /* currState */) {}
+
+      /// Count a double-click (not counted).
+      inline void countDoubleClick() {}
+
+    protected:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Return the debounce time to use for the pin.
+       *
+       * @param debounceTime The debounce time for all pins.
+       *
+       * @return The debounce time set by autoTune(), else the debounce time
+       *         for all pins.
+       */
+      template <typename DebounceTime>
+      inline DebounceTime pinDebounceTime(DebounceTime debounceTime) const {
+        return tunedTime_ ? tunedTime_ : debounceTime;
+      }
+
+      /**
+       * Determine if the next settled reading would be counted (it ends a
+       * burst of changes).
+       *
+       * @param currState The debounced state of the pin (unused).
+       *
+       * @return True if the next settled reading would be counted, else false.
+       */
+      inline bool countsSettled(uint8_t /* currState */) const {
+        return inBurst_;
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      unsigned long burstMillis_; ///< Timestamp of the first raw pin change in the burst.
+      uint16_t bins_[BINS]; ///< Count of bursts in each bin.
+      uint16_t samples_; ///< Total bursts in the bins.
+      uint16_t autoTuneSamples_; ///< Bursts to see before automatically tuning.
+      uint8_t tunedTime_; ///< Debounce time of this button (0 to use the time for all pins).
+      uint8_t autoTunePercentile_; ///< Percentile to automatically tune to (0 when not tuning).
+      uint8_t burstTicks_; ///< Clock ticks from the first to the last raw pin change in the burst (at most 255).
+      bool inBurst_; ///< Raw pin changes seen since the reading last settled.
+  };
+}
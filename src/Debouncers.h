@@ -0,0 +1,567 @@
+/**
+ * @file Debouncers.h Definition of the debouncer classes (TimerDebouncer,
+ * EagerDebouncer, IntegratorDebouncer, PatternDebouncer and MajorityDebouncer).
+ * Debounced pins use a debouncer class to turn raw pin readings into a steady
+ * reading.
+ *
+ * The TimerDebouncer (the default) waits for the reading to be steady for the
+ * debounce time. It works however often handle() is called. The
+ * EagerDebouncer reports the first edge after a steady reading at once, then
+ * ignores the bounce following it. The other
+ * debouncers count samples instead of milliseconds, so need no clock to
+ * debounce and use less memory and time per reading. They rely on handle()
+ * being called at a steady rate (e.g. every 1-5ms from loop() or a timer) so
+ * their samples cover the contact bounce of the button.
+ *
+ * Approximate costs per reading on an ATmega328 (16MHz), excluding the
+ * digitalRead() call, are:
+ *
+ * | Debouncer           | Memory | Cycles | Clock?       |
+ * | :------------------ | :----: | :----: | :----------- |
+ * | TimerDebouncer      | 5      | ~80    | Every read   |
+ * | EagerDebouncer      | 5      | ~90    | Every read   |
+ * | IntegratorDebouncer | 1      | ~15    | State change |
+ * | PatternDebouncer    | 1      | ~15    | State change |
+ * | MajorityDebouncer   | 1      | ~30    | State change |
+ *
+ * Debouncers other than the TimerDebouncer and EagerDebouncer only read the
+ * clock when the debounced state changes, to time held, idle and click
+ * states. The clock is the Clock class of the pin (see Clocks.h).
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#include <Arduino.h>
+#include "Clocks.h"
+
+namespace able {
+  /**
+   * Debouncer base class. All debouncers inherit from this base class, which
+   * defines the results of debouncing a reading. A reading may both change
+   * and settle (e.g. when a noisy reading tips a majority vote).
+   */
+  class Debouncer {
+    protected:
+      //
+      // Constants...
+      //
+      enum DEBOUNCE_RESULT {
+        DEBOUNCE_UNSETTLED = 0, ///< The reading has not settled.
+        DEBOUNCE_CHANGED = 1, ///< The raw reading changed.
+        DEBOUNCE_SETTLED = 2 ///< The reading has settled.
+      };
+  };
+
+  /**
+   * Debouncer waiting for a steady reading for the debounce time. The default
+   * debouncer, using the setDebounceTime() of the button. It records when the
+   * raw reading last changed, which times the held, idle and click states.
+   * Uses 5 bytes of memory per button.
+   */
+  class TimerDebouncer: protected Debouncer {
+    protected:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create the debouncer.
+       *
+       * @param initState The initial (un-pushed) state of the button.
+       */
+      inline TimerDebouncer(uint8_t initState)
+      :prevReading_(initState) {}
+
+    protected:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Debounce a reading. The reading settles once it has not changed for
+       * the debounce time.
+       *
+       * @param reading The raw reading of the pin.
+       * @param settled Set to the settled reading when settled.
+       * @param changeMillis When the raw reading last changed (updated).
+       * @param debounceTime The debounce time in clock ticks.
+       *
+       * @return DEBOUNCE_CHANGED, DEBOUNCE_SETTLED or DEBOUNCE_UNSETTLED.
+       */
+      template <typename Clock>
+      inline uint8_t debounce(uint8_t reading, uint8_t &settled, typename Clock::Time &changeMillis, typename Clock::DebounceTime debounceTime) {
+        uint8_t rc = DEBOUNCE_UNSETTLED;
+
+        // New reading, so start the debounce timer.
+        if(reading != prevReading_) {
+          changeMillis = Clock::now();
+          rc = DEBOUNCE_CHANGED;
+        } else if(elapsed<Clock>(changeMillis) >= debounceTime) {
+          // Use reading if we have the same reading for >= DELAY ms.
+          settled = reading;
+          rc = DEBOUNCE_SETTLED;
+        }
+
+        prevReading_ = reading;
+        return rc;
+      }
+
+      /**
+       * Record a change in the debounced state. Nothing to do as the time of
+       * the raw change is already recorded.
+       *
+       * @param changeMillis When the state changed (unchanged).
+       */
+      template <typename Clock>
+      inline void stateChanged(typename Clock::Time & /* changeMillis */) {}
+
+    protected:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Determine if the debouncer has settled on a state, so further readings
+       * of that state change nothing (the last reading was the state, so
+       * settling on it again is no change).
+       *
+       * @param state The debounced state of the pin.
+       *
+       * @return True if settled on the state, else false.
+       */
+      inline bool settledOn(uint8_t state) const {
+        return prevReading_ == state;
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      uint8_t prevReading_; ///< The previous pin reading, to monitor state transitions.
+  };
+
+  /**
+   * Debouncer reporting the leading edge of a press or release. When the raw
+   * reading changes after being steady for the debounce time, the change is
+   * reported at once. The bounce following the edge is then ignored until the
+   * reading is steady for the debounce time again. This removes the debounce
+   * delay from presses and/or releases. An isolated noise spike on a steady
+   * pin is reported as a (short) press or release, so only use it for edges
+   * of pins that are not noisy. Uses 5 bytes of memory per button.
+   *
+   * @param EAGER_PRESS Report presses on their leading edge (default true).
+   * @param EAGER_RELEASE Report releases on their leading edge (default true).
+   */
+  template <bool EAGER_PRESS = true, bool EAGER_RELEASE = true>
+  class EagerDebouncer: protected Debouncer {
+    protected:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create the debouncer, settled on the initial state.
+       *
+       * @param initState The initial (un-pushed) state of the button.
+       */
+      inline EagerDebouncer(uint8_t initState)
+      :flags_(initState ? (READING | STATE | RELEASED) : 0) {}
+
+    protected:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Debounce a reading. A change after a steady reading settles at once if
+       * eager in that direction. Otherwise the reading settles once it has not
+       * changed for the debounce time.
+       *
+       * @param reading The raw reading of the pin.
+       * @param settled Set to the settled reading when settled.
+       * @param changeMillis When the raw reading last changed (updated).
+       * @param debounceTime The debounce time in clock ticks.
+       *
+       * @return DEBOUNCE_CHANGED and/or DEBOUNCE_SETTLED, else
+       *         DEBOUNCE_UNSETTLED.
+       */
+      template <typename Clock>
+      inline uint8_t debounce(uint8_t reading, uint8_t &settled, typename Clock::Time &changeMillis, typename Clock::DebounceTime debounceTime) {
+        typename Clock::Time now = Clock::now();
+        bool steady = (typename Clock::Time)(now - changeMillis) >= debounceTime;
+        uint8_t rc = DEBOUNCE_UNSETTLED;
+
+        reading = reading ? HIGH : LOW;
+        if(reading != (flags_ & READING)) {
+          // New reading, so restart the debounce timer.
+          changeMillis = now;
+          rc = DEBOUNCE_CHANGED;
+
+          // Report the first change after a steady reading at once, if eager.
+          if(steady && reading != state() && (reading == released() ? EAGER_RELEASE : EAGER_PRESS)) {
+            rc |= DEBOUNCE_SETTLED;
+          }
+        } else if(steady) {
+          // Use reading if we have the same reading for >= DELAY ms.
+          rc = DEBOUNCE_SETTLED;
+        }
+
+        flags_ = (flags_ & ~(READING | STATE)) | reading | ((rc & DEBOUNCE_SETTLED) ? (reading << 1) : (flags_ & STATE));
+        if(rc & DEBOUNCE_SETTLED) settled = reading;
+        return rc;
+      }
+
+      /**
+       * Record a change in the debounced state. Nothing to do as the time of
+       * the raw change is already recorded.
+       *
+       * @param changeMillis When the state changed (unchanged).
+       */
+      template <typename Clock>
+      inline void stateChanged(typename Clock::Time & /* changeMillis */) {}
+
+    protected:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Return the debounced state of the pin.
+       *
+       * @return The debounced state (HIGH or LOW).
+       */
+      inline uint8_t state() const {
+        return (flags_ & STATE) ? HIGH : LOW;
+      }
+
+      /**
+       * Return the released (un-pushed) state of the pin.
+       *
+       * @return The released state (HIGH or LOW).
+       */
+      inline uint8_t released() const {
+        return (flags_ & RELEASED) ? HIGH : LOW;
+      }
+
+      /**
+       * Determine if the debouncer has settled on a state, so further readings
+       * of that state change nothing (the last reading was the state).
+       *
+       * @param state The debounced state of the pin.
+       *
+       * @return True if settled on the state, else false.
+       */
+      inline bool settledOn(uint8_t state) const {
+        return (flags_ & READING) == (state ? READING : 0);
+      }
+
+    protected:
+      //
+      // Constants...
+      //
+      enum {
+        READING = 0x01, ///< The previous raw reading.
+        STATE = 0x02, ///< The debounced state.
+        RELEASED = 0x04 ///< The released (un-pushed) state.
+      };
+
+    protected:
+      //
+      // Data...
+      //
+      uint8_t flags_; ///< Previous reading, debounced state and released state.
+  };
+
+  /**
+   * Debouncer integrating readings in a saturating counter. Each HIGH reading
+   * counts up and each LOW reading counts down. The reading settles when the
+   * counter reaches either end, so a change needs SAMPLES readings in the same
+   * direction. Uses 1 byte of memory per button.
+   *
+   * @param SAMPLES The number of readings to settle (1-127, default 8).
+   */
+  template <uint8_t SAMPLES = 8>
+  class IntegratorDebouncer: protected Debouncer {
+    protected:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create the debouncer, settled on the initial state.
+       *
+       * @param initState The initial (un-pushed) state of the button.
+       */
+      inline IntegratorDebouncer(uint8_t initState)
+      :count_(initState ? (READING | SAMPLES) : 0) {}
+
+    protected:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Debounce a reading by counting up (HIGH) or down (LOW).
+       *
+       * @param reading The raw reading of the pin.
+       * @param settled Set to the settled reading when settled.
+       * @param changeMillis When the debounced state last changed (unused).
+       * @param debounceTime The debounce time in clock ticks (unused).
+       *
+       * @return DEBOUNCE_CHANGED and/or DEBOUNCE_SETTLED, else
+       *         DEBOUNCE_UNSETTLED.
+       */
+      template <typename Clock>
+      inline uint8_t debounce(uint8_t reading, uint8_t &settled, typename Clock::Time & /* changeMillis */, typename Clock::DebounceTime /* debounceTime */) {
+        uint8_t count = count_ & ~READING;
+        uint8_t rc = DEBOUNCE_UNSETTLED;
+
+        if(reading) {
+          if(count < SAMPLES) ++count;
+          if(!(count_ & READING)) rc = DEBOUNCE_CHANGED;
+          count_ = READING | count;
+        } else {
+          if(count > 0) --count;
+          if(count_ & READING) rc = DEBOUNCE_CHANGED;
+          count_ = count;
+        }
+
+        if(count == 0 || count == SAMPLES) {
+          settled = count ? HIGH : LOW;
+          rc |= DEBOUNCE_SETTLED;
+        }
+        return rc;
+      }
+
+      /**
+       * Record when the debounced state changed, to time held, idle and click
+       * states.
+       *
+       * @param changeMillis When the state changed (updated).
+       */
+      template <typename Clock>
+      inline void stateChanged(typename Clock::Time &changeMillis) {
+        changeMillis = Clock::now();
+      }
+
+    protected:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Determine if the debouncer has settled on a state, so further readings
+       * of that state change nothing (the count is saturated at the state).
+       *
+       * @param state The debounced state of the pin.
+       *
+       * @return True if settled on the state, else false.
+       */
+      inline bool settledOn(uint8_t state) const {
+        return (count_ & ~READING) == (state ? SAMPLES : 0);
+      }
+
+    protected:
+      //
+      // Constants...
+      //
+      enum {
+        READING = 0x80 ///< Top bit of count_ holds the previous raw reading.
+      };
+
+    protected:
+      //
+      // Data...
+      //
+      uint8_t count_; ///< Integrated count (bits 0-6) and previous reading (bit 7).
+  };
+
+  /**
+   * Debouncer matching a pattern in the last 8 readings, held in a shift
+   * register. A change settles when the oldest 2 readings are the old state
+   * and the newest 3 readings are the new state, ignoring the 3 readings
+   * between (where the contacts bounce). Faster to respond than waiting for 8
+   * matching readings. Uses 1 byte of memory per button.
+   */
+  class PatternDebouncer: protected Debouncer {
+    protected:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create the debouncer, settled on the initial state.
+       *
+       * @param initState The initial (un-pushed) state of the button.
+       */
+      inline PatternDebouncer(uint8_t initState)
+      :history_(initState ? 0xFF : 0x00) {}
+
+    protected:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Debounce a reading by shifting it into the history and matching the
+       * rising (0b00xxx111) or falling (0b11xxx000) patterns.
+       *
+       * @param reading The raw reading of the pin.
+       * @param settled Set to the settled reading when settled.
+       * @param changeMillis When the debounced state last changed (unused).
+       * @param debounceTime The debounce time in clock ticks (unused).
+       *
+       * @return DEBOUNCE_CHANGED and/or DEBOUNCE_SETTLED, else
+       *         DEBOUNCE_UNSETTLED.
+       */
+      template <typename Clock>
+      inline uint8_t debounce(uint8_t reading, uint8_t &settled, typename Clock::Time & /* changeMillis */, typename Clock::DebounceTime /* debounceTime */) {
+        uint8_t rc = (uint8_t)(history_ & 0x01) != (reading ? 0x01 : 0x00) ? DEBOUNCE_CHANGED : DEBOUNCE_UNSETTLED;
+
+        history_ = (history_ << 1) | (reading ? 0x01 : 0x00);
+        if((history_ & MASK) == RISING) {
+          history_ = 0xFF;
+        } else if((history_ & MASK) == FALLING) {
+          history_ = 0x00;
+        }
+
+        if(history_ == 0xFF || history_ == 0x00) {
+          settled = history_ ? HIGH : LOW;
+          rc |= DEBOUNCE_SETTLED;
+        }
+        return rc;
+      }
+
+      /**
+       * Record when the debounced state changed, to time held, idle and click
+       * states.
+       *
+       * @param changeMillis When the state changed (updated).
+       */
+      template <typename Clock>
+      inline void stateChanged(typename Clock::Time &changeMillis) {
+        changeMillis = Clock::now();
+      }
+
+    protected:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Determine if the debouncer has settled on a state, so further readings
+       * of that state change nothing (all 8 readings are the state).
+       *
+       * @param state The debounced state of the pin.
+       *
+       * @return True if settled on the state, else false.
+       */
+      inline bool settledOn(uint8_t state) const {
+        return history_ == (state ? 0xFF : 0x00);
+      }
+
+    protected:
+      //
+      // Constants...
+      //
+      enum {
+        MASK = 0xC7, ///< Readings to match (ignoring the 3 middle readings).
+        RISING = 0x07, ///< Pattern of a LOW to HIGH change.
+        FALLING = 0xC0 ///< Pattern of a HIGH to LOW change.
+      };
+
+    protected:
+      //
+      // Data...
+      //
+      uint8_t history_; ///< The last 8 readings (newest in bit 0).
+  };
+
+  /**
+   * Debouncer taking a majority vote of the last 7 readings, held in a shift
+   * register. The reading is HIGH when at least 4 of the last 7 readings are
+   * HIGH, else LOW. Tolerates isolated noise spikes even when the button is
+   * not changing. Uses 1 byte of memory per button.
+   */
+  class MajorityDebouncer: protected Debouncer {
+    protected:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create the debouncer, settled on the initial state.
+       *
+       * @param initState The initial (un-pushed) state of the button.
+       */
+      inline MajorityDebouncer(uint8_t initState)
+      :history_(initState ? 0x7F : 0x00) {}
+
+    protected:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Debounce a reading by shifting it into the history and counting the
+       * HIGH readings.
+       *
+       * @param reading The raw reading of the pin.
+       * @param settled Set to the majority reading.
+       * @param changeMillis When the debounced state last changed (unused).
+       * @param debounceTime The debounce time in clock ticks (unused).
+       *
+       * @return DEBOUNCE_SETTLED, with DEBOUNCE_CHANGED if the raw reading
+       *         changed.
+       */
+      template <typename Clock>
+      inline uint8_t debounce(uint8_t reading, uint8_t &settled, typename Clock::Time & /* changeMillis */, typename Clock::DebounceTime /* debounceTime */) {
+        uint8_t changed = (uint8_t)(history_ & 0x01) != (reading ? 0x01 : 0x00);
+        uint8_t votes;
+
+        history_ = ((history_ << 1) | (reading ? 0x01 : 0x00)) & 0x7F;
+
+        // Count the HIGH readings (bits set) in parallel.
+        votes = history_ - ((history_ >> 1) & 0x55);
+        votes = (votes & 0x33) + ((votes >> 2) & 0x33);
+        votes = (votes + (votes >> 4)) & 0x0F;
+
+        settled = votes >= 4 ? HIGH : LOW;
+        return changed ? (DEBOUNCE_CHANGED | DEBOUNCE_SETTLED) : DEBOUNCE_SETTLED;
+      }
+
+      /**
+       * Record when the debounced state changed, to time held, idle and click
+       * states.
+       *
+       * @param changeMillis When the state changed (updated).
+       */
+      template <typename Clock>
+      inline void stateChanged(typename Clock::Time &changeMillis) {
+        changeMillis = Clock::now();
+      }
+
+    protected:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Determine if the debouncer has settled on a state, so further readings
+       * of that state change nothing (all 7 readings are the state).
+       *
+       * @param state The debounced state of the pin.
+       *
+       * @return True if settled on the state, else false.
+       */
+      inline bool settledOn(uint8_t state) const {
+        return history_ == (state ? 0x7F : 0x00);
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      uint8_t history_; ///< The last 7 readings (newest in bit 0).
+  };
+}
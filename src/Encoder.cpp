@@ -0,0 +1,15 @@
+/**
+ * @file Encoder.cpp Implementation of the Quadrature class.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include "Encoder.h"
+
+// Indexed by the previous reading (bits 3-2) and current reading (bits 1-0)
+// of the A and B pins. Forward is 00 -> 01 -> 11 -> 10 -> 00.
+const int8_t able::Quadrature::TABLE_[16] = {
+   0, +1, -1,  0,
+  -1,  0,  0, +1,
+  +1,  0,  0, -1,
+   0, -1, +1,  0
+};
@@ -0,0 +1,314 @@
+/**
+ * @file Encoder.h Definition of the rotary encoder classes (Quadrature and
+ * Encoder). An Encoder reads the two quadrature pins of a rotary encoder and
+ * is also a button for its push switch, so one handle() (or one ButtonList)
+ * scans both.
+ *
+ * The pins are decoded with a table of the 16 transitions between readings
+ * of the A and B pins. Valid transitions move a quarter-step forward (+1) or
+ * back (-1); no change and invalid transitions (both pins changing at once,
+ * i.e. contact bounce or a missed reading) count 0. Quarter-steps are summed
+ * until the encoder rests at a detent, and a step is counted only when they
+ * add up to at least half a step in one direction, so bounce back and forth
+ * across a transition cancels out rather than being counted.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#include <Arduino.h>
+#include "Clocks.h"
+
+namespace able {
+  /**
+   * Quadrature decoding table shared by all encoders.
+   */
+  class Quadrature {
+    public:
+      //
+      // Static Members...
+      //
+
+      /**
+       * Return the quarter-steps moved by a transition of the A and B pins.
+       *
+       * @param prev The previous reading (A in bit 1, B in bit 0).
+       * @param curr The current reading (A in bit 1, B in bit 0).
+       *
+       * @return +1 for a quarter-step forward, -1 back, 0 for no change or an
+       *         invalid transition.
+       */
+      static inline int8_t quarters(uint8_t prev, uint8_t curr) {
+        return TABLE_[(prev << 2 | curr) & 0x0F];
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      static const int8_t TABLE_[16]; ///< Quarter-steps of each transition.
+  };
+
+  /**
+   * Rotary encoder class. Reads the A and B pins of an encoder, counting the
+   * steps turned between detents, and handles the push switch as a button of
+   * the Switch class (e.g. AblePullupClickerButton). The A and B pins use the
+   * same resistor circuit as the switch, and are read when the encoder is
+   * handled, or in an interrupt service routine (ISR) if interrupts were
+   * attached with beginInterrupts().
+   *
+   * Encoders may be turned slowly for precise changes or quickly for large
+   * ones. Steps turned faster than the acceleration velocity (see
+   * setAcceleration()) are multiplied, and read with readSteps().
+   *
+   * @param Circuit Either a PullupResistorCircuit or PulldownResistorCircuit
+   *                class matching the resistor circuit used with the encoder,
+   *                or MixedResistorCircuit to choose it for each pin.
+   * @param Switch The button class of the push switch.
+   * @param STEPS The quarter-steps per detent (4, 2 or 1). Defaults to 4,
+   *              where the encoder rests with both pins released.
+   * @param Clock The clock class timing the steps. Defaults to the clock of
+   *              the switch.
+   */
+  template <typename Circuit, typename Switch, uint8_t STEPS = 4, typename Clock = typename Switch::PinClock>
+  class Encoder: public Switch {
+    public:
+      //
+      // Static Members...
+      //
+
+      /**
+       * Set the acceleration of all encoders of this type. Steps turned
+       * faster than the velocity are multiplied by 1 more for each multiple
+       * of the velocity, up to the maximum multiplier. Acceleration is off by
+       * default.
+       *
+       * @param velocity The steps per second to start accelerating (or 0 to
+       *                 turn acceleration off).
+       * @param maxMultiplier The maximum steps counted for one step turned.
+       */
+      static inline void setAcceleration(uint16_t velocity, uint8_t maxMultiplier = 10) {
+        accelVelocity_ = velocity;
+        maxMultiplier_ = maxMultiplier;
+      }
+
+    public:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create an encoder on the specified pins.
+       *
+       * @param pinA The pin connected to the A (or CLK) output.
+       * @param pinB The pin connected to the B (or DT) output.
+       * @param switchPin The pin connected to the push switch.
+       * @param args Further arguments of the switch (e.g. callback function
+       *             and id).
+       */
+      template <typename... Args>
+      Encoder(uint8_t pinA, uint8_t pinB, uint8_t switchPin, Args... args)
+      :Switch(switchPin, args...), pinA_(pinA), pinB_(pinB), ab_(0), quarters_(0), direction_(0),
+       interrupts_(false), steps_(0), position_(0), stepTime_(0), stepInterval_(NEVER) {}
+
+    private:
+      //
+      // Copying and assignment (not supported)...
+      //
+      Encoder(const Encoder &cpy) = delete; ///< Copying encoders is not supported.
+      Encoder &operator=(const Encoder &) = delete; ///< Assigning encoders is not supported.
+
+    public:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Initialise the encoder. Called from setup() of an Arduino program.
+       */
+      void begin() {
+        pinMode(pinA_, Circuit::inputMode(pinA_));
+        pinMode(pinB_, Circuit::inputMode(pinB_));
+        ab_ = readPins();
+        Switch::begin();
+      }
+
+      /**
+       * Initialise the encoder, reading the A and B pins in an interrupt
+       * service routine (ISR) whenever either changes, instead of in
+       * handle(). The ISR must call update() of the encoder. Both pins must
+       * support interrupts (see digitalPinToInterrupt()).
+       *
+       * @param isr The interrupt service routine.
+       */
+      void beginInterrupts(void (*isr)()) {
+        begin();
+        interrupts_ = true;
+        attachInterrupt(digitalPinToInterrupt(pinA_), isr, CHANGE);
+        attachInterrupt(digitalPinToInterrupt(pinB_), isr, CHANGE);
+      }
+
+      /**
+       * Handle the encoder. Called from loop() of an Arduino program. Reads
+       * the A and B pins (unless read by an ISR) and handles the switch.
+       */
+      inline void handle() {
+        if(!interrupts_) update();
+        Switch::handle();
+      }
+
+      /**
+       * Read the A and B pins, counting any step turned. Called by handle(),
+       * or by the ISR passed to beginInterrupts().
+       */
+      void update() {
+        uint8_t ab = readPins();
+
+        if(ab == ab_) return;
+        quarters_ = quarters_ + Quadrature::quarters(ab_, ab);
+        ab_ = ab;
+        if(STEPS == 4 ? ab == 0 : STEPS == 2 ? (ab == 0 || ab == 3) : true) {
+          int8_t quarters = quarters_;
+          quarters_ = 0;
+          if(2 * quarters >= STEPS) step(1);
+          else if(-2 * quarters >= STEPS) step(-1);
+        }
+      }
+
+      /**
+       * Return the steps turned since the last call, multiplied by the
+       * acceleration, and reset them to 0. Steps are positive when B changes
+       * before A (swap the pins to reverse the direction).
+       *
+       * @return The steps turned since the last call.
+       */
+      int16_t readSteps() {
+        noInterrupts();
+        int16_t steps = steps_;
+        steps_ = 0;
+        interrupts();
+        return steps;
+      }
+
+    public:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Return the position of the encoder: the detents turned since it
+       * began, without acceleration.
+       *
+       * @return The position of the encoder.
+       */
+      long position() const {
+        noInterrupts();
+        long position = position_;
+        interrupts();
+        return position;
+      }
+
+      /**
+       * Return the velocity of the encoder in steps per second, from the
+       * interval between the last two steps. Falls as time passes without
+       * another step, and is 0 after the encoder changes direction.
+       *
+       * @return The velocity (negative when turning back).
+       */
+      long velocity() const {
+        noInterrupts();
+        typename Clock::Time stepTime = stepTime_, interval = stepInterval_;
+        int8_t direction = direction_;
+        interrupts();
+
+        typename Clock::Time since = elapsed<Clock>(stepTime);
+        if(since > interval) interval = since;
+        long v = interval == NEVER ? 0 : Clock::TICKS_PER_SECOND / (interval ? interval : 1);
+        return direction < 0 ? -v : v;
+      }
+
+    protected:
+      /**
+       * Read the A and B pins (unless read by an ISR) and the pin of the
+       * switch, without checking the held, idle and click times of the switch
+       * (e.g. for a ScheduledButtonList).
+       *
+       * @return True if the switch was pressed or released, else false.
+       */
+      inline bool handlePin() {
+        if(!interrupts_) update();
+        return Switch::handlePin();
+      }
+
+      /**
+       * Add the A and B pins and the pin of the switch to a snapshot of the
+       * input ports (see PortSnapshot in Scheduled.h).
+       *
+       * @param snapshot The snapshot to add the pins to.
+       */
+      template <typename Snapshot>
+      inline void snapshotPins(Snapshot &snapshot) const {
+        snapshot.add(pinA_);
+        snapshot.add(pinB_);
+        Switch::snapshotPins(snapshot);
+      }
+
+    protected:
+      //
+      // Constants...
+      //
+      static const typename Clock::Time NEVER = (typename Clock::Time) ~(typename Clock::Time) 0; ///< Interval before a second step.
+
+      /**
+       * Read the A and B pins.
+       *
+       * @return A in bit 1 and B in bit 0, set when the pin is active.
+       */
+      inline uint8_t readPins() const {
+        return ((digitalRead(pinA_) ^ Circuit::polarity(pinA_)) != Circuit::BUTTON_RELEASED) << 1 | ((digitalRead(pinB_) ^ Circuit::polarity(pinB_)) != Circuit::BUTTON_RELEASED);
+      }
+
+      /**
+       * Count a step, measuring the velocity and applying the acceleration.
+       *
+       * @param direction +1 for a step forward, -1 back.
+       */
+      void step(int8_t direction) {
+        typename Clock::Time now = Clock::now();
+        uint8_t multiplier = 1;
+
+        stepInterval_ = direction == direction_ ? (typename Clock::Time)(now - stepTime_) : NEVER;
+        stepTime_ = now;
+        direction_ = direction;
+        position_ = position_ + direction;
+        if(accelVelocity_ && stepInterval_ != NEVER) {
+          unsigned long v = Clock::TICKS_PER_SECOND / (stepInterval_ ? stepInterval_ : 1);
+          unsigned long m = 1 + v / accelVelocity_;
+          multiplier = m < maxMultiplier_ ? m : maxMultiplier_;
+        }
+        steps_ = steps_ + direction * multiplier;
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      static uint16_t accelVelocity_; ///< Steps per second to start accelerating (0 for none).
+      static uint8_t maxMultiplier_; ///< Maximum steps counted for one step turned.
+      const uint8_t pinA_; ///< The pin of the A output.
+      const uint8_t pinB_; ///< The pin of the B output.
+      volatile uint8_t ab_; ///< Last reading of the A and B pins.
+      volatile int8_t quarters_; ///< Quarter-steps since the last detent.
+      volatile int8_t direction_; ///< Direction of the last step.
+      bool interrupts_; ///< True if the pins are read by an ISR.
+      volatile int16_t steps_; ///< Accelerated steps since the last readSteps().
+      volatile long position_; ///< Detents turned since the encoder began.
+      volatile typename Clock::Time stepTime_; ///< Time of the last step.
+      volatile typename Clock::Time stepInterval_; ///< Interval between the last two steps.
+  };
+
+  //
+  // Static data...
+  //
+  template <typename Circuit, typename Switch, uint8_t STEPS, typename Clock> uint16_t Encoder<Circuit, Switch, STEPS, Clock>::accelVelocity_ = 0;
+  template <typename Circuit, typename Switch, uint8_t STEPS, typename Clock> uint8_t Encoder<Circuit, Switch, STEPS, Clock>::maxMultiplier_ = 1;
+}
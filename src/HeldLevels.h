@@ -0,0 +1,141 @@
+/**
+ * @file HeldLevels.h Definition of the HeldLevelsButton template class. A
+ * held-levels button is a callback button sending a held event for each of
+ * several held times, such as 1s to adjust a setting, 3s to open a menu and
+ * 10s for a factory reset. The callback function reads which level the
+ * button reached with heldLevel(). For example:
+ *
+ *     using Button = able::HeldLevelsButton<AblePullupCallbackButton, 3>;
+ *     ...
+ *     Button::setHeldTime(1, 1000);
+ *     Button::setHeldTime(2, 3000);
+ *     Button::setHeldTime(3, 10000);
+ *
+ * Only the held time of the next level is checked, and only while the button
+ * is held (its last event was a held event), so a released or pressed button
+ * checks nothing more than a callback button, however many levels there are.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#include "CallbackButton.h"
+
+namespace able {
+  /**
+   * Held-levels button template, sending a held event as the callback button
+   * becomes held (level 1), then another as it is held for the held time of
+   * each further level. The held time of level 1 is that of the button type;
+   * the held times of further levels are set for the held-levels type, and
+   * levels without a held time (the default) are not sent. Held events must
+   * be sent by the callback button (see CallbackEvents::TIMED_EVENTS). Uses
+   * one byte more memory per button.
+   *
+   * Held-levels buttons are handled with handle(), alone or in a ButtonList;
+   * a ScheduledButtonList only sends level 1.
+   *
+   * @param Button The callback button class (e.g.
+   *               AblePullupCallbackDoubleClickerButton).
+   * @param LEVELS The number of held levels (2 or more). Defaults to 3.
+   */
+  template <typename Button, uint8_t LEVELS = 3>
+  class HeldLevelsButton: public Button {
+    public:
+      //
+      // Types...
+      //
+      typedef typename Button::PinClock::HeldTime HeldTime; ///< Type of held times.
+
+    public:
+      //
+      // Creators...
+      //
+      using Button::Button; ///< Created as the button class.
+
+    public:
+      //
+      // Static Members...
+      //
+      using Button::setHeldTime; ///< Set the held time of level 1.
+      using Button::heldTime; ///< Return the held time of level 1.
+
+      /**
+       * Set the held time of a level. Held times should increase with each
+       * level; a level with no held time (0), and the levels above it, are
+       * not sent.
+       *
+       * @param level The held level (1 to LEVELS). Level 1 is the held time
+       *              of the button type.
+       * @param heldTime The number of milliseconds (clock ticks) the button
+       *                 must be held for to reach the level.
+       */
+      static inline void setHeldTime(uint8_t level, HeldTime heldTime) {
+        if(level == 1) {
+          Button::setHeldTime(heldTime);
+        } else if(level >= 2 && level <= LEVELS) {
+          heldTimes_[level - 2] = heldTime;
+        }
+      }
+
+      /**
+       * Return the held time of a level.
+       *
+       * @param level The held level (1 to LEVELS).
+       *
+       * @return The number of milliseconds (clock ticks) the button must be
+       *         held for to reach the level, or 0 if the level is not sent.
+       */
+      static inline HeldTime heldTime(uint8_t level) {
+        if(level == 1) {
+          return Button::heldTime();
+        }
+        return level >= 2 && level <= LEVELS ? heldTimes_[level - 2] : 0;
+      }
+
+    public:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Handle the button, sending a held event for each level it reaches.
+       * Called from loop() of an Arduino program.
+       */
+      void handle() {
+        Button::handle();
+        if(this->lastEvent_ != CallbackEvents::HELD_EVENT) {
+          levels_ = 0;
+        } else if(levels_ < LEVELS - 1 && heldTimes_[levels_] && this->elapsed() >= heldTimes_[levels_]) {
+          ++levels_;
+          this->doCallback(CallbackEvents::HELD_EVENT);
+        }
+      }
+
+    public:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Return the held level the button has reached. Callback functions read
+       * the level of a held event from the button.
+       *
+       * @return The held level (1 to LEVELS), or 0 if not held.
+       */
+      inline uint8_t heldLevel() const {
+        return this->lastEvent_ == CallbackEvents::HELD_EVENT ? levels_ + 1 : 0;
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      static HeldTime heldTimes_[LEVELS - 1]; ///< Held times of levels 2 to LEVELS.
+
+      uint8_t levels_ = 0; ///< Held levels sent above level 1.
+  };
+
+  //
+  // Static member definitions...
+  //
+  template <typename Button, uint8_t LEVELS> typename HeldLevelsButton<Button, LEVELS>::HeldTime HeldLevelsButton<Button, LEVELS>::heldTimes_[LEVELS - 1] = {};
+}
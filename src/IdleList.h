@@ -0,0 +1,180 @@
+/**
+ * @file IdleList.h Definition of the IdleButtonList template class. An idle
+ * list times how long since any of its buttons changed, so a program can tell
+ * that no button of a panel has been touched for a while (e.g. to blank a
+ * display) without checking the idle time of every button.
+ *
+ * The list keeps a single timestamp of the last debounced change of any of its
+ * buttons, and a count of the buttons pressed. While a button is pressed, the
+ * list is not idle; once all are released, each handle() compares the one
+ * timestamp with the idle time of the list. The buttons need not check idle
+ * times themselves, so callback buttons of the list can send only held events
+ * (see CallbackEvents::TIMED_EVENTS), or none, saving their idle checks.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#include "ButtonList.h"
+#include "Callbacks.h"
+
+namespace able {
+  /**
+   * Idle button list template, handling a list of buttons and calling a
+   * function with an IDLE_EVENT when none of them has been pressed or
+   * released for the idle time of the list. Buttons must be handled through
+   * the list for their changes to be timed.
+   *
+   * @param Button The button class of the list.
+   * @param Clock The clock timing the list. Defaults to that of the buttons.
+   */
+  template <typename Button, typename Clock = typename Button::PinClock>
+  class IdleButtonList: public ButtonList<Button> {
+    public:
+      //
+      // Types...
+      //
+      typedef ButtonList<Button> List; ///< The button list class.
+      typedef UntimedCallback::CallbackFn CallbackFn; ///< The callback function type: `void fn(CALLBACK_EVENT event, ButtonId id)`.
+
+    public:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create an idle list of buttons.
+       *
+       * @param buttons The array of buttons to manage together.
+       * @param callbackFn The function to call when the list becomes idle
+       *                   (default none).
+       * @param id Identifier of the list passed to the callback function
+       *           (default 0).
+       */
+      template <size_t n>
+      inline IdleButtonList(Button *(&buttons)[n], CallbackFn callbackFn = 0, ButtonId id = 0)
+      :IdleButtonList(buttons, n, callbackFn, id) {}
+
+      /**
+       * Create an idle list of buttons.
+       *
+       * @param buttons The array of buttons to manage together.
+       * @param len The number of buttons in the list.
+       * @param callbackFn The function to call when the list becomes idle
+       *                   (default none).
+       * @param id Identifier of the list passed to the callback function
+       *           (default 0).
+       */
+      inline IdleButtonList(Button **buttons, size_t len, CallbackFn callbackFn = 0, ButtonId id = 0)
+      :List(buttons, len), callbackFn_(callbackFn), id_(id) {}
+
+    public:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Initialise all the buttons, starting the idle time of the list.
+       * Called from setup() of an Arduino program.
+       */
+      void begin() {
+        List::begin();
+        lastChange_ = Clock::now();
+        pressed_ = 0;
+        idle_ = false;
+      }
+
+      /**
+       * Handle all the buttons, restarting the idle time of the list if any
+       * was pressed or released, and calling the callback function with an
+       * IDLE_EVENT once the list becomes idle. Called in the loop() of an
+       * Arduino program.
+       */
+      void handle() {
+        bool changed = false;
+        this->anyStates_ = 0;
+        for(size_t i = 0; i < this->len_; ++i) {
+          Button *button = this->buttons_[i];
+          bool pressed = button->isPressed();
+          button->handle();
+          if(button->isPressed() != pressed) {
+            pressed ? --pressed_ : ++pressed_;
+            changed = true;
+          }
+        }
+        if(changed) {
+          lastChange_ = Clock::now();
+          idle_ = false;
+        } else if(!idle_ && !pressed_ && elapsed<Clock>(lastChange_) >= idleTime_) {
+          idle_ = true;
+          if(callbackFn_) callbackFn_(CallbackEvents::IDLE_EVENT, id_);
+        }
+      }
+
+      /**
+       * Set the idle time of the list. If no button of the list is pressed or
+       * released for longer than this time, the list is idle.
+       *
+       * @param idleTime The number of milliseconds (clock ticks) before the
+       *                 list is idle.
+       */
+      inline void setIdleTime(typename Clock::IdleTime idleTime) {
+        idleTime_ = idleTime;
+      }
+
+      /**
+       * Set a (new) callback function.
+       *
+       * @param callbackFn The function to call when the list becomes idle.
+       *                   Use 0 to clear the callback function.
+       */
+      inline void setCallback(CallbackFn callbackFn) {
+        callbackFn_ = callbackFn;
+      }
+
+    public:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Determine if the list was idle when last handled: no button pressed,
+       * and none pressed or released for the idle time of the list.
+       *
+       * @return True if idle, else false.
+       */
+      inline bool isIdle() const {
+        return idle_;
+      }
+
+      /**
+       * Return the idle time of the list.
+       *
+       * @return The number of milliseconds (clock ticks) before the list is
+       *         idle.
+       */
+      inline typename Clock::IdleTime idleTime() const {
+        return idleTime_;
+      }
+
+      /**
+       * Return the time since any button of the list was pressed or released
+       * (or since the list began).
+       *
+       * @return The clock ticks since the last change.
+       */
+      inline typename Clock::Time sinceLastChange() const {
+        return elapsed<Clock>(lastChange_);
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      CallbackFn callbackFn_; ///< Function to call when the list becomes idle.
+      ButtonId id_; ///< Identifier of the list passed to the callback function.
+      typename Clock::Time lastChange_ = 0; ///< When any button last changed.
+      typename Clock::IdleTime idleTime_ = Clock::IDLE_TIME; ///< Time required for the list to be idle.
+      size_t pressed_ = 0; ///< The number of buttons pressed.
+      bool idle_ = false; ///< True once the list is idle, until a button changes.
+  };
+}
@@ -0,0 +1,24 @@
+/**
+ * @file Ids.h Definition of the ButtonId type identifying callback buttons.
+ * Ids are 8 bits by default, so callback functions take a `uint8_t id`, and
+ * up to 255 buttons can be auto-assigned ids. Define ABLE_BUTTON_ID_BITS as
+ * 16 (e.g. `-DABLE_BUTTON_ID_BITS=16` in the build flags) for up to 65535
+ * buttons, declaring callback functions with an `able::ButtonId id`. The
+ * library and every program using it must be built with the same width.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#include <Arduino.h>
+
+#if !defined(ABLE_BUTTON_ID_BITS)
+#define ABLE_BUTTON_ID_BITS 8 ///< Width of button ids (8 or 16).
+#endif
+
+namespace able {
+#if ABLE_BUTTON_ID_BITS > 8
+  typedef uint16_t ButtonId; ///< Identifier of a button passed to callback functions.
+#else
+  typedef uint8_t ButtonId; ///< Identifier of a button passed to callback functions.
+#endif
+}
@@ -0,0 +1,270 @@
+/**
+ * @file IsrList.h Definition of the IsrButtonList template class. An ISR list
+ * is handled in an interrupt service routine (ISR), such as a timer interrupt
+ * sampling the buttons at a steady rate, while loop() reads the states of its
+ * buttons.
+ *
+ * Reading a button's held, idle or click state reads several multi-byte
+ * fields (e.g. the time it last changed and the count of clicks), which an ISR
+ * may change half way through, giving a state the button was never in. So
+ * each handle() ends by publishing a snapshot of the states of the buttons
+ * (see ButtonList::snapshot()) into one of two buffers, and then counting a
+ * sequence count, which selects the published buffer. The next handle() writes
+ * the other buffer, so the snapshot a read is copying is only overwritten if
+ * the ISR runs twice during the copy. The queries and snapshot() copy the
+ * published snapshot and check the count, copying again in that case. The
+ * copy is a few dozen bytes however long the list, so a read is repeated
+ * only if the timer period is shorter than the copy, and never retried
+ * without end. states() and counts() read each button in turn, repeating a
+ * button if the ISR ran during its read, so their retries are bounded by the
+ * read of a single button. Interrupts are never disabled for a read; only the
+ * resets, which change a button, disable interrupts, one button at a time.
+ *
+ * handle() reads the states of every button after handling them, so takes
+ * roughly twice as long as handling a ButtonList, and must finish within the
+ * timer period: the longer the list, the longer the period needed. The two
+ * snapshots use 52 bytes of memory on AVR boards.
+ *
+ * The count is for an ISR and loop() on the same processor core.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#include "ButtonList.h"
+
+namespace able {
+  /**
+   * ISR button list template, handled in an ISR and read consistently from
+   * loop() (see above). Queries and snapshots give the states at the last
+   * handle(). Callback buttons of the list are called from the ISR; use
+   * DeferredCallback to call their callback functions from loop() instead.
+   * Read the buttons through the list: reading a button directly is not
+   * protected from the ISR.
+   *
+   * @param Button The button class of the list.
+   * @param List The list class to protect (e.g. IdleButtonList<Button>).
+   *             Defaults to ButtonList<Button>.
+   */
+  template <typename Button, typename List = ButtonList<Button>>
+  class IsrButtonList: public List {
+    public:
+      //
+      // Creators...
+      //
+      using List::List; ///< Created as the list class.
+
+    public:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Initialise all the buttons, publishing their states. Called from
+       * setup() of an Arduino program, before the ISR is enabled.
+       */
+      void begin() {
+        List::begin();
+        published_[seq_ & 1] = this->readStates();
+      }
+
+      /**
+       * Handle all the buttons, then publish their states. Called from the
+       * ISR.
+       */
+      void handle() {
+        List::handle();
+        published_[(seq_ + 1) & 1] = this->readStates();
+        barrier();
+        seq_ = seq_ + 1; // Publish the snapshot.
+      }
+
+      /**
+       * Reset clicked state of all buttons, returning true if any were clicked.
+       * Interrupts are disabled while each button is reset.
+       *
+       * @return True if any clicked, else false.
+       */
+      bool resetClicked() {
+        return reset(&Button::resetClicked, &ButtonStates::clicked, ButtonStates::CLICKED);
+      }
+
+      /**
+       * Reset double-clicked state of all buttons, returning true if any were
+       * double-clicked. Interrupts are disabled while each button is reset.
+       *
+       * @return True if any double-clicked, else false.
+       */
+      bool resetDoubleClicked() {
+        return reset(&Button::resetDoubleClicked, &ButtonStates::doubleClicked, ButtonStates::DOUBLE_CLICKED);
+      }
+
+      /**
+       * Reset single-clicked state of all buttons, returning true if any were
+       * single-clicked. Interrupts are disabled while each button is reset.
+       *
+       * @return True if any single-clicked, else false.
+       */
+      bool resetSingleClicked() {
+        return reset(&Button::resetSingleClicked, &ButtonStates::singleClicked, ButtonStates::SINGLE_CLICKED);
+      }
+
+    public:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Return the states of all the buttons at the last handle() (see
+       * ButtonList::snapshot()), copied from the snapshot the ISR published.
+       *
+       * @return The states of the buttons.
+       */
+      ButtonStates snapshot() const {
+        uint8_t seq;
+        ButtonStates rc;
+        do {
+          seq = readBegin();
+          rc = published_[seq & 1];
+        } while(overwritten(seq));
+        return rc;
+      }
+
+      /**
+       * Return the states of a button, consistently with handle().
+       *
+       * @param i The position of the button in the list.
+       *
+       * @return The ButtonStates bits of the button.
+       */
+      uint8_t states(size_t i) const {
+        uint8_t seq, rc;
+        do {
+          seq = readBegin();
+          rc = this->buttons_[i]->states();
+        } while(readRetry(seq));
+        return rc;
+      }
+
+      bool allPressed() const { return snapshot().all & ButtonStates::PRESSED; } ///< @copydoc ButtonList::allPressed()
+      bool anyPressed() const { return snapshot().any & ButtonStates::PRESSED; } ///< @copydoc ButtonList::anyPressed()
+      bool allHeld() const { return snapshot().all & ButtonStates::HELD; } ///< @copydoc ButtonList::allHeld()
+      bool anyHeld() const { return snapshot().any & ButtonStates::HELD; } ///< @copydoc ButtonList::anyHeld()
+      bool allIdle() const { return snapshot().all & ButtonStates::IDLE; } ///< @copydoc ButtonList::allIdle()
+      bool anyIdle() const { return snapshot().any & ButtonStates::IDLE; } ///< @copydoc ButtonList::anyIdle()
+      bool allClicked() const { return snapshot().all & ButtonStates::CLICKED; } ///< @copydoc ButtonList::allClicked()
+      bool anyClicked() const { return snapshot().any & ButtonStates::CLICKED; } ///< @copydoc ButtonList::anyClicked()
+      bool allDoubleClicked() const { return snapshot().all & ButtonStates::DOUBLE_CLICKED; } ///< @copydoc ButtonList::allDoubleClicked()
+      bool anyDoubleClicked() const { return snapshot().any & ButtonStates::DOUBLE_CLICKED; } ///< @copydoc ButtonList::anyDoubleClicked()
+      bool allSingleClicked() const { return snapshot().all & ButtonStates::SINGLE_CLICKED; } ///< @copydoc ButtonList::allSingleClicked()
+      bool anySingleClicked() const { return snapshot().any & ButtonStates::SINGLE_CLICKED; } ///< @copydoc ButtonList::anySingleClicked()
+
+      /**
+       * For buttons using PinCounters, return the counts totalled across all
+       * the buttons (see ButtonList::counts()). Each button's counts are read
+       * consistently with handle(), though the ISR may count more presses of
+       * a button already totalled.
+       *
+       * @return The total counts of the buttons in the list.
+       */
+      PinCounts counts() const {
+        PinCounts rc = {0, 0, 0, 0, 0, 0};
+        for(size_t i = 0; i < this->len_; ++i) {
+          uint8_t seq;
+          PinCounts counts;
+          do {
+            seq = readBegin();
+            counts = this->buttons_[i]->counts();
+          } while(readRetry(seq));
+          rc.bounces += counts.bounces;
+          rc.presses += counts.presses;
+          rc.holds += counts.holds;
+          rc.clicks += counts.clicks;
+          rc.doubleClicks += counts.doubleClicks;
+          if(counts.maxBurst > rc.maxBurst) rc.maxBurst = counts.maxBurst;
+        }
+        return rc;
+      }
+
+    protected:
+      /**
+       * Stop the compiler moving reads and writes of the buttons and snapshots
+       * past reads and writes of the sequence count.
+       */
+      static inline void barrier() {
+        __asm__ __volatile__("" ::: "memory");
+      }
+
+      /**
+       * Start reading the buttons.
+       *
+       * @return The sequence count before the read.
+       */
+      inline uint8_t readBegin() const {
+        uint8_t seq = seq_;
+        barrier();
+        return seq;
+      }
+
+      /**
+       * Finish reading a button.
+       *
+       * @param seq The sequence count before the read.
+       *
+       * @return True if handle() changed the buttons during the read, which
+       *         must then be repeated, else false.
+       */
+      inline bool readRetry(uint8_t seq) const {
+        barrier();
+        return seq != seq_;
+      }
+
+      /**
+       * Finish copying the published snapshot.
+       *
+       * @param seq The sequence count before the copy.
+       *
+       * @return True if handle() ran twice during the copy, so may have
+       *         overwritten the snapshot being copied, else false.
+       */
+      inline bool overwritten(uint8_t seq) const {
+        barrier();
+        return (uint8_t)(seq_ - seq) >= 2;
+      }
+
+      /**
+       * Reset each button, disabling interrupts while it is reset, then clear
+       * the state from the published snapshot, so queries see the reset at
+       * once rather than after the next handle().
+       *
+       * @param resetFn The reset function of the button.
+       * @param mask The buttons in the state in a snapshot.
+       * @param state The ButtonStates bit of the state.
+       *
+       * @return True if any button was reset, else false.
+       */
+      bool reset(bool (Button::*resetFn)(), uint32_t ButtonStates::*mask, uint8_t state) {
+        bool rc = false;
+        this->anyStates_ = 0;
+        for(size_t i = 0; i < this->len_; ++i) {
+          noInterrupts();
+          bool wasSet = (this->buttons_[i]->*resetFn)();
+          interrupts();
+          rc = rc || wasSet;
+        }
+        noInterrupts();
+        ButtonStates &published = published_[seq_ & 1];
+        published.*mask = 0;
+        published.any &= ~state;
+        published.all &= ~state;
+        interrupts();
+        return rc;
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      ButtonStates published_[2]; ///< The snapshots published by handle(), selected by seq_.
+      volatile uint8_t seq_ = 0; ///< Sequence count, counting the snapshots published.
+  };
+}
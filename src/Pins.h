@@ -7,27 +7,162 @@
  */
 #pragma once
 #include <Arduino.h>
+#include "Clocks.h"
+#include "Ids.h"
+#include "Counters.h"
+#include "Debouncers.h"
+#include "Trace.h"
 
 namespace able {
+  /**
+   * States of a list of buttons, read in a single pass by the snapshot() of a
+   * ButtonList. Each mask has a bit for each of the first 32 buttons of the
+   * list (bit 0 for the first button); the any and all fields have a bit for
+   * each state (e.g. PRESSED) set if any or all of the buttons are in it.
+   */
+  struct ButtonStates {
+    //
+    // Constants...
+    //
+    enum STATE {
+      PRESSED = 1, ///< The button is pressed.
+      HELD = 2, ///< The button is held.
+      IDLE = 4, ///< The button is idle.
+      CLICKED = 8, ///< The button is clicked.
+      SINGLE_CLICKED = 16, ///< The button is single-clicked.
+      DOUBLE_CLICKED = 32, ///< The button is double-clicked.
+      ALL_STATES = 63 ///< All of the states.
+    };
+
+    //
+    // Data...
+    //
+    uint32_t pressed; ///< The pressed buttons.
+    uint32_t held; ///< The held buttons.
+    uint32_t idle; ///< The idle buttons.
+    uint32_t clicked; ///< The clicked buttons.
+    uint32_t singleClicked; ///< The single-clicked buttons.
+    uint32_t doubleClicked; ///< The double-clicked buttons.
+    uint8_t any; ///< The states of any of the buttons.
+    uint8_t all; ///< The states of all of the buttons.
+  };
+
+  /**
+   * Debounce, held, idle and click times of the pins timed by a clock. Every
+   * debounced pin (and ButtonArray) timed by the same clock shares these
+   * times, whatever its counters, debouncer or button type, so setting them
+   * through any button type sets them for all buttons using that clock.
+   *
+   * @param Clock The clock class timing the pins (e.g. MillisClock).
+   */
+  template <typename Clock>
+  class PinTimes {
+    protected:
+      //
+      // Static Members...
+      //
+
+      /**
+       * Return the pressed, held and idle states of a pin.
+       *
+       * @param pressed True if the debounced state of the pin is pressed.
+       * @param since The time since the pin last changed.
+       *
+       * @return The ButtonStates bits of the pin.
+       */
+      static inline uint8_t timedStates(bool pressed, typename Clock::Time since) {
+        if(pressed) {
+          return since >= heldTime_ ? ButtonStates::PRESSED | ButtonStates::HELD : ButtonStates::PRESSED;
+        }
+        return since >= idleTime_ ? ButtonStates::IDLE : 0;
+      }
+
+      /**
+       * Return the single-clicked and double-clicked states of a pin.
+       *
+       * @param stateCount The changes in state within the double-click time.
+       * @param since The time since the pin last changed.
+       *
+       * @return The ButtonStates bits of the pin.
+       */
+      static inline uint8_t clickStates(uint8_t stateCount, typename Clock::Time since) {
+        if(stateCount >= 4) {
+          return ButtonStates::DOUBLE_CLICKED;
+        }
+        return stateCount == 2 && since >= clickTime_ ? ButtonStates::SINGLE_CLICKED : 0;
+      }
+
+      /**
+       * Count a change in debounced state towards a double-click: changes
+       * within the click time of the last are counted, else counting starts
+       * again.
+       *
+       * @param stateCount The changes in state within the double-click time
+       *                   (updated).
+       * @param prevMillis When the state last changed (updated).
+       * @param changeMillis When the state changed.
+       *
+       * @return The updated count.
+       */
+      static inline uint8_t countStateChange(uint8_t &stateCount, typename Clock::Time &prevMillis, typename Clock::Time changeMillis) {
+        if((typename Clock::Time)(changeMillis - prevMillis) < clickTime_) {
+          ++stateCount;
+        } else {
+          stateCount = 1;
+        }
+        prevMillis = changeMillis;
+        return stateCount;
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      static typename Clock::DebounceTime debounceTime_; ///< Time required to debounce the pins.
+      static typename Clock::HeldTime heldTime_; ///< Time required for a button to be held.
+      static typename Clock::IdleTime idleTime_; ///< Time required for a button to be idle.
+      static typename Clock::HeldTime clickTime_; ///< Half the time required for a button to be double-clicked.
+  };
+
   /**
    * Pin base class reading direct from the pin (without debouncing). Other pins
    * inherit directly/indirectly from this base class. This class cannot be
    * instantiated directly. Instantiation comes through Button sub-classes.
    */
   class Pin {
-    protected:
+    public:
+      //
+      // Types...
+      //
+      typedef uint8_t Source; ///< What the pin is configured by: the pin itself.
+
+    public:
       //
       // Static Members...
       //
 
+      /**
+       * Determine if every button identifier has been auto-assigned. Buttons
+       * created after that are auto-assigned id 0 rather than reusing ids, so
+       * check this after creating buttons if there may be more than 255 (or
+       * 65535 with 16-bit ids, see Ids.h).
+       * 
+       * @return True if no more ids can be auto-assigned, else false.
+       */
+      inline static bool idsExhausted() {
+        return autoId_ == (ButtonId) ~(ButtonId) 0;
+      }
+
+    protected:
       /**
        * Return the next auto-assigned button identifier.
        * 
        * @return The next auto-assigned button identifier. Each call increases the
-       *         auto-assigned identifier.
+       *         auto-assigned identifier, until all are assigned (see
+       *         idsExhausted()), after which 0 is returned.
        */
-      inline static uint8_t nextId() {
-        return ++autoId_;
+      inline static ButtonId nextId() {
+        return idsExhausted() ? 0 : ++autoId_;
       }
 
     protected:
@@ -62,9 +197,14 @@ namespace able {
        * *not* used (which can consume almost 1K of memory to deal with).
        * Runtime polymorphism is not required, so avoiding virtual functions
        * saves memory.
+       *
+       * @param Circuit The resistor circuit class, whose polarity() is XORed
+       *                with the reading.
+       * @param source The source of the pin (see source()).
        */
-      inline void readPin() {
-        currState_ = digitalRead(pin_);
+      template <typename Circuit>
+      inline void readPin(Source source) {
+        currState_ = digitalRead(pin(source)) ^ Circuit::polarity(source);
       }
 
     protected:
@@ -72,6 +212,61 @@ namespace able {
       // Accessors...
       //
 
+      /**
+       * Return the pin connected to the button.
+       *
+       * @return The Arduino pin.
+       */
+      inline uint8_t pin() const {
+        return pin_;
+      }
+
+      /**
+       * Return the source the pin is configured by, passed to the resistor
+       * circuit and to readPin(). For a Pin, that is the pin itself (see
+       * TablePin for pins configured by a table entry instead).
+       *
+       * @return The Arduino pin.
+       */
+      inline Source source() const {
+        return pin_;
+      }
+
+      /**
+       * Return the pin of a source.
+       *
+       * @param source The source of the pin (see source()).
+       *
+       * @return The Arduino pin.
+       */
+      static inline uint8_t pin(Source source) {
+        return source;
+      }
+
+      /**
+       * Return the debounce time of the pin, which is that of the pin's type.
+       *
+       * @param source The source of the pin (unused).
+       * @param debounceTime The debounce time of the pin's type.
+       *
+       * @return The debounce time to use for the pin.
+       */
+      template <typename DebounceTime>
+      static inline DebounceTime ownDebounceTime(Source /* source */, DebounceTime debounceTime) {
+        return debounceTime;
+      }
+
+      /**
+       * Add the pins read by the button to a snapshot of the input ports (see
+       * PortSnapshot in Scheduled.h).
+       *
+       * @param snapshot The snapshot to add the pins to.
+       */
+      template <typename Snapshot>
+      inline void snapshotPins(Snapshot &snapshot) const {
+        snapshot.add(pin_);
+      }
+
       /**
        * Return the number of clicks.
        * 
@@ -83,12 +278,25 @@ namespace able {
       inline int clicks(uint8_t /* pressed */, uint8_t /* released */) {
         return 0;
       }
-      
+
+      /**
+       * Return the states of the pin.
+       *
+       * @param pressed The pressed state of a button.
+       * @param released The released state of a button.
+       *
+       * @return The ButtonStates bits: only PRESSED, as held, idle and click
+       *         states are not supported by default.
+       */
+      inline uint8_t states(uint8_t pressed, uint8_t /* released */) const {
+        return currState_ == pressed ? ButtonStates::PRESSED : 0;
+      }
+
       protected:
       //
       // Data...
       //
-      static uint8_t autoId_; ///< Auto-assigned button identifier.
+      static ButtonId autoId_; ///< Last auto-assigned button identifier.
 
       uint8_t pin_; ///< The Arduino pin connected to the button.
       uint8_t currState_; ///< The reading of the pin.
@@ -98,8 +306,28 @@ namespace able {
    * Debouned Pin class. Manages making reliable readings from an input pin.
    * The readPin() method manages debouncing the pin readings. You cannot use
    * this class directly. Use one of the Button sub-classes instead.
+   * 
+   * @param Counters The counter class (NoCounters, PinCounters or
+   *                 BounceHistogram) counting what happens to the pin.
+   *                 Defaults to NoCounters.
+   * @param Debouncer The debouncer class (TimerDebouncer, IntegratorDebouncer,
+   *                  PatternDebouncer or MajorityDebouncer) turning raw
+   *                  readings into a steady reading. Defaults to
+   *                  TimerDebouncer.
+   * @param Clock The clock class (MillisClock, MicrosClock or Millis16Clock)
+   *              timing the pin. All times of the pin are in ticks of the
+   *              clock. Defaults to MillisClock.
+   * @param Base The class holding the pin and its reading (Pin, or TablePin
+   *             for buttons configured by a ButtonTable). Defaults to Pin.
    */
-  class DebouncedPin: public Pin {
+  template <typename Counters = NoCounters, typename Debouncer = TimerDebouncer, typename Clock = MillisClock, typename Base = Pin>
+  class DebouncedPin: public Base, public Counters, protected Debouncer, public PinTimes<Clock> {
+    public:
+      //
+      // Types...
+      //
+      typedef Clock PinClock; ///< The clock timing the pin.
+
     public:
       //
       // Static Members...
@@ -111,33 +339,39 @@ namespace able {
        * button presses in a short time period, confusing your program. The
        * debounce time is the number of milliseconds to wait when a reading
        * changes before using that reading. See https://docs.arduino.cc/built-in-examples/digital/Debounce
-       * for details on debounce.
+       * for details on debounce. The time is shared by all buttons timed by
+       * the same clock (see PinTimes).
        * 
-       * @param debounceTime The number of milliseconds before a button state
-       *                     change is returned (default 50ms, max 255ms).
+       * @param debounceTime The number of milliseconds (clock ticks) before a
+       *                     button state change is returned (default 50ms,
+       *                     max 255ms).
        */
-      inline static void setDebounceTime(uint8_t debounceTime) {
-        debounceTime_ = debounceTime;
+      inline static void setDebounceTime(typename Clock::DebounceTime debounceTime) {
+        PinTimes<Clock>::debounceTime_ = debounceTime;
       };
 
       /**
        * Set the held time for input pins. If a button is pressed for longer
-       * than this time, it will be held.
+       * than this time, it will be held. The time is shared by all buttons
+       * timed by the same clock.
        * 
-       * @param heldTime The number of milliseconds for a held state (default 1s).
+       * @param heldTime The number of milliseconds (clock ticks) for a held
+       *                 state (default 1s).
        */
-      inline static void setHeldTime(uint16_t heldTime) {
-        heldTime_ = heldTime;
+      inline static void setHeldTime(typename Clock::HeldTime heldTime) {
+        PinTimes<Clock>::heldTime_ = heldTime;
       }
 
       /**
        * Set the idle time for input pins. If a button is unpressed for longer
-       * than this time, it will be idle.
+       * than this time, it will be idle. The time is shared by all buttons
+       * timed by the same clock.
        * 
-       * @param idleTime The number of milliseconds for an idle state (default 60s).
+       * @param idleTime The number of milliseconds (clock ticks) for an idle
+       *                 state (default 60s).
        */
-      inline static void setIdleTime(uint32_t idleTime) {
-        idleTime_ = idleTime;
+      inline static void setIdleTime(typename Clock::IdleTime idleTime) {
+        PinTimes<Clock>::idleTime_ = idleTime;
       }
 
     protected:
@@ -153,7 +387,7 @@ namespace able {
        * @param initState The initial (un-pushed) state of the button.
        */
       DebouncedPin(uint8_t pin, uint8_t initState)
-      :Pin(pin, initState), prevReading_(initState) {}
+      :Base(pin, initState), Counters(initState), Debouncer(initState), millisStart_(0) {}
 
     private:
       //
@@ -172,19 +406,35 @@ namespace able {
        * save memory, virtual functions are *not* used (which can consume almost
        * 1K of memory to deal with). Runtime polymorphism is not required, so
        * avoiding virtual functions saves memory.
+       *
+       * @param Circuit The resistor circuit class, whose polarity() is XORed
+       *                with the reading.
+       * @param source The source of the pin (see Pin::source()).
        */
-      inline void readPin() {
-        byte currReading = digitalRead(pin_);
+      template <typename Circuit>
+      inline void readPin(typename Base::Source source) {
+        uint8_t pin = Base::pin(source);
+        uint8_t polarity = Circuit::polarity(source);
+        uint8_t reading = digitalRead(pin) ^ polarity;
+        uint8_t settled;
+        uint8_t rc = Debouncer::template debounce<Clock>(reading, settled, millisStart_, this->pinDebounceTime(Base::ownDebounceTime(source, PinTimes<Clock>::debounceTime_)));
+
+        if(rc & Debouncer::DEBOUNCE_CHANGED) {
+          this->template countChange<Clock>(pin, reading ^ polarity); // The level of the pin.
+        }
 
-        // New reading, so start the debounce timer.
-        if (currReading != prevReading_) {
-          millisStart_ = millis();
-        } else if ((millis() - millisStart_) >= debounceTime_) {
-          // Use reading if we have the same reading for >= DELAY ms.
-          currState_ = currReading;
+        if(rc & Debouncer::DEBOUNCE_SETTLED) {
+          if(settled != this->currState_) {
+            Debouncer::template stateChanged<Clock>(millisStart_);
+          }
+          this->template countSettled<Clock>(this->currState_, settled, millisStart_, PinTimes<Clock>::heldTime_);
+          this->currState_ = settled;
         }
 
-        prevReading_ = currReading;
+        // Keep held and idle states over the wrap of a short clock.
+        if(!(rc & Debouncer::DEBOUNCE_CHANGED)) {
+          limitAge<Clock>(millisStart_);
+        }
       }
 
     public:
@@ -197,8 +447,8 @@ namespace able {
        * 
        * @returns The number of milliseconds of debounce time. 
        */
-      static inline uint8_t debounceTime() {
-        return debounceTime_;
+      static inline typename Clock::DebounceTime debounceTime() {
+        return PinTimes<Clock>::debounceTime_;
       }
 
       /**
@@ -206,8 +456,8 @@ namespace able {
        * 
        * @returns The number of milliseconds after which a pin is held.
        */
-      static inline uint16_t heldTime() {
-        return heldTime_;
+      static inline typename Clock::HeldTime heldTime() {
+        return PinTimes<Clock>::heldTime_;
       }
 
       /**
@@ -215,28 +465,89 @@ namespace able {
        * 
        * @returns The number of milliseconds after which a pin is idle.
        */
-      static inline uint32_t idleTime() {
-        return idleTime_;
+      static inline typename Clock::IdleTime idleTime() {
+        return PinTimes<Clock>::idleTime_;
+      }
+
+    protected:
+      /**
+       * Return the time since the pin last changed.
+       *
+       * @return The clock ticks since the pin last changed.
+       */
+      inline typename Clock::Time elapsed() const {
+        return able::elapsed<Clock>(millisStart_);
+      }
+
+      /**
+       * Return the states of the pin, reading the clock once.
+       *
+       * @param pressed The pressed state of a button.
+       * @param released The released state of a button.
+       *
+       * @return The ButtonStates bits of the pin.
+       */
+      inline uint8_t states(uint8_t pressed, uint8_t released) const {
+        return states(pressed, released, elapsed());
+      }
+
+      /**
+       * Return the pressed, held and idle states of the pin.
+       *
+       * @param pressed The pressed state of a button.
+       * @param released The released state of a button.
+       * @param since The time since the pin last changed.
+       *
+       * @return The ButtonStates bits of the pin.
+       */
+      inline uint8_t states(uint8_t pressed, uint8_t /* released */, typename Clock::Time since) const {
+        return PinTimes<Clock>::timedStates(this->currState_ == pressed, since);
+      }
+
+      /**
+       * Determine if the click time since the pin last changed is over, so
+       * no click can still be waiting to be counted.
+       *
+       * @return Always true, as clicks are known when the pin is released.
+       */
+      inline bool clickTimedOut() const {
+        return true;
+      }
+
+      /**
+       * Determine if reading the pin again cannot change anything while the
+       * pin reads the same: the debouncer has settled on the debounced state
+       * and the counters would not count the reading.
+       *
+       * @return True if further readings of the same level change nothing,
+       *         else false.
+       */
+      inline bool steady() const {
+        return Debouncer::settledOn(this->currState_) && !Counters::countsSettled(this->currState_);
       }
 
     protected:
       //
       // Data...
       //
-      static uint8_t debounceTime_; ///< Time required to debounce all input pins.
-      static uint16_t heldTime_; ///< Time required for button to be held.
-      static uint32_t idleTime_; ///< Time required for button to be idle.
-
-      uint8_t prevReading_; ///< The previous pin reading, to monitor state transitions.
-      unsigned long millisStart_; ///< Debounce start timer to handle button transition.
+      typename Clock::Time millisStart_; ///< When the pin last changed, timing debounce, held, idle and click states.
   };
 
   /**
    * Debounced pin class that remembers the previous debounced state. This
    * allows clicks (a combination of press then release) to be identified.
    * This class extends the basic DebouncedPin class to add the previous state.
+   * 
+   * @param Counters The counter class (NoCounters, PinCounters or
+   *                 BounceHistogram) counting what happens to the pin.
+   *                 Defaults to NoCounters.
+   * @param Debouncer The debouncer class turning raw readings into a steady
+   *                  reading. Defaults to TimerDebouncer.
+   * @param Clock The clock class timing the pin. Defaults to MillisClock.
+   * @param Base The class holding the pin and its reading. Defaults to Pin.
    */
-  class ClickerPin: public DebouncedPin {
+  template <typename Counters = NoCounters, typename Debouncer = TimerDebouncer, typename Clock = MillisClock, typename Base = Pin>
+  class ClickerPin: public DebouncedPin<Counters, Debouncer, Clock, Base> {
     protected:
       //
       // Creators...
@@ -250,7 +561,7 @@ namespace able {
        * @param initState The initial (un-pushed) state of the button.
        */
       ClickerPin(uint8_t pin, uint8_t initState)
-      :DebouncedPin(pin, initState), prevState_(initState) {}
+      :DebouncedPin<Counters, Debouncer, Clock, Base>(pin, initState), prevState_(initState) {}
 
     private:
       //
@@ -269,15 +580,21 @@ namespace able {
        * state changes, remember the previous state so clicks (press then
        * release can be identified). Calls DebouncedPin::readPin() and monitors
        * for a change in debounced state, remembering the previous state.
+       *
+       * @param Circuit The resistor circuit class, whose polarity() is XORed
+       *                with the reading.
+       * @param source The source of the pin (see Pin::source()).
        */
-      inline void readPin() {
-        uint8_t currState = currState_; // Remember current state.
+      template <typename Circuit>
+      inline void readPin(typename Base::Source source) {
+        uint8_t currState = this->currState_; // Remember current state.
 
-        DebouncedPin::readPin();
+        DebouncedPin<Counters, Debouncer, Clock, Base>::template readPin<Circuit>(source);
 
         // Save previous state if it changed.
-        if(currState != currState_) {
+        if(currState != this->currState_) {
           prevState_ = currState;
+          this->countClick(this->currState_);
         }
       }
 
@@ -298,6 +615,26 @@ namespace able {
         return this->currState_ == released && this->prevState_ == pressed;
       }
 
+      /// @copydoc DebouncedPin::states(uint8_t, uint8_t) const
+      inline uint8_t states(uint8_t pressed, uint8_t released) const {
+        return states(pressed, released, this->elapsed());
+      }
+
+      /**
+       * Return the pressed, held, idle and clicked states of the pin.
+       *
+       * @param pressed The pressed state of a button.
+       * @param released The released state of a button.
+       * @param since The time since the pin last changed.
+       *
+       * @return The ButtonStates bits of the pin.
+       */
+      inline uint8_t states(uint8_t pressed, uint8_t released, typename Clock::Time since) const {
+        uint8_t rc = DebouncedPin<Counters, Debouncer, Clock, Base>::states(pressed, released, since);
+        if(this->currState_ == released && this->prevState_ == pressed) rc |= ButtonStates::CLICKED;
+        return rc;
+      }
+
       protected:
       //
       // Data...
@@ -308,8 +645,17 @@ namespace able {
   /**
    * Pin class that counts state changes within a time-period. This enables it
    * to identify double-clicks.
+   * 
+   * @param Counters The counter class (NoCounters, PinCounters or
+   *                 BounceHistogram) counting what happens to the pin.
+   *                 Defaults to NoCounters.
+   * @param Debouncer The debouncer class turning raw readings into a steady
+   *                  reading. Defaults to TimerDebouncer.
+   * @param Clock The clock class timing the pin. Defaults to MillisClock.
+   * @param Base The class holding the pin and its reading. Defaults to Pin.
    */
-  class DoubleClickerPin: public ClickerPin {
+  template <typename Counters = NoCounters, typename Debouncer = TimerDebouncer, typename Clock = MillisClock, typename Base = Pin>
+  class DoubleClickerPin: public ClickerPin<Counters, Debouncer, Clock, Base> {
     public:
       //
       // Static Members...
@@ -320,10 +666,12 @@ namespace able {
        * within this millisecond value, it will be counted, else the count
        * resets. Allows tracking of double-clicks within the specified time.
        * 
-       * @param clickTime The number of milliseconds between clicks.
+       * @param clickTime The number of milliseconds (clock ticks) between
+       *                  clicks. Shared by all buttons timed by the same
+       *                  clock.
        */
-      inline static void setClickTime(uint16_t clickTime) {
-        clickTime_ = clickTime / 2; // Halve clickTime as we count presses and releases.
+      inline static void setClickTime(typename Clock::HeldTime clickTime) {
+        PinTimes<Clock>::clickTime_ = clickTime / 2; // Halve clickTime as we count presses and releases.
       }
 
     protected:
@@ -339,7 +687,7 @@ namespace able {
        * @param initState The initial (un-pushed) state of the button.
        */
       DoubleClickerPin(uint8_t pin, uint8_t initState)
-      :ClickerPin(pin, initState) {}
+      :ClickerPin<Counters, Debouncer, Clock, Base>(pin, initState), stateCount_(0), prevMillis_(0) {}
 
     private:
       //
@@ -358,8 +706,8 @@ namespace able {
        * 
        * @returns The number of milliseconds of debounce time. 
        */
-      static inline uint16_t clickTime() {
-        return clickTime_ * 2; // Double the clickTime_ to match halving in setClickTime.
+      static inline typename Clock::HeldTime clickTime() {
+        return PinTimes<Clock>::clickTime_ * 2; // Double the clickTime_ to match halving in setClickTime.
       }
 
       /**
@@ -374,10 +722,40 @@ namespace able {
         if(this->stateCount_ >= 4) {
           return 2;
         } else {
-          return this->stateCount_ == 2 && ((millis() - this->millisStart_) >= this->clickTime_);
+          return this->stateCount_ == 2 && clickTimedOut();
         }
       }
 
+      /// @copydoc DebouncedPin::states(uint8_t, uint8_t) const
+      inline uint8_t states(uint8_t pressed, uint8_t released) const {
+        return states(pressed, released, this->elapsed());
+      }
+
+      /**
+       * Return the pressed, held, idle, clicked, single-clicked and
+       * double-clicked states of the pin.
+       *
+       * @param pressed The pressed state of a button.
+       * @param released The released state of a button.
+       * @param since The time since the pin last changed.
+       *
+       * @return The ButtonStates bits of the pin.
+       */
+      inline uint8_t states(uint8_t pressed, uint8_t released, typename Clock::Time since) const {
+        return ClickerPin<Counters, Debouncer, Clock, Base>::states(pressed, released, since) | PinTimes<Clock>::clickStates(stateCount_, since);
+      }
+
+    protected:
+      /**
+       * Determine if the click time since the pin last changed is over, so
+       * no click can still be waiting to be counted.
+       *
+       * @return True if the double-click time has passed, else false.
+       */
+      inline bool clickTimedOut() const {
+        return this->elapsed() >= PinTimes<Clock>::clickTime_;
+      }
+
     protected:
       //
       // Modifiers...
@@ -388,23 +766,24 @@ namespace able {
        * state changes, remember the previous state so clicks (press then
        * release can be identified). Calls DebouncedPin::readPin() and monitors
        * for a change in debounced state, remembering the previous state.
+       *
+       * @param Circuit The resistor circuit class, whose polarity() is XORed
+       *                with the reading.
+       * @param source The source of the pin (see Pin::source()).
        */
-      inline void readPin() {
-        uint8_t currState = currState_; // Remember current state.
+      template <typename Circuit>
+      inline void readPin(typename Base::Source source) {
+        uint8_t currState = this->currState_; // Remember current state.
 
         // NB: Calls DebouncedPin version to avoid remembering current state
         // twice.
-        DebouncedPin::readPin();
+        DebouncedPin<Counters, Debouncer, Clock, Base>::template readPin<Circuit>(source);
 
         // Save previous state & millis if it changed.
-        if(currState != currState_) {
-          prevState_ = currState;
-          if(millisStart_ - prevMillis_ < clickTime_) {
-            ++stateCount_;
-          } else {
-            stateCount_ = 1;
-          }
-          prevMillis_ = millisStart_;
+        if(currState != this->currState_) {
+          this->prevState_ = currState;
+          this->countClick(this->currState_);
+          if(PinTimes<Clock>::countStateChange(stateCount_, prevMillis_, this->millisStart_) == 4) this->countDoubleClick();
         }
       }
       
@@ -412,9 +791,15 @@ namespace able {
       //
       // Data...
       //
-      static uint16_t clickTime_; ///< Time required for button to be double-clicked.
-
       uint8_t stateCount_; ///< Count changes in state within double-click time.
-      unsigned long prevMillis_; ///< Previous millisecond count from last state change.
+      typename Clock::Time prevMillis_; ///< Previous clock time from last state change.
   };
+
+  //
+  // Static Members...
+  //
+  template <typename Clock> typename Clock::DebounceTime PinTimes<Clock>::debounceTime_ = Clock::DEBOUNCE_TIME;
+  template <typename Clock> typename Clock::HeldTime PinTimes<Clock>::heldTime_ = Clock::HELD_TIME;
+  template <typename Clock> typename Clock::IdleTime PinTimes<Clock>::idleTime_ = Clock::IDLE_TIME;
+  template <typename Clock> typename Clock::HeldTime PinTimes<Clock>::clickTime_ = Clock::CLICK_TIME / 2;
 }
@@ -0,0 +1,391 @@
+/**
+ * @file Scheduled.h Definitions of the ScheduledButton and ScheduledButtonList
+ * template classes. A scheduled list checks the held, idle and click times of
+ * its callback buttons only when one of them is due, rather than checking
+ * every button on every handle(), so lists of many buttons spend no time on
+ * buttons that are simply waiting.
+ *
+ * The held, idle and click times are the same for all buttons of a type, so
+ * each button's deadlines are a fixed time after its last change. The list
+ * keeps its buttons linked in the order they last changed, which is then also
+ * the order of their deadlines: a button that changes moves to the end. Each
+ * of the held, click and idle checks keeps its place in the order, and moves
+ * on past each button as it becomes due (or is not waiting for that check,
+ * e.g. a released button for the held check). A pass of handle() checks only
+ * the next button of each (3 clock readings), plus the buttons that fall due.
+ * With a clock shorter than 32 bits (e.g. the Millis16Clock), it also keeps
+ * the buttons that changed longest ago within the age limit of the clock
+ * (see limitAge() in Clocks.h), reading the clock once more.
+ *
+ * The list also keeps a snapshot of the input port registers of its pins
+ * (where the Arduino core maps pins to ports, as on AVR boards). When the
+ * ports read the same as on the last pass and every button's debouncer has
+ * settled, reading the pins again would change nothing, so the pass skips
+ * them: an idle pass reads a few port registers and the three checks above,
+ * however many buttons there are.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#include "ButtonList.h"
+
+namespace able {
+  /**
+   * Snapshot of the input port registers holding a set of pins, to tell
+   * cheaply whether any of the pins changed since the last snapshot. Holds up
+   * to PORTS ports; pins on further ports (or on cores without port
+   * registers) cannot be snapshot, so the snapshot always reports a change.
+   */
+  class PortSnapshot {
+    public:
+      //
+      // Constants...
+      //
+      enum {
+        PORTS = 4 ///< The most ports held.
+      };
+
+    public:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Remove all the pins from the snapshot.
+       */
+      inline void clear() {
+        count_ = 0;
+        complete_ = true;
+      }
+
+      /**
+       * Add a pin to the snapshot.
+       *
+       * @param pin The pin to add.
+       */
+      void add(uint8_t pin) {
+#if defined(portInputRegister) && defined(digitalPinToPort) && defined(digitalPinToBitMask) && defined(NOT_A_PORT)
+        uint8_t port = digitalPinToPort(pin);
+        uint8_t i = 0;
+
+        if(port == NOT_A_PORT) {
+          complete_ = false;
+          return;
+        }
+        while(i < count_ && ports_[i] != portInputRegister(port)) ++i;
+        if(i == count_) {
+          if(count_ == PORTS) {
+            complete_ = false;
+            return;
+          }
+          ports_[count_] = portInputRegister(port);
+          masks_[count_] = 0;
+          values_[count_++] = 0;
+        }
+        masks_[i] |= digitalPinToBitMask(pin);
+#else
+        (void) pin;
+        complete_ = false;
+#endif
+      }
+
+      /**
+       * Read the ports, comparing the pins with the last snapshot.
+       *
+       * @return True if any pin changed (or the pins cannot all be snapshot),
+       *         else false.
+       */
+      inline bool changed() {
+        bool changed = !complete_;
+        for(uint8_t i = 0; i < count_; ++i) {
+          Bits value = *ports_[i] & masks_[i];
+          changed = changed || value != values_[i];
+          values_[i] = value;
+        }
+        return changed;
+      }
+
+    protected:
+      //
+      // Types...
+      //
+#if defined(portInputRegister) && defined(digitalPinToPort) && defined(digitalPinToBitMask) && defined(NOT_A_PORT)
+      typedef decltype(portInputRegister(digitalPinToPort(0))) Port; ///< Pointer to a port input register.
+      typedef decltype(digitalPinToBitMask(0)) Bits; ///< The pin bits of a port.
+#else
+      typedef volatile uint8_t *Port; ///< Pointer to a port input register (unused).
+      typedef uint8_t Bits; ///< The pin bits of a port (unused).
+#endif
+
+    protected:
+      //
+      // Data...
+      //
+      Port ports_[PORTS]; ///< The input registers of the ports.
+      Bits masks_[PORTS]; ///< The pins of each port.
+      Bits values_[PORTS]; ///< The pins of each port when last read.
+      uint8_t count_ = 0; ///< The number of ports.
+      bool complete_ = false; ///< True if every pin added is in the snapshot.
+  };
+
+  /**
+   * Scheduled button template, linking a callback button (or callback
+   * encoder) into the order of a ScheduledButtonList. The button may still be
+   * handled on its own with handle(). Uses two pointers of memory per button.
+   *
+   * @param Button The callback button class (e.g.
+   *               AblePullupCallbackDoubleClickerButton).
+   */
+  template <typename Button>
+  class ScheduledButton: public Button {
+    template <typename> friend class ScheduledButtonList;
+
+    public:
+      //
+      // Creators...
+      //
+      using Button::Button; ///< Created as the button class.
+
+    protected:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Read the pin, calling the callback function if the button was pressed
+       * or released, without checking the held, idle and click times.
+       *
+       * @return True if the button's held, idle and click times restarted
+       *         (the button changed, or its debouncer restarted timing),
+       *         else false.
+       */
+      inline bool handleEdges() {
+        typename Button::PinClock::Time millisStart = this->millisStart_;
+        uint8_t currState = this->currState_;
+        this->handlePin();
+        return millisStart != this->millisStart_ || currState != this->currState_;
+      }
+
+      /**
+       * Keep the time since the button changed within the age limit of its
+       * clock (see limitAge() in Clocks.h), as the button is not handled
+       * while it is steady.
+       *
+       * @return True if the button's time was moved on, else false.
+       */
+      inline bool handleAge() {
+        return limitAge<typename Button::PinClock>(this->millisStart_);
+      }
+
+      /**
+       * Call the callback function if the button has become held.
+       *
+       * @return True if the button is not waiting to be held (it is held or
+       *         released, or held events are not sent), else false.
+       */
+      inline bool handleHeldTime() {
+        if(!(Button::TIMED_EVENTS_SENT & CallbackEvents::HELD_EVENTS) || !this->isPressed() || this->lastEvent_ == CallbackEvents::HELD_EVENT) {
+          return true;
+        }
+        if(!this->isHeld()) {
+          return false;
+        }
+        this->doCallback(CallbackEvents::HELD_EVENT);
+        return true;
+      }
+
+      /**
+       * Call the callback function if the button has been single-clicked
+       * once the click time is over.
+       *
+       * @return True if the button is not waiting for the click time (it is
+       *         over, or the button is pressed), else false.
+       */
+      inline bool handleClickTime() {
+        if(this->isPressed()) {
+          return true;
+        }
+        if(!this->clickTimedOut()) {
+          return false;
+        }
+        this->handleClicks();
+        return true;
+      }
+
+      /**
+       * Call the callback function if the button has become idle.
+       *
+       * @return True if the button is not waiting to be idle (it is idle or
+       *         pressed, or idle events are not sent), else false.
+       */
+      inline bool handleIdleTime() {
+        if(!(Button::TIMED_EVENTS_SENT & CallbackEvents::IDLE_EVENTS) || this->isPressed() || this->lastEvent_ == CallbackEvents::IDLE_EVENT) {
+          return true;
+        }
+        if(!this->isIdle()) {
+          return false;
+        }
+        this->doCallback(CallbackEvents::IDLE_EVENT);
+        return true;
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      ScheduledButton *prev_ = 0; ///< The button that changed before this one.
+      ScheduledButton *next_ = 0; ///< The button that changed after this one.
+  };
+
+  /**
+   * Scheduled button list template, handling a list of ScheduledButtons and
+   * checking their held, idle and click times only as they fall due (see
+   * above). Events are the same, at the same times, as for a ButtonList.
+   * Buttons must be handled through the list once it has begun.
+   *
+   * @param Button The ScheduledButton class of the list.
+   */
+  template <typename Button>
+  class ScheduledButtonList: public ButtonList<Button> {
+    public:
+      //
+      // Types...
+      //
+      typedef ButtonList<Button> List; ///< The button list class.
+      typedef typename Button::PinClock::Time Time; ///< Type of timestamps of the buttons.
+
+    public:
+      //
+      // Creators...
+      //
+      using List::List; ///< Created as a button list.
+
+    public:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Initialise all the buttons. Called from setup() of an Arduino program.
+       */
+      void begin() {
+        List::begin();
+        head_ = tail_ = held_ = click_ = idle_ = 0;
+        ports_.clear();
+        for(size_t i = 0; i < this->len_; ++i) {
+          insert(this->buttons_[i]);
+          this->buttons_[i]->snapshotPins(ports_);
+        }
+        steady_ = false;
+      }
+
+      /**
+       * Handle all the buttons, reading the pins (unless none changed and all
+       * the buttons are steady) but only checking held, idle and click times
+       * that are due. Called in the loop() of an Arduino program.
+       */
+      void handle() {
+        this->anyStates_ = 0;
+        if(ports_.changed() || !steady_) {
+          steady_ = true;
+          for(size_t i = 0; i < this->len_; ++i) {
+            Button *button = this->buttons_[i];
+            if(button->handleEdges()) {
+              remove(button);
+              insert(button);
+            }
+            steady_ = steady_ && button->steady();
+          }
+        }
+        while(held_ && held_->handleHeldTime()) {
+          held_ = held_->next_;
+        }
+        while(click_ && click_->handleClickTime()) {
+          click_ = click_->next_;
+        }
+        while(idle_ && idle_->handleIdleTime()) {
+          idle_ = idle_->next_;
+        }
+        for(Button *button = head_; button && button->handleAge(); button = button->next_) {}
+      }
+
+    protected:
+      /**
+       * Link a button into the order by the time it last changed. That is
+       * usually now, making it the last, but a debouncer may report a change
+       * timed from the first bounce (e.g. the TimerDebouncer), so it is
+       * linked before any button that changed since. Checks that have moved
+       * past where it is linked move back to it.
+       *
+       * Buttons are ordered by their age (the time since they changed), not
+       * by comparing their timestamps with each other: the difference of two
+       * timestamps only tells which is later within half the wrap period of
+       * the clock (e.g. 32s for the Millis16Clock), but an age is correct up
+       * to the whole wrap period.
+       *
+       * @param button The button to link.
+       */
+      void insert(Button *button) {
+        Time now = Button::PinClock::now();
+        Time age = now - button->millisStart_;
+        Button *prev = tail_;
+        bool held = !held_, click = !click_, idle = !idle_;
+
+        while(prev && (Time)(now - prev->millisStart_) < age) {
+          held = held || prev == held_;
+          click = click || prev == click_;
+          idle = idle || prev == idle_;
+          prev = prev->prev_;
+        }
+        button->prev_ = prev;
+        button->next_ = prev ? prev->next_ : head_;
+        if(button->next_) {
+          button->next_->prev_ = button;
+        } else {
+          tail_ = button;
+        }
+        if(prev) {
+          prev->next_ = button;
+        } else {
+          head_ = button;
+        }
+        if(held) held_ = button;
+        if(click) click_ = button;
+        if(idle) idle_ = button;
+      }
+
+      /**
+       * Unlink a button from the order. Checks waiting at the button move on
+       * to the next one.
+       *
+       * @param button The button to unlink.
+       */
+      void remove(Button *button) {
+        if(held_ == button) held_ = button->next_;
+        if(click_ == button) click_ = button->next_;
+        if(idle_ == button) idle_ = button->next_;
+        if(button->prev_) {
+          button->prev_->next_ = button->next_;
+        } else {
+          head_ = button->next_;
+        }
+        if(button->next_) {
+          button->next_->prev_ = button->prev_;
+        } else {
+          tail_ = button->prev_;
+        }
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      Button *head_ = 0; ///< The button that changed longest ago.
+      Button *tail_ = 0; ///< The button that changed last.
+      Button *held_ = 0; ///< The next button to check for held (or 0).
+      Button *click_ = 0; ///< The next button to check for a single-click (or 0).
+      Button *idle_ = 0; ///< The next button to check for idle (or 0).
+      PortSnapshot ports_; ///< The input ports of the pins when last read.
+      bool steady_ = false; ///< True if all buttons were steady when last read.
+  };
+}
@@ -0,0 +1,388 @@
+/**
+ * @file Tables.h Definitions of the button table classes (ButtonTableEntry,
+ * TablePin, TableResistorCircuit and ButtonTable). A button table configures
+ * a list of buttons from a table held in flash memory (PROGMEM), giving the
+ * pin, resistor circuit, id and debounce time of each button, so only the
+ * state of the buttons that changes is held in RAM.
+ *
+ * A ButtonList needs a pointer to each button, and each button holds its pin
+ * (1 byte each), so 32 buttons use 96 bytes of RAM for configuration that
+ * never changes. A ButtonTable holds its buttons itself, and passes each
+ * button its table entry as it begins and handles it, so its buttons read
+ * their pins from the table instead. For example:
+ *
+ *     const able::ButtonTableEntry table[] PROGMEM = {
+ *       // Pin, circuit, id, debounce time (0 for the default).
+ *       {2, able::ButtonTableEntry::PULLUP, 1, 0},
+ *       {3, able::ButtonTableEntry::PULLUP, 2, 0},
+ *       {4, able::ButtonTableEntry::PULLDOWN, 3, 20},
+ *     };
+ *     AbleTableCallbackButtonList<3> btnList(table, onEvent);
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#include <new>
+#include "ButtonList.h"
+
+namespace able {
+  /**
+   * Entry of a button table, configuring one button. Tables of entries are
+   * declared PROGMEM, so are held in flash memory rather than RAM.
+   */
+  struct ButtonTableEntry {
+    //
+    // Constants...
+    //
+    enum {
+      PULLDOWN = 0, ///< Flag of a button using a pulldown resistor circuit.
+      PULLUP = 1 ///< Flag of a button using a pull-up resistor circuit.
+    };
+
+    //
+    // Data...
+    //
+    uint8_t pin; ///< The Arduino pin connected to the button.
+    uint8_t flags; ///< The resistor circuit of the button (PULLDOWN or PULLUP).
+    ButtonId id; ///< Identifier passed to callback functions.
+    uint8_t debounceTime; ///< Debounce time in clock ticks (0 for that of the button type).
+  };
+
+  /**
+   * Pin class of buttons configured by a ButtonTable, in place of the Pin
+   * class (e.g. `able::DebouncedPin<able::NoCounters, able::TimerDebouncer,
+   * able::MillisClock, able::TablePin>`). Holds only the reading of the pin;
+   * the pin itself is read from the table entry the ButtonTable passes as it
+   * begins or handles each button, so table buttons have no begin() or
+   * handle() of their own and are begun and handled through their table.
+   * Their states may be read directly.
+   */
+  class TablePin {
+    friend class TableResistorCircuit;
+
+    public:
+      //
+      // Types...
+      //
+      typedef const ButtonTableEntry *Source; ///< What the pin is configured by: its PROGMEM table entry.
+
+    protected:
+      //
+      // Creators...
+      //
+
+      /**
+       * Protected constructor used by sub-classes. Use a ButtonTable to create
+       * table buttons.
+       *
+       * @param pin The pin to read from (unused, read from the table).
+       * @param initState The initial (un-pushed) state of the button.
+       */
+      inline TablePin(uint8_t /* pin */, uint8_t initState)
+      :currState_(initState) {}
+
+    private:
+      //
+      // Copy and assignment (not supported)...
+      //
+      TablePin(const TablePin &) = delete; ///< Copying pins is not supported.
+      TablePin &operator=(const TablePin &) = delete; ///< Assigning pins not supported.
+
+    protected:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Return the pin of a table entry.
+       *
+       * @param entry The PROGMEM table entry of the button.
+       *
+       * @return The Arduino pin.
+       */
+      static inline uint8_t pin(Source entry) {
+        return pgm_read_byte(&entry->pin);
+      }
+
+      /**
+       * Determine if a table entry uses a pull-up resistor circuit.
+       *
+       * @param entry The PROGMEM table entry of the button.
+       *
+       * @return True if pull-up, false if pulldown.
+       */
+      static inline bool isPullup(Source entry) {
+        return pgm_read_byte(&entry->flags) & ButtonTableEntry::PULLUP;
+      }
+
+      /**
+       * Return the debounce time of the pin: that of its table entry, or of
+       * the pin's type if the entry's is 0.
+       *
+       * @param entry The PROGMEM table entry of the button.
+       * @param debounceTime The debounce time of the pin's type.
+       *
+       * @return The debounce time to use for the pin.
+       */
+      template <typename DebounceTime>
+      static inline DebounceTime ownDebounceTime(Source entry, DebounceTime debounceTime) {
+        uint8_t entryTime = pgm_read_byte(&entry->debounceTime);
+        return entryTime ? (DebounceTime) entryTime : debounceTime;
+      }
+
+      /**
+       * Return the number of clicks.
+       *
+       * @param pressed The pressed state of a button.
+       * @param released The released state of a button.
+       *
+       * @returns Always no clicks (0) as clicks not supported by default.
+       */
+      inline int clicks(uint8_t /* pressed */, uint8_t /* released */) {
+        return 0;
+      }
+
+      /**
+       * Return the states of the pin.
+       *
+       * @param pressed The pressed state of a button.
+       * @param released The released state of a button.
+       *
+       * @return The ButtonStates bits: only PRESSED, as held, idle and click
+       *         states are not supported by default.
+       */
+      inline uint8_t states(uint8_t pressed, uint8_t /* released */) const {
+        return currState_ == pressed ? ButtonStates::PRESSED : 0;
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      uint8_t currState_; ///< The reading of the pin.
+  };
+
+  /**
+   * Declaration of the resistor circuit of table buttons, which is pull-up or
+   * pulldown as set by the flags of each button's table entry. As with the
+   * MixedResistorCircuit, readings are XORed with the polarity of the circuit,
+   * so buttons on either circuit read HIGH when pressed.
+   */
+  class TableResistorCircuit: private Circuit {
+    public:
+      //
+      // Constants...
+      //
+      enum {
+        BUTTON_PRESSED = HIGH, ///< Reading of any pressed button, after the XOR.
+        BUTTON_RELEASED = LOW ///< Reading of any released button, after the XOR.
+      };
+
+    public:
+      //
+      // Static Members...
+      //
+
+      /**
+       * Return the pin mode of a table entry.
+       *
+       * @param entry The PROGMEM table entry of the button.
+       *
+       * @return INPUT_PULLUP for a pull-up resistor circuit, else INPUT.
+       */
+      static inline uint8_t inputMode(TablePin::Source entry) {
+        return TablePin::isPullup(entry) ? INPUT_PULLUP : INPUT;
+      }
+
+      /**
+       * Return the polarity XORed with readings of a table entry.
+       *
+       * @param entry The PROGMEM table entry of the button.
+       *
+       * @return HIGH for a pull-up resistor circuit (inverting its readings),
+       *         else LOW.
+       */
+      static inline uint8_t polarity(TablePin::Source entry) {
+        return TablePin::isPullup(entry) ? HIGH : LOW;
+      }
+
+    private:
+      //
+      // Creators, copying and assignment (not supported)...
+      //
+      TableResistorCircuit() = delete; ///< Creating resistor circuits is not supported.
+      TableResistorCircuit(const TableResistorCircuit &) = delete; ///< Copying resistor circuits is not supported.
+      TableResistorCircuit &operator=(const TableResistorCircuit &) = delete; ///< Assigning resistor circuits is not supported.
+  };
+
+  /**
+   * Buttons held by a ButtonTable, in place of the array of button pointers
+   * of a ButtonList. Indexing gives a pointer to each button, as for an array
+   * of pointers.
+   *
+   * @param Button The table button class.
+   * @param N The number of buttons.
+   */
+  template <typename Button, size_t N>
+  class TableButtons {
+    public:
+      /**
+       * Return a pointer to a button.
+       *
+       * @param i The position of the button (0 to N-1).
+       *
+       * @return The button.
+       */
+      inline Button *operator[](size_t i) const {
+        return reinterpret_cast<Button *>(const_cast<uint8_t *>(storage_)) + i;
+      }
+
+    private:
+      //
+      // Data...
+      //
+      alignas(Button) uint8_t storage_[N * sizeof(Button)]; ///< The buttons.
+  };
+
+  /**
+   * Button table template, holding a list of N table buttons configured by a
+   * PROGMEM table of N entries (see above). The buttons are held in the table
+   * object, so no array of button pointers is needed, and each button holds
+   * only its changing state (plus, for callback buttons, its callback
+   * function and id). Apart from begin(), handle() and button(), which pass
+   * or read the table entries, it is a ButtonList.
+   *
+   * @param Button The table button class (e.g. AbleTableCallbackButton).
+   * @param N The number of buttons (and table entries).
+   */
+  template <typename Button, size_t N>
+  class ButtonTable: public ButtonList<Button, TableButtons<Button, N>> {
+    public:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create the buttons of a table.
+       *
+       * @param table The PROGMEM table of N entries configuring the buttons.
+       */
+      ButtonTable(const ButtonTableEntry (&table)[N])
+      :ButtonList<Button, TableButtons<Button, N>>(N), table_(table) {
+        for(size_t i = 0; i < N; ++i) {
+          new(this->buttons_[i]) Button(pgm_read_byte(&table[i].pin));
+        }
+      }
+
+      /**
+       * Create the callback buttons of a table, each calling the same callback
+       * function with the id of its table entry.
+       *
+       * @param table The PROGMEM table of N entries configuring the buttons.
+       * @param callbackFn The function to call for a button event.
+       */
+      template <typename CallbackButton = Button>
+      ButtonTable(const ButtonTableEntry (&table)[N], typename CallbackButton::CallbackFn callbackFn)
+      :ButtonList<Button, TableButtons<Button, N>>(N), table_(table) {
+        for(size_t i = 0; i < N; ++i) {
+          new(this->buttons_[i]) Button(pgm_read_byte(&table[i].pin), callbackFn, entryId(i));
+        }
+      }
+
+    private:
+      //
+      // Copying and assignment (not supported)...
+      //
+      ButtonTable(const ButtonTable &cpy) = delete; ///< Copying tables is not supported.
+      ButtonTable &operator=(const ButtonTable &) = delete; ///< Assigning tables is not supported.
+
+    public:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Initialise all the buttons, each with its table entry. Called from
+       * setup() of an Arduino program.
+       */
+      void begin() {
+        this->anyStates_ = 0;
+        for(size_t i = 0; i < N; ++i) {
+          this->buttons_[i]->begin(table_ + i);
+        }
+      }
+
+      /**
+       * Handle all the buttons, each with its table entry. Called in the
+       * loop() of an Arduino program to monitor all button states and
+       * dispatch any callback events if required.
+       */
+      void handle() {
+        this->anyStates_ = 0;
+        for(size_t i = 0; i < N; ++i) {
+          this->buttons_[i]->handle(table_ + i);
+        }
+      }
+
+    public:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Return the number of buttons in the table.
+       *
+       * @return The number of buttons.
+       */
+      static inline size_t size() {
+        return N;
+      }
+
+      /**
+       * Return a button by its position in the table.
+       *
+       * @param i The position of the button (0 to N-1).
+       *
+       * @return The button.
+       */
+      inline Button &operator[](size_t i) {
+        return *this->buttons_[i];
+      }
+
+      /**
+       * Return a pointer to the button whose table entry has the id (or a null
+       * pointer if the id is not found). Ids are read from the table, so this
+       * works for buttons of any type.
+       *
+       * @param id The identifier of the button to find in the table.
+       *
+       * @return The id-matching button, or a null pointer.
+       */
+      Button *button(ButtonId id) const {
+        for(size_t i = 0; i < N; ++i) {
+          if(entryId(i) == id) {
+            return this->buttons_[i];
+          }
+        }
+        return 0;
+      }
+
+    protected:
+      /**
+       * Return the id of a table entry.
+       *
+       * @param i The position of the entry.
+       *
+       * @return The id of the entry.
+       */
+      inline ButtonId entryId(size_t i) const {
+        return sizeof(ButtonId) > 1 ? (ButtonId) pgm_read_word(&table_[i].id) : (ButtonId) pgm_read_byte(&table_[i].id);
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      const ButtonTableEntry *table_; ///< The PROGMEM table configuring the buttons.
+  };
+}
@@ -0,0 +1,10 @@
+/**
+ * @file Telemetry.cpp Implementation of the Telemetry class.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include "Telemetry.h"
+
+Print *able::Telemetry::out_ = 0;
+uint16_t able::Telemetry::unpublished_ = 0;
+uint16_t able::Telemetry::dropped_ = 0;
@@ -0,0 +1,269 @@
+/**
+ * @file Telemetry.h Definition of the telemetry classes (Telemetry,
+ * TelemetryCallback and TelemetryReader). Telemetry streams each button event
+ * as a small binary frame (e.g. to Serial), so buttons in the field can be
+ * watched without formatting text in callback functions.
+ *
+ * Each frame is 8 bytes (9 with 16-bit button ids, see Ids.h):
+ *
+ * | Bytes | Content                                                       |
+ * | :---: | :------------------------------------------------------------ |
+ * | 1     | Sync byte `0xA5`                                              |
+ * | 1     | Event code, or `0x7F` for a dropped-events frame              |
+ * | 1 (2) | Button id (0 for a dropped-events frame)                      |
+ * | 4     | Clock time of the event, or the number of events dropped      |
+ * | 1     | Check byte: the sum of the bytes between, inverted            |
+ *
+ * Ids, times and counts are little-endian. Frames are only written if the stream
+ * has room for them without blocking (using availableForWrite()). Otherwise
+ * the event is dropped and counted, and a dropped-events frame is written
+ * before the next event that fits. A reader can start anywhere in the stream,
+ * skipping bytes until a frame with a valid check byte is found.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#include <Arduino.h>
+#include "Callbacks.h"
+
+namespace able {
+  /**
+   * Telemetry stream shared by all buttons using TelemetryCallback. Call
+   * Telemetry::begin() to start writing frames to a stream (e.g. Serial) and
+   * Telemetry::end() to stop. Nothing is written until begin() is called.
+   */
+  class Telemetry {
+    public:
+      //
+      // Constants...
+      //
+      enum {
+        SYNC = 0xA5, ///< First byte of each frame.
+        DROPPED = 0x7F, ///< Event code of a dropped-events frame.
+        ID_SIZE = sizeof(ButtonId), ///< Bytes of the button id.
+        FRAME_SIZE = 7 + ID_SIZE ///< Bytes in each frame.
+      };
+
+    public:
+      //
+      // Static Members...
+      //
+
+      /**
+       * Start writing frames to a stream. The stream must report the room in
+       * its transmit buffer with availableForWrite() (as HardwareSerial does),
+       * and should be used only for telemetry, so the frames can be decoded.
+       *
+       * @param out The stream to write to (default Serial).
+       */
+      inline static void begin(Print &out = Serial) {
+        out_ = &out;
+      }
+
+      /**
+       * Stop writing frames.
+       */
+      inline static void end() {
+        out_ = 0;
+      }
+
+      /**
+       * Write a frame for an event if there is room in the stream, else drop
+       * and count it. Never waits for the stream.
+       *
+       * @param event The event code.
+       * @param id The identifier of the button.
+       * @param time The clock time of the event.
+       *
+       * @return True if the frame was written, false if dropped (or
+       *         telemetry has not begun).
+       */
+      static bool send(uint8_t event, ButtonId id, unsigned long time) {
+        if(!out_) return false;
+        if(out_->availableForWrite() < (unpublished_ ? 2 * FRAME_SIZE : FRAME_SIZE)) {
+          if(unpublished_ < 0xFFFF) ++unpublished_;
+          if(dropped_ < 0xFFFF) ++dropped_;
+          return false;
+        }
+        if(unpublished_) {
+          write(DROPPED, 0, unpublished_);
+          unpublished_ = 0;
+        }
+        write(event, id, time);
+        return true;
+      }
+
+      /**
+       * Return the number of events dropped because the stream was full.
+       *
+       * @return The number of dropped events (up to 65535).
+       */
+      static inline uint16_t dropped() {
+        return dropped_;
+      }
+
+      /**
+       * Reset the count of dropped events to zero.
+       */
+      static inline void resetDropped() {
+        dropped_ = 0;
+      }
+
+    protected:
+      /**
+       * Write a frame to the stream.
+       *
+       * @param event The event code (or DROPPED).
+       * @param id The identifier of the button.
+       * @param value The time (or count) of the frame.
+       */
+      static void write(uint8_t event, ButtonId id, unsigned long value) {
+        uint8_t frame[FRAME_SIZE];
+        uint8_t sum = 0;
+
+        frame[0] = SYNC;
+        frame[1] = event;
+        for(uint8_t i = 2; i < 2 + ID_SIZE; ++i, id >>= 8) {
+          frame[i] = (uint8_t)(id & 0xFF);
+        }
+        for(uint8_t i = 2 + ID_SIZE; i < FRAME_SIZE - 1; ++i, value >>= 8) {
+          frame[i] = (uint8_t)(value & 0xFF);
+        }
+        for(uint8_t i = 1; i < FRAME_SIZE - 1; ++i) {
+          sum += frame[i];
+        }
+        frame[FRAME_SIZE - 1] = (uint8_t) ~sum;
+        out_->write(frame, FRAME_SIZE);
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      static Print *out_; ///< The stream being written to (or 0).
+      static uint16_t unpublished_; ///< Events dropped since the last frame.
+      static uint16_t dropped_; ///< Events dropped because the stream was full.
+  };
+
+  /**
+   * Callback class sending each event to the Telemetry stream, then calling
+   * the callback function with another callback class. Use as the callback
+   * class of a callback button, for example
+   * `able::CallbackButton<..., able::TelemetryCallback<>>`. Uses no memory
+   * per button beyond that of the other callback class.
+   *
+   * @param Callback The callback class calling the callback function
+   *                 (UntimedCallback, TimedCallback or DeferredCallback).
+   *                 Defaults to UntimedCallback.
+   */
+  template <typename Callback = UntimedCallback>
+  class TelemetryCallback: public Callback {
+    protected:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Send the event to the telemetry stream, then call the callback
+       * function (if there is one).
+       *
+       * @param callbackFn The callback function to call (may be 0).
+       * @param event The event that occurred.
+       * @param id The identifier of the button.
+       * @param edgeMillis The timestamp of the last debounced edge.
+       */
+      template <typename Clock>
+      inline void call(typename Callback::CallbackFn callbackFn, CallbackEvents::CALLBACK_EVENT event, ButtonId id, typename Clock::Time edgeMillis) {
+        Telemetry::send(event, id, Clock::now());
+        Callback::template call<Clock>(callbackFn, event, id, edgeMillis);
+      }
+  };
+
+  /**
+   * Reader decoding a telemetry stream held in memory (e.g. captured to a file
+   * on a host). Use next() to read each frame in turn.
+   */
+  class TelemetryReader {
+    public:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create a reader of a telemetry stream.
+       *
+       * @param data The stream.
+       * @param size The size of the stream in bytes.
+       */
+      TelemetryReader(const uint8_t *data, size_t size)
+      :data_(data), size_(size), pos_(0), skipped_(0) {}
+
+    public:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Return the number of bytes skipped to find frames (e.g. corrupt or
+       * partial frames, or other output on the stream).
+       *
+       * @return The number of bytes skipped.
+       */
+      inline size_t skipped() const {
+        return skipped_;
+      }
+
+    public:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Read the next frame of the stream.
+       *
+       * @param event Set to the event code (or Telemetry::DROPPED).
+       * @param id Set to the identifier of the button.
+       * @param value Set to the clock time of the event (or the number of
+       *              events dropped).
+       *
+       * @return True if a frame was read, false at the end of the stream.
+       */
+      bool next(uint8_t &event, ButtonId &id, unsigned long &value) {
+        for(; pos_ + Telemetry::FRAME_SIZE <= size_; ++pos_, ++skipped_) {
+          const uint8_t *frame = data_ + pos_;
+          uint8_t sum = 0;
+
+          if(frame[0] != Telemetry::SYNC) continue;
+          for(uint8_t i = 1; i < Telemetry::FRAME_SIZE - 1; ++i) {
+            sum += frame[i];
+          }
+          if(frame[Telemetry::FRAME_SIZE - 1] != (uint8_t) ~sum) continue;
+          if(frame[1] > CallbackEvents::DOUBLE_CLICKED_EVENT && frame[1] != Telemetry::DROPPED) continue;
+
+          event = frame[1];
+          id = 0;
+          for(uint8_t i = 0; i < Telemetry::ID_SIZE; ++i) {
+            id |= (ButtonId)(frame[2 + i] << (8 * i));
+          }
+          value = 0;
+          for(uint8_t i = 0; i < 4; ++i) {
+            value |= (unsigned long) frame[2 + Telemetry::ID_SIZE + i] << (8 * i);
+          }
+          pos_ += Telemetry::FRAME_SIZE;
+          return true;
+        }
+        skipped_ += size_ - pos_; // Partial frame at the end.
+        pos_ = size_;
+        return false;
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      const uint8_t *data_; ///< The stream.
+      size_t size_; ///< The size of the stream.
+      size_t pos_; ///< Position of the next frame.
+      size_t skipped_; ///< Bytes skipped between frames.
+  };
+}
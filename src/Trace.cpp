@@ -0,0 +1,9 @@
+/**
+ * @file Trace.cpp Implementation of the Trace class.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#include "Trace.h"
+
+Print *able::Trace::out_ = 0;
+unsigned long able::Trace::lastMicros_ = 0;
@@ -0,0 +1,255 @@
+/**
+ * @file Trace.h Definition of the pin trace classes (Trace, TraceRecorder and
+ * TraceReader). A trace records each raw change of button pins, with its
+ * timestamp, so field problems can be replayed on a host exactly as they
+ * happened.
+ *
+ * A trace is a compact binary stream. It starts with a header:
+ *
+ * | Bytes | Content                                     |
+ * | :---: | :------------------------------------------ |
+ * | 4     | Magic `ABLT`                                |
+ * | 1     | Format version (1)                          |
+ * | 4     | Start time in microseconds (little-endian)  |
+ *
+ * followed by one record per raw pin change:
+ *
+ * | Bytes | Content                                                       |
+ * | :---: | :------------------------------------------------------------ |
+ * | 1     | Pin (bits 0-6) and level (bit 7) after the change             |
+ * | 1-5   | Microseconds since the previous record (or start) as a varint |
+ *
+ * The varint holds 7 bits per byte, least significant first, with bit 7 set
+ * on all but the last byte. Most records take 3-4 bytes. Only changes are
+ * recorded (not every reading), so a trace of a button that is not being
+ * pressed stays empty.
+ *
+ * @copyright Copyright (c) 2022 John Scott.
+ */
+#pragma once
+#include <Arduino.h>
+#include "Counters.h"
+
+namespace able {
+  /**
+   * Trace stream shared by all recording pins. Call Trace::begin() to start
+   * writing a trace to a stream (e.g. Serial) and Trace::end() to stop.
+   * Nothing is written until begin() is called.
+   */
+  class Trace {
+    public:
+      //
+      // Constants...
+      //
+      enum {
+        VERSION = 1, ///< The trace format version.
+        LEVEL = 0x80, ///< Record bit holding the level of the pin.
+        PIN = 0x7F ///< Record bits holding the pin number.
+      };
+
+    public:
+      //
+      // Static Members...
+      //
+
+      /**
+       * Start writing a trace, beginning with the trace header. The stream
+       * should be used only for the trace, so the trace can be decoded.
+       *
+       * @param out The stream to write to (default Serial).
+       */
+      static void begin(Print &out = Serial) {
+        unsigned long now = micros();
+
+        out_ = &out;
+        lastMicros_ = now;
+        out.write('A');
+        out.write('B');
+        out.write('L');
+        out.write('T');
+        out.write((uint8_t) VERSION);
+        for(uint8_t i = 0; i < 4; ++i, now >>= 8) {
+          out.write((uint8_t)(now & 0xFF));
+        }
+      }
+
+      /**
+       * Stop writing the trace.
+       */
+      inline static void end() {
+        out_ = 0;
+      }
+
+      /**
+       * Write a record of a raw pin change, if a trace has begun.
+       *
+       * @param pin The pin that changed (0-127).
+       * @param level The new level of the pin.
+       */
+      static void record(uint8_t pin, uint8_t level) {
+        if(!out_) return;
+
+        unsigned long now = micros();
+        unsigned long delta = now - lastMicros_;
+
+        lastMicros_ = now;
+        out_->write((uint8_t)((pin & PIN) | (level ? LEVEL : 0)));
+        while(delta >= 0x80) {
+          out_->write((uint8_t)((delta & 0x7F) | 0x80));
+          delta >>= 7;
+        }
+        out_->write((uint8_t) delta);
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      static Print *out_; ///< The stream being written to (or 0).
+      static unsigned long lastMicros_; ///< Timestamp of the last record.
+  };
+
+  /**
+   * Counter class recording raw pin changes to the Trace, as well as counting
+   * them with another counter class. Use as the counter class of a pin to
+   * record it, for example `able::ClickerPin<able::TraceRecorder<>>`. Uses no
+   * memory per button.
+   *
+   * @param Counters The counter class also counting what happens to the pin.
+   *                 Defaults to NoCounters.
+   */
+  template <typename Counters = NoCounters>
+  class TraceRecorder: public Counters {
+    protected:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create the recorder.
+       *
+       * @param initState The initial (un-pushed) state of the button.
+       */
+      inline TraceRecorder(uint8_t initState)
+      :Counters(initState) {}
+
+    protected:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Record a raw pin change to the trace, then count it.
+       *
+       * @param pin The pin that changed.
+       * @param reading The new raw reading of the pin.
+       */
+      template <typename Clock>
+      inline void countChange(uint8_t pin, uint8_t reading) {
+        Trace::record(pin, reading);
+        Counters::template countChange<Clock>(pin, reading);
+      }
+  };
+
+  /**
+   * Reader decoding a trace held in memory (e.g. loaded from a file on a
+   * host). Use next() to read each record in turn.
+   */
+  class TraceReader {
+    public:
+      //
+      // Creators...
+      //
+
+      /**
+       * Create a reader of a trace.
+       *
+       * @param data The trace, starting with the header.
+       * @param size The size of the trace in bytes.
+       */
+      TraceReader(const uint8_t *data, size_t size)
+      :data_(data), size_(size), pos_(0), micros_(0) {
+        if(size_ >= 9 && data_[0] == 'A' && data_[1] == 'B' && data_[2] == 'L' && data_[3] == 'T' && data_[4] == Trace::VERSION) {
+          for(uint8_t i = 0; i < 4; ++i) {
+            micros_ |= (unsigned long) data_[5 + i] << (8 * i);
+          }
+          pos_ = 9;
+        } else {
+          size_ = 0; // Not a trace.
+        }
+      }
+
+    public:
+      //
+      // Accessors...
+      //
+
+      /**
+       * Return whether the data starts with a valid trace header.
+       *
+       * @return True if a trace, false if not.
+       */
+      inline bool isValid() const {
+        return size_ != 0;
+      }
+
+      /**
+       * Return the timestamp of the last record read (or the start time).
+       *
+       * @return The timestamp in microseconds.
+       */
+      inline unsigned long micros() const {
+        return micros_;
+      }
+
+    public:
+      //
+      // Modifiers...
+      //
+
+      /**
+       * Read the next record of the trace.
+       *
+       * @param pin Set to the pin that changed.
+       * @param level Set to the new level of the pin.
+       * @param changeMicros Set to the timestamp of the change in
+       *                     microseconds.
+       *
+       * @return True if a record was read, false at the end of the trace (or
+       *         if the last record is incomplete, or the record is corrupt,
+       *         its varint being longer than 5 bytes).
+       */
+      bool next(uint8_t &pin, uint8_t &level, unsigned long &changeMicros) {
+        unsigned long delta = 0;
+        uint8_t shift = 0;
+        size_t pos = pos_;
+
+        if(pos >= size_) return false;
+        uint8_t rec = data_[pos++];
+        for(;;) {
+          if(pos >= size_) return false;
+          uint8_t b = data_[pos++];
+          delta |= (unsigned long)(b & 0x7F) << shift;
+          if(!(b & 0x80)) break;
+          shift += 7;
+          if(shift > 28) return false; // Longer than 5 bytes, so corrupt.
+        }
+
+        pos_ = pos;
+        micros_ += delta;
+        pin = rec & Trace::PIN;
+        level = (rec & Trace::LEVEL) ? HIGH : LOW;
+        changeMicros = micros_;
+        return true;
+      }
+
+    protected:
+      //
+      // Data...
+      //
+      const uint8_t *data_; ///< The trace.
+      size_t size_; ///< The size of the trace (0 if invalid).
+      size_t pos_; ///< Position of the next record.
+      unsigned long micros_; ///< Timestamp of the last record read.
+  };
+}